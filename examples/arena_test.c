@@ -0,0 +1,129 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "../src/error.h"
+#include "../src/arena.h"
+#include "../src/sim.h"
+
+int main() {
+    printf("=== Frame Arena Test ===\n\n");
+
+    error_init();
+
+    int passed_tests = 0;
+    int failed_tests = 0;
+
+    /* Test 1: Aligned bump allocation */
+    printf("Test 1: Aligned Bump Allocation\n");
+    FrameArena *arena = NULL;
+    Error err = arena_create_with_error(4096, &arena);
+    if (err.code == SUCCESS && arena) {
+        char *a = arena_alloc(arena, 10);
+        char *b = arena_alloc(arena, 100);
+        ArenaStats stats = arena_get_stats(arena);
+
+        if (a && b && ((uintptr_t)a % ARENA_ALIGNMENT) == 0 && ((uintptr_t)b % ARENA_ALIGNMENT) == 0 &&
+            b == a + ARENA_ALIGNMENT && stats.used == 3 * ARENA_ALIGNMENT &&
+            stats.overflow_allocations == 0) {
+            printf("  ✓ Bump allocation: PASSED\n");
+            passed_tests++;
+        } else {
+            printf("  ✗ Bump allocation: FAILED\n");
+            failed_tests++;
+        }
+    } else {
+        printf("  ✗ Arena creation: FAILED\n");
+        error_print(&err);
+        failed_tests++;
+    }
+
+    /* Test 2: Overflow is served, then the main block grows on reset */
+    printf("Test 2: Overflow and Growth\n");
+    if (arena) {
+        char *big = arena_alloc(arena, 16384);
+        if (big) memset(big, 0xAB, 16384);
+        ArenaStats before = arena_get_stats(arena);
+
+        arena_reset(arena);
+        ArenaStats grown = arena_get_stats(arena);
+
+        char *again = arena_alloc(arena, 16384);
+        arena_alloc(arena, 100);
+        ArenaStats after = arena_get_stats(arena);
+
+        if (big && before.overflow_allocations == 1 && grown.grows == 1 &&
+            grown.capacity >= before.high_water && grown.used == 0 &&
+            again && after.overflow_allocations == 1) {
+            printf("  ✓ Overflow then growth (capacity %zu): PASSED\n", grown.capacity);
+            passed_tests++;
+        } else {
+            printf("  ✗ Overflow then growth: FAILED\n");
+            failed_tests++;
+        }
+    } else {
+        printf("  ✗ Overflow and growth: SKIPPED (no arena)\n");
+        failed_tests++;
+    }
+    arena_destroy(arena);
+
+    /* Test 3: Error handling */
+    printf("Test 3: Error Handling\n");
+    {
+        void *ptr = NULL;
+        err = arena_alloc_with_error(NULL, 16, &ptr);
+        if (err.code == ERROR_NULL_POINTER && ptr == NULL && arena_alloc(NULL, 16) == NULL) {
+            printf("  ✓ NULL arena rejected: PASSED\n");
+            passed_tests++;
+        } else {
+            printf("  ✗ NULL arena rejected: FAILED\n");
+            failed_tests++;
+        }
+    }
+
+    /* Test 4: Simulation frames settle into the main block */
+    printf("Test 4: Steady-State Simulation Frames\n");
+    {
+        Simulation *sim = sim_create(6000, 120, 60);
+        if (sim) {
+            /* Dense clump with the grid and collisions enabled */
+            for (int i = 0; i < 6000; i++) {
+                sim_add_particle(sim, 40.0f + (float)(i % 60) * 0.1f, 20.0f + (float)(i / 60) * 0.1f,
+                                 (float)(i % 7) - 3.0f, (float)(i % 5) - 2.0f);
+            }
+            sim_enable_spatial_grid(sim, true);
+            sim_enable_collisions(sim, true);
+
+            for (int step = 0; step < 5; step++) {
+                sim_step(sim, 0.016f);
+            }
+            ArenaStats warm = sim_get_arena_stats(sim);
+            for (int step = 0; step < 20; step++) {
+                sim_step(sim, 0.016f);
+            }
+            ArenaStats steady = sim_get_arena_stats(sim);
+
+            if (steady.resets == warm.resets + 20 && steady.high_water > 0 &&
+                steady.overflow_allocations == warm.overflow_allocations &&
+                steady.grows == warm.grows) {
+                printf("  ✓ No overflow after warm-up (high-water %zu bytes): PASSED\n", steady.high_water);
+                passed_tests++;
+            } else {
+                printf("  ✗ Steady state: FAILED (overflows %lu -> %lu, grows %lu -> %lu)\n",
+                       (unsigned long)warm.overflow_allocations, (unsigned long)steady.overflow_allocations,
+                       (unsigned long)warm.grows, (unsigned long)steady.grows);
+                failed_tests++;
+            }
+            sim_destroy(sim);
+        } else {
+            printf("  ✗ Simulation creation: FAILED\n");
+            failed_tests++;
+        }
+    }
+
+    printf("\n=== Test Results ===\n");
+    printf("Passed: %d\n", passed_tests);
+    printf("Failed: %d\n", failed_tests);
+
+    return failed_tests == 0 ? 0 : 1;
+}
@@ -175,27 +175,24 @@ int main(int argc, char *argv[]) {
         renderer_clear(renderer);
 
         /* Render particles */
-        int particle_count = sim_get_particle_count(sim);
-        for (int i = 0; i < particle_count && i < csv->num_rows; i++) {
-            const Particle *p = sim_get_particle(sim, i);
-            if (p) {
-                int px = (int)roundf(p->x);
-                int py = (int)roundf(p->y);
-
-                if (px >= 0 && px < width && py >= 0 && py < height) {
-                    /* Get color from value column */
-                    uint32_t color = 0x00AAFF; /* Default blue */
-                    if (value_col >= 0) {
-                        float value = csv->data[i][value_col];
-                        color = value_to_color(value, min_value, max_value);
-                    }
-
-                    /* Choose glyph based on speed */
-                    float speed = sqrtf(p->vx * p->vx + p->vy * p->vy);
-                    char glyph = speed < 1.0f ? '.' : (speed < 2.0f ? 'o' : 'O');
-
-                    renderer_plot(renderer, px, py, glyph, color);
+        ParticleSoA view = sim_get_particle_view(sim);
+        for (int i = 0; i < view.count && i < csv->num_rows; i++) {
+            int px = (int)roundf(view.x[i]);
+            int py = (int)roundf(view.y[i]);
+
+            if (px >= 0 && px < width && py >= 0 && py < height) {
+                /* Get color from value column */
+                uint32_t color = 0x00AAFF; /* Default blue */
+                if (value_col >= 0) {
+                    float value = csv->data[i][value_col];
+                    color = value_to_color(value, min_value, max_value);
                 }
+
+                /* Choose glyph based on speed */
+                float speed = sqrtf(view.vx[i] * view.vx[i] + view.vy[i] * view.vy[i]);
+                char glyph = speed < 1.0f ? '.' : (speed < 2.0f ? 'o' : 'O');
+
+                renderer_plot(renderer, px, py, glyph, color);
             }
         }
 
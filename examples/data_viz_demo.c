@@ -234,23 +234,20 @@ int main(int argc, char *argv[]) {
         renderer_clear(renderer);
 
         /* Render particles */
-        int particle_count = sim_get_particle_count(sim);
-        for (int i = 0; i < particle_count && i < num_records; i++) {
-            const Particle *p = sim_get_particle(sim, i);
-            if (p) {
-                int px = (int)roundf(p->x);
-                int py = (int)roundf(p->y);
-
-                if (px >= 0 && px < width && py >= 0 && py < height) {
-                    uint32_t color = (value_col >= 0) ?
-                        value_to_color(viz_records[i].value, min_value, max_value) :
-                        0x00AAFF;
-
-                    float speed = sqrtf(p->vx * p->vx + p->vy * p->vy);
-                    char glyph = speed < 1.0f ? '.' : (speed < 2.0f ? 'o' : 'O');
-
-                    renderer_plot(renderer, px, py, glyph, color);
-                }
+        ParticleSoA view = sim_get_particle_view(sim);
+        for (int i = 0; i < view.count && i < num_records; i++) {
+            int px = (int)roundf(view.x[i]);
+            int py = (int)roundf(view.y[i]);
+
+            if (px >= 0 && px < width && py >= 0 && py < height) {
+                uint32_t color = (value_col >= 0) ?
+                    value_to_color(viz_records[i].value, min_value, max_value) :
+                    0x00AAFF;
+
+                float speed = sqrtf(view.vx[i] * view.vx[i] + view.vy[i] * view.vy[i]);
+                char glyph = speed < 1.0f ? '.' : (speed < 2.0f ? 'o' : 'O');
+
+                renderer_plot(renderer, px, py, glyph, color);
             }
         }
 
@@ -0,0 +1,234 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../src/error.h"
+#include "../src/field_lattice.h"
+#include "../src/dispatch.h"
+#include "../src/sim.h"
+
+#define WORLD_W 60
+#define WORLD_H 30
+#define TEST_PARTICLES 1003  /* Not a multiple of any vector width */
+
+/* Exact acceleration of a set of fields at one point (scalar pass, dt = 1) */
+static void exact_accel(ForceField *fields, int num_fields, float x, float y, float *ax, float *ay) {
+    float vx = 0.0f, vy = 0.0f;
+    ParticleSoA point = { &x, &y, &vx, &vy, 1 };
+    physics_apply_force_fields(&point, fields, num_fields, 1.0f);
+    *ax = vx;
+    *ay = vy;
+}
+
+int main() {
+    printf("=== Field Lattice Test ===\n\n");
+
+    error_init();
+
+    int passed_tests = 0;
+    int failed_tests = 0;
+
+    static float x[TEST_PARTICLES], y[TEST_PARTICLES];
+    static float vx[2][TEST_PARTICLES], vy[2][TEST_PARTICLES];
+
+    /* Test 1: Baking rasterizes the summed fields onto the nodes */
+    printf("Test 1: Bake\n");
+    {
+        ForceField fields[3] = {
+            physics_create_radial_field(20.0f, 12.0f, 40.0f, 12.0f),
+            physics_create_vortex_field(45.0f, 18.0f, 25.0f, 0.0f),
+            physics_create_directional_field(1.0f, 0.5f, 8.0f)
+        };
+        FieldLattice *lattice = NULL;
+        Error err = field_lattice_create_with_error(WORLD_W, WORLD_H, 1.0f, &lattice);
+        int ok = err.code == SUCCESS && lattice && lattice->cols == WORLD_W && lattice->rows == WORLD_H &&
+                 field_lattice_bake(lattice, fields, 3).code == SUCCESS && lattice->bakes == 1;
+
+        /* Node values agree with direct evaluation; sampling on a node
+         * returns the node exactly */
+        for (int n = 0; ok && n < lattice->num_nodes; n++) {
+            float ax, ay;
+            exact_accel(fields, 3, lattice->node_x[n], lattice->node_y[n], &ax, &ay);
+            float slack = 1e-4f * (1.0f + fabsf(ax) + fabsf(ay));
+            if (fabsf(lattice->ax[n] - ax) > slack || fabsf(lattice->ay[n] - ay) > slack) ok = 0;
+
+            float px = lattice->node_x[n], py = lattice->node_y[n], pvx = 0.0f, pvy = 0.0f;
+            ParticleSoA probe = { &px, &py, &pvx, &pvy, 1 };
+            field_lattice_sample_scalar(lattice, &probe, 1.0f);
+            if (pvx != lattice->ax[n] || pvy != lattice->ay[n]) ok = 0;
+        }
+        if (ok) {
+            printf("  ✓ %d nodes match the fields: PASSED\n", lattice->num_nodes);
+            passed_tests++;
+        } else {
+            printf("  ✗ Bake: FAILED\n");
+            failed_tests++;
+        }
+        field_lattice_destroy(lattice);
+    }
+
+    /* Test 2: Bilinear samples of smooth fields between nodes */
+    printf("Test 2: Bilinear Accuracy\n");
+    {
+        ForceField fields[2] = {
+            physics_create_radial_field(-30.0f, -20.0f, 60.0f, 0.0f),
+            physics_create_directional_field(0.0f, 1.0f, 5.0f)
+        };
+        FieldLattice *lattice = field_lattice_create(WORLD_W, WORLD_H, 2.0f);
+        int ok = lattice && field_lattice_bake(lattice, fields, 2).code == SUCCESS;
+        float worst = 0.0f;
+
+        for (int i = 0; ok && i < TEST_PARTICLES; i++) {
+            float px = (float)((i * 37) % 599) / 10.0f;
+            float py = (float)((i * 53) % 299) / 10.0f;
+            float pvx = 0.0f, pvy = 0.0f, ax, ay;
+            ParticleSoA probe = { &px, &py, &pvx, &pvy, 1 };
+            field_lattice_sample_scalar(lattice, &probe, 1.0f);
+            exact_accel(fields, 2, px, py, &ax, &ay);
+            float error = hypotf(pvx - ax, pvy - ay) / hypotf(ax, ay);
+            if (error > worst) worst = error;
+        }
+        if (ok && worst < 0.01f) {
+            printf("  ✓ Worst relative error %.2e: PASSED\n", (double)worst);
+            passed_tests++;
+        } else {
+            printf("  ✗ Bilinear accuracy: FAILED (worst %.2e)\n", (double)worst);
+            failed_tests++;
+        }
+        field_lattice_destroy(lattice);
+    }
+
+    /* Test 3: Every supported sampling tier matches scalar exactly */
+    printf("Test 3: Sampling Kernels\n");
+    {
+        ForceField fields[2] = {
+            physics_create_vortex_field(30.0f, 15.0f, 25.0f, 20.0f),
+            physics_create_attractor_field(10.0f, 25.0f, 200.0f, 0.0f)
+        };
+        FieldLattice *lattice = field_lattice_create(WORLD_W, WORLD_H, 1.5f);
+        int ok = lattice && field_lattice_bake(lattice, fields, 2).code == SUCCESS;
+
+        /* Includes positions outside the world and one NaN */
+        for (int i = 0; i < TEST_PARTICLES; i++) {
+            x[i] = (float)((i * 37) % 800) / 10.0f - 10.0f;
+            y[i] = (float)((i * 53) % 500) / 10.0f - 10.0f;
+        }
+        x[17] = NAN;
+
+        int tiers = 0;
+        for (int tier = 0; ok && tier < KERNEL_TIER_COUNT; tier++) {
+            if (!dispatch_tier_supported((KernelTier)tier)) continue;
+            KernelDispatch table = dispatch_resolve(dispatch_tier_name((KernelTier)tier));
+            for (int i = 0; i < TEST_PARTICLES; i++) {
+                vx[0][i] = vx[1][i] = (float)(i % 7) - 3.0f;
+                vy[0][i] = vy[1][i] = (float)(i % 5) - 2.0f;
+            }
+            ParticleSoA reference = { x, y, vx[0], vy[0], TEST_PARTICLES };
+            ParticleSoA candidate = { x, y, vx[1], vy[1], TEST_PARTICLES };
+            field_lattice_sample_scalar(lattice, &reference, 0.016f);
+            table.lattice_sample(lattice, &candidate, 0.016f);
+            if (memcmp(vx[0], vx[1], sizeof(vx[0])) != 0 || memcmp(vy[0], vy[1], sizeof(vy[0])) != 0) {
+                printf("  ✗ %s tier differs from scalar\n", dispatch_tier_name((KernelTier)tier));
+                ok = 0;
+            }
+            tiers++;
+        }
+        if (ok) {
+            printf("  ✓ %d tiers bit-exact with scalar: PASSED\n", tiers);
+            passed_tests++;
+        } else {
+            printf("  ✗ Sampling kernels: FAILED\n");
+            failed_tests++;
+        }
+        field_lattice_destroy(lattice);
+    }
+
+    /* Test 4: Baked mode in the simulation */
+    printf("Test 4: Simulation Baked Mode\n");
+    {
+        Simulation *baked = sim_create(TEST_PARTICLES, WORLD_W, WORLD_H);
+        Simulation *direct = sim_create(TEST_PARTICLES, WORLD_W, WORLD_H);
+        int ok = baked && direct && sim_enable_baked_fields(baked, true, 0.5f) &&
+                 sim_get_field_lattice(baked) != NULL;
+
+        for (int s = 0; ok && s < 2; s++) {
+            Simulation *sim = s == 0 ? baked : direct;
+            sim_set_gravity(sim, 0.0f);
+            sim_add_force_field(sim, physics_create_vortex_field(20.0f, 15.0f, 30.0f, 0.0f));
+            sim_add_force_field(sim, physics_create_radial_field(45.0f, 10.0f, -20.0f, 0.0f));
+            for (int i = 0; i < 200; i++) {
+                sim_add_particle(sim, 5.3f + (float)(i % 20) * 2.5f, 3.2f + (float)(i / 20) * 2.5f, 0.0f, 0.0f);
+            }
+        }
+
+        /* One short step: velocity changes track direct evaluation away
+         * from the field centers, where bilinear sampling blurs the
+         * singularity */
+        float worst = 0.0f;
+        if (ok) {
+            sim_step(baked, 0.001f);
+            sim_step(direct, 0.001f);
+            ParticleSoA a = sim_get_particle_view(baked);
+            ParticleSoA b = sim_get_particle_view(direct);
+            ok = a.count == b.count;
+            for (int i = 0; ok && i < a.count; i++) {
+                if (hypotf(b.x[i] - 20.0f, b.y[i] - 15.0f) < 3.0f ||
+                    hypotf(b.x[i] - 45.0f, b.y[i] - 10.0f) < 3.0f) continue;
+                float error = hypotf(a.vx[i] - b.vx[i], a.vy[i] - b.vy[i]) / hypotf(b.vx[i], b.vy[i]);
+                if (error > worst) worst = error;
+            }
+        }
+
+        /* Re-baked only after the fields change */
+        const FieldLattice *lattice = sim_get_field_lattice(baked);
+        uint64_t after_first = lattice ? lattice->bakes : 0;
+        if (ok) {
+            sim_step(baked, 0.001f);
+            ok = lattice->bakes == after_first;
+            sim_add_force_field(baked, physics_create_directional_field(1.0f, 0.0f, 3.0f));
+            sim_step(baked, 0.001f);
+            ok = ok && lattice->bakes == after_first + 1;
+            sim_get_force_field(baked, 0)->strength = 10.0f;
+            sim_step(baked, 0.001f);
+            sim_step(baked, 0.001f);
+            ok = ok && lattice->bakes == after_first + 2;
+            sim_remove_force_field(baked, 2);
+            sim_step(baked, 0.001f);
+            ok = ok && lattice->bakes == after_first + 3;
+        }
+        ok = ok && after_first == 1 && worst < 0.05f &&
+             sim_enable_baked_fields(baked, false, 0.0f) && sim_get_field_lattice(baked) == NULL;
+        if (ok) {
+            printf("  ✓ Worst velocity error %.2e, re-baked only on change: PASSED\n", (double)worst);
+            passed_tests++;
+        } else {
+            printf("  ✗ Baked mode: FAILED (worst %.2e)\n", (double)worst);
+            failed_tests++;
+        }
+        sim_destroy(baked);
+        sim_destroy(direct);
+    }
+
+    /* Test 5: Error handling */
+    printf("Test 5: Error Handling\n");
+    {
+        FieldLattice *lattice = NULL;
+        if (field_lattice_create(0, WORLD_H, 1.0f) == NULL &&
+            field_lattice_create_with_error(WORLD_W, -1, 1.0f, &lattice).code == ERROR_INVALID_PARAMETER &&
+            field_lattice_create_with_error(WORLD_W, WORLD_H, 1.0f, NULL).code == ERROR_NULL_POINTER &&
+            field_lattice_bake(NULL, NULL, 0).code == ERROR_NULL_POINTER &&
+            !sim_enable_baked_fields(NULL, true, 1.0f) && sim_get_field_lattice(NULL) == NULL) {
+            printf("  ✓ Invalid arguments rejected: PASSED\n");
+            passed_tests++;
+        } else {
+            printf("  ✗ Invalid arguments rejected: FAILED\n");
+            failed_tests++;
+        }
+    }
+
+    printf("\n=== Test Results ===\n");
+    printf("Passed: %d\n", passed_tests);
+    printf("Failed: %d\n", failed_tests);
+
+    return failed_tests == 0 ? 0 : 1;
+}
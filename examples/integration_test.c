@@ -10,6 +10,12 @@
 #include "../src/input.h"
 #include "../src/particle.h"
 
+/* sim_foreach_particle visitor: sum particle speeds */
+static void accumulate_speed(const Particle *particle, int index, void *user_data) {
+    (void)index;
+    *(float *)user_data += sim_get_particle_speed(particle);
+}
+
 int main(void) {
     printf("=== ASCII Particle Simulator - Error Handling Integration Test ===\n\n");
     
@@ -112,6 +118,27 @@ int main(void) {
                 if (err.code == SUCCESS) {
                     printf("  ✓ Simulation step: PASSED\n");
                     passed_tests++;
+                    
+                    /* Test bulk view against indexed access */
+                    ParticleSoA view = sim_get_particle_view(sim);
+                    int mismatches = 0;
+                    for (int i = 0; i < view.count; i++) {
+                        Particle p;
+                        if (!sim_get_particle(sim, i, &p) || p.x != view.x[i] || p.y != view.y[i] ||
+                            p.vx != view.vx[i] || p.vy != view.vy[i]) {
+                            mismatches++;
+                        }
+                    }
+                    float speed_sum = 0.0f;
+                    int visited = sim_foreach_particle(sim, accumulate_speed, &speed_sum);
+                    if (view.count == sim_get_particle_count(sim) && mismatches == 0 &&
+                        visited == view.count && speed_sum > 0.0f) {
+                        printf("  ✓ Bulk particle view: PASSED\n");
+                        passed_tests++;
+                    } else {
+                        printf("  ✗ Bulk particle view: FAILED\n");
+                        failed_tests++;
+                    }
                 } else {
                     printf("  ✗ Simulation step: FAILED\n");
                     error_print(&err);
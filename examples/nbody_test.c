@@ -0,0 +1,286 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../src/error.h"
+#include "../src/nbody.h"
+#include "../src/thread_pool.h"
+#include "../src/sim.h"
+
+#define TEST_PARTICLES 6007  /* Enough for several parallel subtrees */
+
+/* Two offset clumps plus a sparse halo, so the tree is uneven */
+static void populate(float *x, float *y, int count) {
+    unsigned state = 99u;
+    for (int i = 0; i < count; i++) {
+        state = state * 1664525u + 1013904223u;
+        float r = (float)(state % 10000) / 10000.0f;
+        state = state * 1664525u + 1013904223u;
+        float angle = (float)(state % 6283) / 1000.0f;
+        float cx = i % 3 == 0 ? 40.0f : 140.0f;
+        float spread = i % 7 == 0 ? 90.0f : 15.0f;
+        x[i] = cx + spread * r * cosf(angle);
+        y[i] = 60.0f + spread * r * sinf(angle);
+    }
+}
+
+/* RMS of |a - b| over RMS of |b| */
+static float relative_rms(const float *ax, const float *ay, const float *bx, const float *by, int count) {
+    double diff = 0.0, norm = 0.0;
+    for (int i = 0; i < count; i++) {
+        diff += (double)(ax[i] - bx[i]) * (ax[i] - bx[i]) + (double)(ay[i] - by[i]) * (ay[i] - by[i]);
+        norm += (double)bx[i] * bx[i] + (double)by[i] * by[i];
+    }
+    return norm > 0.0 ? (float)sqrt(diff / norm) : 0.0f;
+}
+
+/* Check masses, centers of mass and ranges of every node below slot */
+static int check_node(const NBodyTree *tree, int slot, int *leaf_particles) {
+    const NBodyNode *node = &tree->nodes[slot];
+    if (node->mass != (float)(node->end - node->begin)) return 0;
+
+    int children = 0, covered = node->begin;
+    for (int c = 0; c < 4; c++) {
+        if (node->child[c] < 0) continue;
+        const NBodyNode *child = &tree->nodes[node->child[c]];
+        if (child->begin != covered || child->size > node->size * 0.5f) return 0;
+        covered = child->end;
+        children++;
+        if (!check_node(tree, node->child[c], leaf_particles)) return 0;
+    }
+    if (children == 0) {
+        *leaf_particles += node->end - node->begin;
+        float sum_x = 0.0f, sum_y = 0.0f;
+        for (int k = node->begin; k < node->end; k++) {
+            sum_x += tree->sorted_x[k];
+            sum_y += tree->sorted_y[k];
+        }
+        return fabsf(node->com_x - sum_x / node->mass) <= 1e-3f &&
+               fabsf(node->com_y - sum_y / node->mass) <= 1e-3f;
+    }
+    return children >= 2 && covered == node->end;
+}
+
+int main() {
+    printf("=== N-Body Test ===\n\n");
+
+    error_init();
+
+    int passed_tests = 0;
+    int failed_tests = 0;
+
+    static float x[TEST_PARTICLES], y[TEST_PARTICLES];
+    static float vx[TEST_PARTICLES], vy[TEST_PARTICLES];
+    static float ref_x[TEST_PARTICLES], ref_y[TEST_PARTICLES];
+    static float bh_x[TEST_PARTICLES], bh_y[TEST_PARTICLES];
+    populate(x, y, TEST_PARTICLES);
+    ParticleSoA particles = { x, y, vx, vy, TEST_PARTICLES };
+    NBodySettings settings = nbody_default_settings();
+
+    ThreadPool *pool = thread_pool_create(4);
+    NBodyTree *tree = nbody_tree_create(0);
+
+    /* Test 1: Tree structure */
+    printf("Test 1: Tree Build\n");
+    {
+        int ok = tree && pool && nbody_tree_build(tree, &particles, NULL).code == SUCCESS &&
+                 tree->root == 0 && tree->count == TEST_PARTICLES;
+
+        /* Keys sorted, order a permutation, every particle in one leaf */
+        int leaf_particles = 0;
+        for (int k = 1; ok && k < TEST_PARTICLES; k++) {
+            if (tree->keys[k - 1] > tree->keys[k]) ok = 0;
+        }
+        static unsigned char seen[TEST_PARTICLES];
+        memset(seen, 0, sizeof(seen));
+        for (int k = 0; ok && k < TEST_PARTICLES; k++) {
+            int i = tree->order[k];
+            if (seen[i]++ || tree->sorted_x[k] != x[i] || tree->sorted_y[k] != y[i]) ok = 0;
+        }
+        ok = ok && check_node(tree, tree->root, &leaf_particles) && leaf_particles == TEST_PARTICLES;
+
+        /* Root center of mass is the mean position */
+        double mean_x = 0.0, mean_y = 0.0;
+        for (int i = 0; i < TEST_PARTICLES; i++) {
+            mean_x += x[i];
+            mean_y += y[i];
+        }
+        mean_x /= TEST_PARTICLES;
+        mean_y /= TEST_PARTICLES;
+        ok = ok && fabs(tree->nodes[0].com_x - mean_x) < 1e-2 && fabs(tree->nodes[0].com_y - mean_y) < 1e-2;
+
+        if (ok) {
+            printf("  ✓ %d nodes, masses and centers consistent: PASSED\n", tree->stats.nodes);
+            passed_tests++;
+        } else {
+            printf("  ✗ Tree build: FAILED\n");
+            failed_tests++;
+        }
+    }
+
+    /* Test 2: Opening every node reproduces the direct sum */
+    printf("Test 2: Theta Zero Matches Brute Force\n");
+    {
+        NBodySettings exact = settings;
+        exact.theta = 0.0f;
+        int ok = nbody_compute_accelerations_brute(&particles, &exact, ref_x, ref_y, pool).code == SUCCESS &&
+                 nbody_compute_accelerations(tree, &exact, bh_x, bh_y, NULL).code == SUCCESS;
+        float error = relative_rms(bh_x, bh_y, ref_x, ref_y, TEST_PARTICLES);
+        if (ok && error < 1e-5f) {
+            printf("  ✓ Relative RMS error %.2e: PASSED\n", (double)error);
+            passed_tests++;
+        } else {
+            printf("  ✗ Theta zero: FAILED (error %.2e)\n", (double)error);
+            failed_tests++;
+        }
+    }
+
+    /* Test 3: Accuracy tightens as theta shrinks */
+    printf("Test 3: Opening Angle Accuracy\n");
+    {
+        float thetas[3] = { 1.0f, 0.5f, 0.25f };
+        float errors[3];
+        int ok = 1;
+        for (int t = 0; t < 3; t++) {
+            NBodySettings approx = settings;
+            approx.theta = thetas[t];
+            ok = ok && nbody_compute_accelerations(tree, &approx, bh_x, bh_y, NULL).code == SUCCESS;
+            errors[t] = relative_rms(bh_x, bh_y, ref_x, ref_y, TEST_PARTICLES);
+        }
+        ok = ok && errors[0] < 0.08f && errors[1] < 0.02f && errors[2] < errors[1] && errors[1] < errors[0];
+        if (ok) {
+            printf("  ✓ RMS error %.1e / %.1e / %.1e at theta 1 / 0.5 / 0.25: PASSED\n",
+                   (double)errors[0], (double)errors[1], (double)errors[2]);
+            passed_tests++;
+        } else {
+            printf("  ✗ Opening angle accuracy: FAILED\n");
+            failed_tests++;
+        }
+    }
+
+    /* Test 4: Parallel build and traversal give the same tree and forces,
+     * and rebuilding reuses the buffers */
+    printf("Test 4: Parallel Build and Reuse\n");
+    {
+        NBodyTree *serial = nbody_tree_create(TEST_PARTICLES);
+        int ok = serial && nbody_tree_build(serial, &particles, NULL).code == SUCCESS &&
+                 nbody_compute_accelerations(serial, &settings, ref_x, ref_y, NULL).code == SUCCESS;
+
+        const NBodyNode *nodes = tree->nodes;
+        int capacity = tree->capacity;
+        for (int frame = 0; ok && frame < 3; frame++) {
+            ok = nbody_tree_build(tree, &particles, pool).code == SUCCESS &&
+                 nbody_compute_accelerations(tree, &settings, bh_x, bh_y, pool).code == SUCCESS;
+        }
+        ok = ok && tree->nodes == nodes && tree->capacity == capacity && tree->stats.subtrees > 1 &&
+             tree->stats.nodes == serial->stats.nodes &&
+             memcmp(tree->keys, serial->keys, sizeof(uint32_t) * TEST_PARTICLES) == 0 &&
+             memcmp(tree->order, serial->order, sizeof(int) * TEST_PARTICLES) == 0 &&
+             memcmp(bh_x, ref_x, sizeof(bh_x)) == 0 && memcmp(bh_y, ref_y, sizeof(bh_y)) == 0;
+        if (ok) {
+            printf("  ✓ %d subtrees built in parallel, identical results: PASSED\n", tree->stats.subtrees);
+            passed_tests++;
+        } else {
+            printf("  ✗ Parallel build: FAILED\n");
+            failed_tests++;
+        }
+        nbody_tree_destroy(serial);
+    }
+
+    /* Test 5: Degenerate inputs */
+    printf("Test 5: Degenerate Inputs\n");
+    {
+        /* Coincident particles, a single particle, and none */
+        float cx[20], cy[20], cvx[20] = {0}, cvy[20] = {0};
+        for (int i = 0; i < 20; i++) {
+            cx[i] = i < 12 ? 5.0f : 5.0f + (float)i;
+            cy[i] = 7.0f;
+        }
+        ParticleSoA stacked = { cx, cy, cvx, cvy, 20 };
+        ParticleSoA single = { cx, cy, cvx, cvy, 1 };
+        ParticleSoA none = { cx, cy, cvx, cvy, 0 };
+        int ok = nbody_tree_build(tree, &stacked, pool).code == SUCCESS &&
+                 nbody_compute_accelerations(tree, &settings, bh_x, bh_y, pool).code == SUCCESS &&
+                 nbody_compute_accelerations_brute(&stacked, &settings, ref_x, ref_y, NULL).code == SUCCESS &&
+                 relative_rms(bh_x, bh_y, ref_x, ref_y, 20) < 1e-5f;
+        ok = ok && nbody_tree_build(tree, &single, NULL).code == SUCCESS &&
+             nbody_compute_accelerations(tree, &settings, bh_x, bh_y, NULL).code == SUCCESS &&
+             bh_x[0] == 0.0f && bh_y[0] == 0.0f;
+        ok = ok && nbody_tree_build(tree, &none, NULL).code == SUCCESS && tree->root == -1 &&
+             nbody_compute_accelerations(tree, &settings, bh_x, bh_y, NULL).code == SUCCESS;
+        if (ok) {
+            printf("  ✓ Coincident, single and empty sets: PASSED\n");
+            passed_tests++;
+        } else {
+            printf("  ✗ Degenerate inputs: FAILED\n");
+            failed_tests++;
+        }
+    }
+
+    /* Test 6: N-body mode in the simulation */
+    printf("Test 6: Simulation N-Body Mode\n");
+    {
+        Simulation *sim = sim_create(1000, 200, 120);
+        NBodySettings pull = { 5.0f, 0.5f, 1.0f };
+        int ok = sim && sim_enable_nbody(sim, true, &pull) && sim_get_nbody_tree(sim) != NULL;
+
+        /* A symmetric ring falls inward with (nearly) zero net momentum */
+        if (ok) {
+            sim_set_gravity(sim, 0.0f);
+            for (int i = 0; i < 400; i++) {
+                float angle = (float)i * 6.2831853f / 400.0f;
+                sim_add_particle(sim, 100.0f + 40.0f * cosf(angle), 60.0f + 40.0f * sinf(angle), 0.0f, 0.0f);
+            }
+            sim_step(sim, 0.01f);
+            ParticleSoA view = sim_get_particle_view(sim);
+            float momentum_x = 0.0f, momentum_y = 0.0f, inward = 0.0f;
+            for (int i = 0; i < view.count; i++) {
+                momentum_x += view.vx[i];
+                momentum_y += view.vy[i];
+                inward += -(view.vx[i] * (view.x[i] - 100.0f) + view.vy[i] * (view.y[i] - 60.0f));
+            }
+            ok = view.count == 400 && inward > 0.0f &&
+                 fabsf(momentum_x) < 1e-2f * inward && fabsf(momentum_y) < 1e-2f * inward &&
+                 sim_get_nbody_tree(sim)->stats.builds == 1;
+        }
+        ok = ok && sim_enable_nbody(sim, false, NULL) && sim_get_nbody_tree(sim) == NULL;
+        if (ok) {
+            printf("  ✓ Ring collapses inward with balanced momentum: PASSED\n");
+            passed_tests++;
+        } else {
+            printf("  ✗ Simulation N-body mode: FAILED\n");
+            failed_tests++;
+        }
+        sim_destroy(sim);
+    }
+
+    /* Test 7: Error handling */
+    printf("Test 7: Error Handling\n");
+    {
+        NBodyTree *created = NULL;
+        NBodySettings bad = settings;
+        bad.theta = -1.0f;
+        if (nbody_tree_create(-1) == NULL &&
+            nbody_tree_create_with_error(-1, &created).code == ERROR_INVALID_PARAMETER &&
+            nbody_tree_create_with_error(0, NULL).code == ERROR_NULL_POINTER &&
+            nbody_tree_build(NULL, &particles, NULL).code == ERROR_NULL_POINTER &&
+            nbody_compute_accelerations(tree, NULL, bh_x, bh_y, NULL).code == ERROR_NULL_POINTER &&
+            nbody_compute_accelerations_brute(&particles, &bad, ref_x, ref_y, NULL).code == ERROR_INVALID_PARAMETER &&
+            !sim_enable_nbody(NULL, true, NULL) && sim_get_nbody_tree(NULL) == NULL) {
+            printf("  ✓ Invalid arguments rejected: PASSED\n");
+            passed_tests++;
+        } else {
+            printf("  ✗ Invalid arguments rejected: FAILED\n");
+            failed_tests++;
+        }
+    }
+
+    nbody_tree_destroy(tree);
+    thread_pool_destroy(pool);
+
+    printf("\n=== Test Results ===\n");
+    printf("Passed: %d\n", passed_tests);
+    printf("Failed: %d\n", failed_tests);
+
+    return failed_tests == 0 ? 0 : 1;
+}
@@ -14,6 +14,7 @@
 #include "../src/sim.h"
 #include "../src/spatial_grid.h"
 #include "../src/physics.h"
+#include "../src/dispatch.h"
 
 #define WIDTH 120
 #define HEIGHT 40
@@ -159,6 +160,499 @@ void benchmark_force_fields(void) {
     print_separator();
 }
 
+/* Spawn a dense, slowly drifting pile: rows of particles just out of
+ * contact (collision radius 1), centred in the world */
+static void spawn_pile(Simulation *sim, int count) {
+    const int columns = 40;
+    const float spacing = 2.05f;
+    int rows = (count + columns - 1) / columns;
+    for (int i = 0; i < count; i++) {
+        float x = WIDTH / 2 + ((float)(i % columns) - columns / 2) * spacing;
+        float y = HEIGHT / 2 + ((float)(i / columns) - rows / 2) * spacing;
+        sim_add_particle(sim, x, y, (float)(i % 7 - 3) * 0.05f, (float)(i % 5 - 2) * 0.05f);
+    }
+}
+
+/* Compare grid rebuilds against Verlet lists on a slow pile */
+void benchmark_verlet(void) {
+    printf("\n");
+    print_separator();
+    printf("VERLET NEIGHBOR LIST BENCHMARK\n");
+    print_separator();
+
+    const int count = 600;
+    const int steps = 200;
+    double times[2] = {0.0, 0.0};
+    NeighborListStats list_stats = {0};
+
+    for (int mode = 0; mode < 2; mode++) {
+        Simulation *sim = sim_create(count, WIDTH, HEIGHT);
+        if (!sim) {
+            printf("ERROR: Failed to create simulation\n");
+            return;
+        }
+        sim_set_gravity(sim, 0.0f);
+        spawn_pile(sim, count);
+        sim_enable_collisions(sim, true);
+        if (mode == 1 && !sim_enable_verlet_lists(sim, true, 0.0f)) {
+            printf("ERROR: Failed to allocate neighbor lists\n");
+            sim_destroy(sim);
+            return;
+        }
+
+        clock_t start = clock();
+        for (int i = 0; i < steps; i++) {
+            sim_step(sim, 0.016f);
+        }
+        times[mode] = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+        if (mode == 1) {
+            list_stats = sim_get_neighbor_list_stats(sim);
+        }
+        sim_destroy(sim);
+    }
+
+    printf("Particles: %d in a %dx%d world, %d steps\n", count, WIDTH, HEIGHT, steps);
+    printf("Grid every step:  %.2f ms/step\n", times[0] / steps * 1000.0);
+    printf("Verlet lists:     %.2f ms/step (%lu builds, %lu reuses, %d pairs)\n",
+           times[1] / steps * 1000.0, (unsigned long)list_stats.builds,
+           (unsigned long)list_stats.reuses, list_stats.pairs);
+    if (times[1] > 0.0) {
+        printf("Speedup:          %.1fx\n", times[0] / times[1]);
+    }
+    print_separator();
+}
+
+/* Compare collision steps with and without Morton-ordered storage */
+void benchmark_morton(void) {
+    printf("\n");
+    print_separator();
+    printf("MORTON REORDERING BENCHMARK\n");
+    print_separator();
+
+    const int count = 100000;
+    const int world = 1000;
+    const int steps = 60;
+    double times[2] = {0.0, 0.0};
+
+    for (int mode = 0; mode < 2; mode++) {
+        Simulation *sim = sim_create(count, world, world);
+        if (!sim) {
+            printf("ERROR: Failed to create simulation\n");
+            return;
+        }
+        sim_set_gravity(sim, 0.0f);
+        sim_enable_collisions(sim, true);
+
+        /* Same scattered set both times: storage order unrelated to position */
+        srand(1234);
+        for (int i = 0; i < count; i++) {
+            float x = (float)rand() / RAND_MAX * (world - 1);
+            float y = (float)rand() / RAND_MAX * (world - 1);
+            sim_add_particle(sim, x, y, (float)(rand() % 11 - 5), (float)(rand() % 11 - 5));
+        }
+        if (mode == 1) {
+            sim_reorder_particles(sim, NULL);
+            sim_set_reorder_interval(sim, 30);
+        }
+
+        clock_t start = clock();
+        for (int i = 0; i < steps; i++) {
+            sim_step(sim, 0.016f);
+        }
+        times[mode] = (double)(clock() - start) / CLOCKS_PER_SEC;
+        sim_destroy(sim);
+    }
+
+    printf("Particles: %d in a %dx%d world, %d steps\n", count, world, world, steps);
+    printf("Spawn order:      %.2f ms/step\n", times[0] / steps * 1000.0);
+    printf("Morton order:     %.2f ms/step (reordered every 30 steps)\n", times[1] / steps * 1000.0);
+    if (times[1] > 0.0) {
+        printf("Speedup:          %.2fx\n", times[0] / times[1]);
+    }
+    print_separator();
+}
+
+/* Compare one-at-a-time radius queries against one batched call */
+void benchmark_batch_queries(void) {
+    printf("\n");
+    print_separator();
+    printf("BATCHED RADIUS QUERY BENCHMARK\n");
+    print_separator();
+
+    const int count = 50000;
+    const int world = 500;
+    enum { QUERIES = 2000, ROUNDS = 20 };
+    static float qx[QUERIES], qy[QUERIES], qr[QUERIES];
+    static int found[50000];
+
+    float *x = malloc(sizeof(float) * count);
+    float *y = malloc(sizeof(float) * count);
+    SpatialGrid *grid = spatial_grid_create_with_capacity(world, world, 10.0f, count);
+    FrameArena *arena = arena_create(0);
+    if (!x || !y || !grid || !arena) {
+        printf("ERROR: Failed to allocate benchmark data\n");
+        free(x);
+        free(y);
+        spatial_grid_destroy(grid);
+        arena_destroy(arena);
+        return;
+    }
+
+    srand(99);
+    for (int i = 0; i < count; i++) {
+        x[i] = (float)rand() / RAND_MAX * world;
+        y[i] = (float)rand() / RAND_MAX * world;
+    }
+    for (int q = 0; q < QUERIES; q++) {
+        qx[q] = (float)rand() / RAND_MAX * world;
+        qy[q] = (float)rand() / RAND_MAX * world;
+        qr[q] = 5.0f + (float)(q % 4) * 5.0f;
+    }
+    ParticleSoA view = { x, y, NULL, NULL, count };
+    spatial_grid_rebuild(grid, &view);
+
+    long single_matches = 0;
+    clock_t start = clock();
+    for (int r = 0; r < ROUNDS; r++) {
+        for (int q = 0; q < QUERIES; q++) {
+            single_matches += spatial_grid_query_radius(grid, &view, qx[q], qy[q], qr[q], found, count);
+        }
+    }
+    double single_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    GridQueryResults results;
+    spatial_grid_query_results_init(&results);
+    long batch_matches = 0;
+    start = clock();
+    for (int r = 0; r < ROUNDS; r++) {
+        arena_reset(arena);
+        spatial_grid_query_radius_batch(grid, &view, qx, qy, qr, QUERIES, arena, &results);
+        batch_matches += results.offsets[QUERIES];
+    }
+    double batch_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    printf("Particles: %d, %d queries x %d rounds\n", count, QUERIES, ROUNDS);
+    printf("Single queries:   %.2f ms/round (%ld matches)\n", single_time / ROUNDS * 1000.0, single_matches);
+    printf("Batched (%s):  %.2f ms/round (%ld matches)\n", dispatch_tier_name(dispatch_get()->tier),
+           batch_time / ROUNDS * 1000.0, batch_matches);
+    if (batch_time > 0.0) {
+        printf("Speedup:          %.2fx\n", single_time / batch_time);
+    }
+    print_separator();
+
+    spatial_grid_query_results_free(&results);
+    spatial_grid_destroy(grid);
+    arena_destroy(arena);
+    free(x);
+    free(y);
+}
+
+/* Benchmark the standalone field pass: scalar against the dispatched kernel */
+void benchmark_field_kernels(void) {
+    printf("\n");
+    print_separator();
+    printf("FIELD-MAJOR FORCE-FIELD BENCHMARK\n");
+    print_separator();
+
+    const int count = 100000;
+    enum { ROUNDS = 50 };
+    ForceField fields[4] = {
+        physics_create_vortex_field(WIDTH / 2, HEIGHT / 2, 50.0f, 30.0f),
+        physics_create_attractor_field(WIDTH / 2, HEIGHT / 2, 200.0f, 0),
+        physics_create_radial_field(WIDTH / 4, HEIGHT / 2, 40.0f, 20.0f),
+        physics_create_directional_field(1.0f, 0.0f, 5.0f)
+    };
+
+    float *x = malloc(sizeof(float) * count);
+    float *y = malloc(sizeof(float) * count);
+    float *vx = calloc((size_t)count, sizeof(float));
+    float *vy = calloc((size_t)count, sizeof(float));
+    if (!x || !y || !vx || !vy) {
+        printf("ERROR: Failed to allocate benchmark data\n");
+        free(x);
+        free(y);
+        free(vx);
+        free(vy);
+        return;
+    }
+
+    srand(7);
+    for (int i = 0; i < count; i++) {
+        x[i] = (float)rand() / RAND_MAX * WIDTH;
+        y[i] = (float)rand() / RAND_MAX * HEIGHT;
+    }
+    ParticleSoA view = { x, y, vx, vy, count };
+
+    clock_t start = clock();
+    for (int r = 0; r < ROUNDS; r++) {
+        physics_apply_force_fields(&view, fields, 4, 0.016f);
+    }
+    double scalar_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    for (int r = 0; r < ROUNDS; r++) {
+        dispatch_get()->fields(&view, fields, 4, 0.016f);
+    }
+    double vector_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    printf("Particles: %d, 4 fields x %d rounds\n", count, ROUNDS);
+    printf("Scalar:           %.2f ms/round\n", scalar_time / ROUNDS * 1000.0);
+    printf("Vector (%s):  %.2f ms/round\n", dispatch_tier_name(dispatch_get()->tier),
+           vector_time / ROUNDS * 1000.0);
+    if (vector_time > 0.0) {
+        printf("Speedup:          %.2fx\n", scalar_time / vector_time);
+    }
+
+    /* The same fields inside sim_step, where the fused kernel applies them */
+    double step_time[2] = {0.0, 0.0};
+    for (int with_fields = 0; with_fields < 2; with_fields++) {
+        Simulation *sim = sim_create(count, WIDTH, HEIGHT);
+        if (!sim) continue;
+        sim_set_gravity(sim, 0.0f);
+        for (int i = 0; i < count; i++) {
+            sim_add_particle(sim, x[i], y[i], 1.0f, 0.0f);
+        }
+        for (int f = 0; with_fields && f < 4; f++) {
+            sim_add_force_field(sim, fields[f]);
+        }
+        start = clock();
+        for (int r = 0; r < ROUNDS; r++) {
+            sim_step(sim, 0.016f);
+        }
+        step_time[with_fields] = (double)(clock() - start) / CLOCKS_PER_SEC;
+        sim_destroy(sim);
+    }
+    printf("sim_step (%s): %.2f ms/step, %.2f ms without fields\n",
+           physics_get_step_function_name(dispatch_get()->fused_step),
+           step_time[1] / ROUNDS * 1000.0, step_time[0] / ROUNDS * 1000.0);
+    print_separator();
+
+    free(x);
+    free(y);
+    free(vx);
+    free(vy);
+}
+
+/* Benchmark many static fields: per-field evaluation against the baked lattice */
+void benchmark_baked_fields(void) {
+    printf("\n");
+    print_separator();
+    printf("BAKED FORCE-FIELD BENCHMARK\n");
+    print_separator();
+
+    const int count = 50000;
+    enum { FIELDS = 32, STEPS = 50 };
+    double times[2] = {0.0, 0.0};
+
+    for (int baked = 0; baked < 2; baked++) {
+        Simulation *sim = sim_create(count, WIDTH, HEIGHT);
+        if (!sim || (baked && !sim_enable_baked_fields(sim, true, 0.5f))) {
+            printf("ERROR: Failed to create simulation\n");
+            sim_destroy(sim);
+            return;
+        }
+        sim_set_gravity(sim, 0.0f);
+
+        srand(11);
+        for (int f = 0; f < FIELDS; f++) {
+            float fx = (float)rand() / RAND_MAX * WIDTH;
+            float fy = (float)rand() / RAND_MAX * HEIGHT;
+            sim_add_force_field(sim, f % 2 ? physics_create_vortex_field(fx, fy, 20.0f, 15.0f)
+                                           : physics_create_radial_field(fx, fy, -10.0f, 10.0f));
+        }
+        for (int i = 0; i < count; i++) {
+            sim_add_particle(sim, (float)rand() / RAND_MAX * (WIDTH - 1),
+                             (float)rand() / RAND_MAX * (HEIGHT - 1), 0.0f, 0.0f);
+        }
+
+        clock_t start = clock();
+        for (int step = 0; step < STEPS; step++) {
+            sim_step(sim, 0.016f);
+        }
+        times[baked] = (double)(clock() - start) / CLOCKS_PER_SEC;
+        sim_destroy(sim);
+    }
+
+    printf("Particles: %d, %d fields x %d steps\n", count, FIELDS, STEPS);
+    printf("Per-field:        %.2f ms/step\n", times[0] / STEPS * 1000.0);
+    printf("Baked (%s):   %.2f ms/step\n", dispatch_tier_name(dispatch_get()->tier),
+           times[1] / STEPS * 1000.0);
+    if (times[1] > 0.0) {
+        printf("Speedup:          %.2fx\n", times[0] / times[1]);
+    }
+    print_separator();
+}
+
+/* Benchmark small local fields: every particle against grid-culled cells */
+void benchmark_culled_fields(void) {
+    printf("\n");
+    print_separator();
+    printf("GRID-CULLED FORCE-FIELD BENCHMARK\n");
+    print_separator();
+
+    /* Small local fields scattered over a large world */
+    const int count = 100000, world_w = 1000, world_h = 500;
+    enum { FIELDS = 64, STEPS = 50 };
+    double times[2] = {0.0, 0.0};
+
+    for (int culled = 0; culled < 2; culled++) {
+        Simulation *sim = sim_create(count, world_w, world_h);
+        if (!sim) {
+            printf("ERROR: Failed to create simulation\n");
+            return;
+        }
+        sim_set_gravity(sim, 0.0f);
+        sim_enable_field_culling(sim, culled);
+
+        srand(13);
+        for (int f = 0; f < FIELDS; f++) {
+            float fx = (float)rand() / RAND_MAX * world_w;
+            float fy = (float)rand() / RAND_MAX * world_h;
+            sim_add_force_field(sim, f % 2 ? physics_create_vortex_field(fx, fy, 20.0f, 15.0f)
+                                           : physics_create_radial_field(fx, fy, -10.0f, 10.0f));
+        }
+        for (int i = 0; i < count; i++) {
+            sim_add_particle(sim, (float)rand() / RAND_MAX * (world_w - 1),
+                             (float)rand() / RAND_MAX * (world_h - 1), 0.0f, 0.0f);
+        }
+
+        clock_t start = clock();
+        for (int step = 0; step < STEPS; step++) {
+            sim_step(sim, 0.016f);
+        }
+        times[culled] = (double)(clock() - start) / CLOCKS_PER_SEC;
+        sim_destroy(sim);
+    }
+
+    printf("Particles: %d in %dx%d, %d fields x %d steps\n", count, world_w, world_h, FIELDS, STEPS);
+    printf("Every particle:   %.2f ms/step\n", times[0] / STEPS * 1000.0);
+    printf("Grid-culled:      %.2f ms/step\n", times[1] / STEPS * 1000.0);
+    if (times[1] > 0.0) {
+        printf("Speedup:          %.2fx\n", times[0] / times[1]);
+    }
+    print_separator();
+}
+
+/* Benchmark Barnes-Hut gravity against the O(n²) direct sum */
+void benchmark_nbody(void) {
+    printf("\n");
+    print_separator();
+    printf("BARNES-HUT N-BODY BENCHMARK\n");
+    print_separator();
+
+    const int counts[3] = {2000, 8000, 32000};
+    NBodySettings settings = nbody_default_settings();
+    NBodyTree *tree = nbody_tree_create(counts[2]);
+    float *x = malloc(sizeof(float) * counts[2]);
+    float *y = malloc(sizeof(float) * counts[2]);
+    float *bh_x = malloc(sizeof(float) * counts[2]);
+    float *bh_y = malloc(sizeof(float) * counts[2]);
+    float *ref_x = malloc(sizeof(float) * counts[2]);
+    float *ref_y = malloc(sizeof(float) * counts[2]);
+    if (!tree || !x || !y || !bh_x || !bh_y || !ref_x || !ref_y) {
+        printf("ERROR: Failed to allocate benchmark data\n");
+    } else {
+
+        printf("Theta %.2f, softening %.1f\n\n", (double)settings.theta, (double)settings.softening);
+        printf("%-10s | %-12s | %-12s | %-8s | %s\n", "Particles", "Brute (ms)", "Tree (ms)", "Speedup", "RMS error");
+        printf("-----------|--------------|--------------|----------|----------\n");
+
+        srand(17);
+        for (int i = 0; i < counts[2]; i++) {
+            x[i] = (float)rand() / RAND_MAX * WIDTH;
+            y[i] = (float)rand() / RAND_MAX * HEIGHT;
+        }
+
+        for (int c = 0; c < 3; c++) {
+            ParticleSoA particles = { x, y, NULL, NULL, counts[c] };
+
+            clock_t start = clock();
+            nbody_compute_accelerations_brute(&particles, &settings, ref_x, ref_y, NULL);
+            double brute_ms = (double)(clock() - start) / CLOCKS_PER_SEC * 1000.0;
+
+            const int frames = 10;
+            start = clock();
+            for (int frame = 0; frame < frames; frame++) {
+                nbody_tree_build(tree, &particles, NULL);
+                nbody_compute_accelerations(tree, &settings, bh_x, bh_y, NULL);
+            }
+            double tree_ms = (double)(clock() - start) / CLOCKS_PER_SEC * 1000.0 / frames;
+
+            double diff = 0.0, norm = 0.0;
+            for (int i = 0; i < counts[c]; i++) {
+                diff += (double)(bh_x[i] - ref_x[i]) * (bh_x[i] - ref_x[i]) +
+                        (double)(bh_y[i] - ref_y[i]) * (bh_y[i] - ref_y[i]);
+                norm += (double)ref_x[i] * ref_x[i] + (double)ref_y[i] * ref_y[i];
+            }
+            printf("%-10d | %12.2f | %12.2f | %7.1fx | %.1e\n", counts[c], brute_ms, tree_ms,
+                   tree_ms > 0.0 ? brute_ms / tree_ms : 0.0, norm > 0.0 ? sqrt(diff / norm) : 0.0);
+        }
+        print_separator();
+    }
+
+    nbody_tree_destroy(tree);
+    free(x);
+    free(y);
+    free(bh_x);
+    free(bh_y);
+    free(ref_x);
+    free(ref_y);
+}
+
+/* Benchmark SPH fluid steps at several densities */
+void benchmark_sph(void) {
+    printf("\n");
+    print_separator();
+    printf("SPH FLUID BENCHMARK\n");
+    print_separator();
+
+    const int counts[3] = {1000, 4000, 16000};
+    const int steps = 50;
+    SPHSolver *solver = sph_create(WIDTH, HEIGHT, NULL, counts[2]);
+    float *x = malloc(sizeof(float) * counts[2]);
+    float *y = malloc(sizeof(float) * counts[2]);
+    float *vx = malloc(sizeof(float) * counts[2]);
+    float *vy = malloc(sizeof(float) * counts[2]);
+    if (!solver || !x || !y || !vx || !vy) {
+        printf("ERROR: Failed to allocate benchmark data\n");
+    } else {
+        printf("Smoothing radius %.1f, %d density + force steps\n\n",
+               (double)solver->settings.smoothing_radius, steps);
+        printf("%-10s | %-12s | %s\n", "Particles", "Step (ms)", "Neighbours/particle");
+        printf("-----------|--------------|--------------------\n");
+
+        for (int c = 0; c < 3; c++) {
+            /* Spread the particles evenly over the whole world */
+            float spacing = sqrtf((float)WIDTH * HEIGHT / counts[c]);
+            int cols = (int)(WIDTH / spacing);
+            for (int i = 0; i < counts[c]; i++) {
+                x[i] = (0.5f + (float)(i % cols)) * spacing;
+                y[i] = (0.5f + (float)(i / cols)) * spacing;
+                vx[i] = 0.0f;
+                vy[i] = 0.0f;
+            }
+            ParticleSoA particles = { x, y, vx, vy, counts[c] };
+
+            clock_t start = clock();
+            for (int step = 0; step < steps; step++) {
+                sph_step(solver, &particles, 0.016f, NULL, NULL);
+            }
+            double step_ms = (double)(clock() - start) / CLOCKS_PER_SEC * 1000.0 / steps;
+
+            printf("%-10d | %12.3f | %.1f\n", counts[c], step_ms,
+                   (double)solver->stats.neighbors / counts[c]);
+        }
+        print_separator();
+    }
+
+    sph_destroy(solver);
+    free(x);
+    free(y);
+    free(vx);
+    free(vy);
+}
+
 /* Test different particle counts */
 void scaling_test(void) {
     printf("\n");
@@ -218,6 +712,9 @@ int main(int argc, char **argv) {
     print_separator();
     printf("ENHANCED PHYSICS BENCHMARK (Week 2)\n");
     print_separator();
+    /* Set SIM_KERNEL=scalar|sse4|avx2|avx512|neon to A/B kernel tiers */
+    printf("Kernel tier: %s%s\n", dispatch_tier_name(dispatch_get()->tier),
+           dispatch_get()->overridden ? " (" DISPATCH_ENV_VAR ")" : "");
     printf("\n");
 
     srand((unsigned)time(NULL));
@@ -236,6 +733,14 @@ int main(int argc, char **argv) {
         /* Run all benchmarks */
         benchmark_collisions(500);
         benchmark_force_fields();
+        benchmark_verlet();
+        benchmark_morton();
+        benchmark_batch_queries();
+        benchmark_field_kernels();
+        benchmark_baked_fields();
+        benchmark_culled_fields();
+        benchmark_nbody();
+        benchmark_sph();
         scaling_test();
 
         printf("\nSUMMARY:\n");
@@ -217,12 +217,12 @@ void run_demo(DemoMode mode) {
         /* Draw particles */
         int count = sim_get_particle_count(sim);
         for (int i = 0; i < count; i++) {
-            const Particle *p = sim_get_particle(sim, i);
-            if (p && p->active) {
-                int x = (int)p->x;
-                int y = (int)p->y;
+            Particle p;
+            if (sim_get_particle(sim, i, &p)) {
+                int x = (int)p.x;
+                int y = (int)p.y;
                 if (x >= 0 && x < WIDTH && y >= 0 && y < HEIGHT) {
-                    float speed = sim_get_particle_speed(p);
+                    float speed = sim_get_particle_speed(&p);
                     uint32_t color = sim_speed_to_color(speed);
                     renderer_draw(renderer, x, y, '*', color);
                 }
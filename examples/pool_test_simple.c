@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <stdint.h>
 #include <sys/time.h>
 #include "../src/pool.h"
 
@@ -203,19 +204,75 @@ static int test_performance(void) {
     return 1;
 }
 
+/* Test 5: Structure-of-Arrays Pool */
+static int test_soa_pool(void) {
+    printf("Test 5: Structure-of-Arrays Pool\n");
+    
+    ParticlePoolSoA *pool = pool_soa_create(TEST_CAPACITY);
+    if (!pool) {
+        printf("  ❌ Failed to create SoA pool\n");
+        return 0;
+    }
+    
+    /* Columns must be aligned for in-place SIMD kernels */
+    if (((uintptr_t)pool->x | (uintptr_t)pool->y | (uintptr_t)pool->vx | (uintptr_t)pool->vy)
+        % POOL_SOA_ALIGNMENT != 0) {
+        printf("  ❌ SoA columns are not %d-byte aligned\n", POOL_SOA_ALIGNMENT);
+        pool_soa_destroy(pool);
+        return 0;
+    }
+    
+    for (int i = 0; i < 5; i++) {
+        int idx = pool_soa_allocate(pool);
+        if (idx != i) {
+            printf("  ❌ Expected dense slot %d, got %d\n", i, idx);
+            pool_soa_destroy(pool);
+            return 0;
+        }
+        pool->x[idx] = (float)i;
+    }
+    
+    /* Freeing a middle slot moves the last particle into it */
+    pool_soa_free(pool, 1);
+    if (pool_soa_get_active_count(pool) != 4 || pool->x[1] != 4.0f) {
+        printf("  ❌ Swap-remove did not keep the pool dense\n");
+        pool_soa_destroy(pool);
+        return 0;
+    }
+    
+    ParticleSoA view = pool_soa_get_view(pool);
+    if (view.count != 4 || view.x != pool->x) {
+        printf("  ❌ Column view does not match pool state\n");
+        pool_soa_destroy(pool);
+        return 0;
+    }
+    
+    pool_soa_clear(pool);
+    if (pool_soa_get_free_count(pool) != TEST_CAPACITY) {
+        printf("  ❌ Clear did not release all slots\n");
+        pool_soa_destroy(pool);
+        return 0;
+    }
+    
+    pool_soa_destroy(pool);
+    printf("  ✅ Structure-of-arrays pool test passed\n");
+    return 1;
+}
+
 /* Main test runner */
 int main(void) {
     printf("=== Object Pool Test Suite ===\n");
     printf("Testing particle pooling implementation...\n\n");
     
     int tests_passed = 0;
-    int total_tests = 4;
+    int total_tests = 5;
     
     /* Run all tests */
     tests_passed += test_pool_creation();
     tests_passed += test_particle_allocation();
     tests_passed += test_pool_iterator();
     tests_passed += test_performance();
+    tests_passed += test_soa_pool();
     
     printf("\n=== Test Results ===\n");
     printf("Tests passed: %d/%d\n", tests_passed, total_tests);
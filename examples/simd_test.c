@@ -5,6 +5,8 @@
 #include <math.h>
 #include "../src/simd.h"
 #include "../src/particle.h"
+#include "../src/physics.h"
+#include "../src/dispatch.h"
 
 /* Performance measurement helper */
 static double get_time_ms(void) {
@@ -818,13 +820,525 @@ static int test_physics_calculation_accuracy(void) {
     return 1;
 }
 
+/* Test 15: Structure-of-Arrays Kernels */
+static int test_soa_kernels(void) {
+    printf("Test 15: Structure-of-Arrays Kernels\n");
+    
+    const int test_count = 1003; /* Not a multiple of any vector width */
+    const size_t alignment = 64;
+    const size_t column_size = simd_align_size(test_count * sizeof(float), alignment);
+    const float dt = 1.0f / 60.0f;
+    const float gravity = 30.0f;
+    const float windx = 5.0f;
+    const float windy = -2.0f;
+    
+    Particle *reference = (Particle *)simd_aligned_alloc(test_count * sizeof(Particle), alignment);
+    float *x = (float *)simd_aligned_alloc(column_size, alignment);
+    float *y = (float *)simd_aligned_alloc(column_size, alignment);
+    float *vx = (float *)simd_aligned_alloc(column_size, alignment);
+    float *vy = (float *)simd_aligned_alloc(column_size, alignment);
+    if (!reference || !x || !y || !vx || !vy) {
+        printf("  ❌ Failed to allocate test data\n");
+        simd_aligned_free(reference);
+        simd_aligned_free(x);
+        simd_aligned_free(y);
+        simd_aligned_free(vx);
+        simd_aligned_free(vy);
+        return 0;
+    }
+    
+    for (int i = 0; i < test_count; i++) {
+        reference[i].x = x[i] = (float)i;
+        reference[i].y = y[i] = (float)(i * 2);
+        reference[i].vx = vx[i] = (float)(i * 3);
+        reference[i].vy = vy[i] = (float)(i * 4);
+    }
+    
+    simd_step_scalar(reference, test_count, dt, gravity, windx, windy);
+    
+    simd_soa_step_func_t func = simd_select_soa_step_function();
+    printf("  📊 Selected SoA Function: %s\n", simd_get_soa_function_name(func));
+    func(x, y, vx, vy, test_count, dt, gravity, windx, windy);
+    
+    int passed = 1;
+    for (int i = 0; i < test_count; i++) {
+        float tolerance = 1e-5f * (1.0f + fabsf(reference[i].y));
+        if (fabsf(x[i] - reference[i].x) > tolerance ||
+            fabsf(y[i] - reference[i].y) > tolerance ||
+            fabsf(vx[i] - reference[i].vx) > tolerance ||
+            fabsf(vy[i] - reference[i].vy) > tolerance) {
+            printf("  ❌ SoA results don't match AoS scalar at index %d\n", i);
+            passed = 0;
+            break;
+        }
+    }
+    
+    simd_aligned_free(reference);
+    simd_aligned_free(x);
+    simd_aligned_free(y);
+    simd_aligned_free(vx);
+    simd_aligned_free(vy);
+    
+    if (passed) {
+        printf("  ✅ Structure-of-arrays kernel test passed\n");
+    }
+    return passed;
+}
+
+/* Step the same particles once with a fused kernel and with the scalar
+ * one. Fields only change velocities, so positions and despawn marks must
+ * match exactly; velocities may differ by PHYSICS_FIELD_SIMD_TOLERANCE of
+ * the scalar value and of the part the fields contributed. Returns the
+ * first differing index, -1 if none, or -2 if allocation failed. */
+static int fused_step_mismatch(physics_step_func_t func, const PhysicsStepParams *params,
+                               float *const state[4], int count) {
+    PhysicsStepParams bare = *params;
+    bare.num_fields = 0;
+
+    /* 0 = scalar, 1 = candidate, 2 = scalar without fields */
+    float *columns[3][4] = {{NULL}};
+    uint8_t *despawn[3] = {NULL};
+    int allocated = 1;
+    for (int k = 0; k < 3; k++) {
+        despawn[k] = malloc((size_t)count);
+        if (!despawn[k]) allocated = 0;
+        for (int c = 0; c < 4; c++) {
+            columns[k][c] = malloc(sizeof(float) * count);
+            if (!columns[k][c]) allocated = 0;
+            else memcpy(columns[k][c], state[c], sizeof(float) * count);
+        }
+    }
+
+    int mismatch = allocated ? -1 : -2;
+    if (allocated) {
+        ParticleSoA views[3];
+        for (int k = 0; k < 3; k++) {
+            views[k] = (ParticleSoA){ columns[k][0], columns[k][1], columns[k][2], columns[k][3], count };
+        }
+        physics_step_fused_scalar(&views[0], params, despawn[0]);
+        func(&views[1], params, despawn[1]);
+        physics_step_fused_scalar(&views[2], &bare, despawn[2]);
+
+        for (int i = 0; i < count && mismatch < 0; i++) {
+            if (columns[0][0][i] != columns[1][0][i] || columns[0][1][i] != columns[1][1][i] ||
+                despawn[0][i] != despawn[1][i]) {
+                mismatch = i;
+            }
+            for (int c = 2; c < 4 && mismatch < 0; c++) {
+                float reference = columns[0][c][i];
+                float change = reference - columns[2][c][i];
+                float slack = PHYSICS_FIELD_SIMD_TOLERANCE * (fabsf(change) + fabsf(reference));
+                if (fabsf(columns[1][c][i] - reference) > slack) {
+                    mismatch = i;
+                }
+            }
+        }
+    }
+
+    for (int k = 0; k < 3; k++) {
+        free(despawn[k]);
+        for (int c = 0; c < 4; c++) {
+            free(columns[k][c]);
+        }
+    }
+    return mismatch;
+}
+
+/* Test 16: Fused Step Kernels */
+static int test_fused_kernels(void) {
+    printf("Test 16: Fused Step Kernels\n");
+    
+    const int test_count = 1003; /* Not a multiple of any vector width */
+    const size_t alignment = 64;
+    const size_t column_size = simd_align_size(test_count * sizeof(float), alignment);
+    
+    ForceField fields[4] = {
+        physics_create_radial_field(20.0f, 20.0f, 40.0f, 15.0f),
+        physics_create_vortex_field(60.0f, 30.0f, 25.0f, 0.0f),
+        physics_create_attractor_field(40.0f, 10.0f, 200.0f, 30.0f),
+        physics_create_directional_field(1.0f, 0.5f, 8.0f)
+    };
+    PhysicsStepParams params = {
+        .dt = 1.0f / 60.0f, .gravity = 30.0f, .windx = 5.0f, .windy = -2.0f,
+        .width = 80.0f, .height = 40.0f, .fields = fields, .num_fields = 4
+    };
+    
+    float *columns[2][4];
+    uint8_t despawn[2][1003];
+    int allocated = 1;
+    for (int k = 0; k < 2; k++) {
+        for (int c = 0; c < 4; c++) {
+            columns[k][c] = (float *)simd_aligned_alloc(column_size, alignment);
+            if (!columns[k][c]) allocated = 0;
+        }
+    }
+    
+    /* Mix of free-flying, wall-hitting and resting particles */
+    for (int i = 0; allocated && i < test_count; i++) {
+        float x = (float)((i * 37) % 90) - 5.0f;
+        float y = (float)((i * 11) % 45) - 2.0f;
+        float vx = (float)((i * 7) % 41) - 20.0f;
+        float vy = (float)((i * 13) % 41) - 20.0f;
+        if (i % 5 == 0) {
+            y = 38.5f;
+            vx = 0.1f;
+            vy = 0.0f;
+        }
+        for (int k = 0; k < 2; k++) {
+            columns[k][0][i] = x;
+            columns[k][1][i] = y;
+            columns[k][2][i] = vx;
+            columns[k][3][i] = vy;
+        }
+    }
+    
+    int passed = allocated;
+    if (allocated) {
+        ParticleSoA reference = { columns[0][0], columns[0][1], columns[0][2], columns[0][3], test_count };
+        ParticleSoA candidate = { columns[1][0], columns[1][1], columns[1][2], columns[1][3], test_count };
+        
+        physics_step_func_t func = physics_select_step_function();
+        printf("  📊 Selected Fused Function: %s\n", physics_get_step_function_name(func));
+        
+        /* With fields: one step, within the field tolerance */
+        int mismatch = fused_step_mismatch(func, &params, columns[0], test_count);
+        if (mismatch != -1) {
+            printf("  ❌ Fused kernel with fields differs from scalar at index %d\n", mismatch);
+            passed = 0;
+        }
+        
+        PhysicsStepParams bare = params;
+        bare.num_fields = 0;
+        int reference_despawned = 0, candidate_despawned = 0;
+        for (int step = 0; step < 10; step++) {
+            reference_despawned += physics_step_fused_scalar(&reference, &bare, despawn[0]);
+            candidate_despawned += func(&candidate, &bare, despawn[1]);
+        }
+        
+        /* Without fields the vector kernels use the same operation order,
+         * so integration, walls and despawn match exactly */
+        for (int i = 0; i < test_count && passed; i++) {
+            for (int c = 0; c < 4; c++) {
+                if (columns[0][c][i] != columns[1][c][i]) {
+                    printf("  ❌ Fused kernel differs from scalar at index %d\n", i);
+                    passed = 0;
+                    break;
+                }
+            }
+            if (passed && despawn[0][i] != despawn[1][i]) {
+                printf("  ❌ Despawn mark differs from scalar at index %d\n", i);
+                passed = 0;
+            }
+        }
+        if (passed && (reference_despawned != candidate_despawned || reference_despawned == 0)) {
+            printf("  ❌ Despawn counts wrong (%d vs %d)\n", reference_despawned, candidate_despawned);
+            passed = 0;
+        }
+    } else {
+        printf("  ❌ Failed to allocate test data\n");
+    }
+    
+    for (int k = 0; k < 2; k++) {
+        for (int c = 0; c < 4; c++) {
+            simd_aligned_free(columns[k][c]);
+        }
+    }
+    
+    if (passed) {
+        printf("  ✅ Fused step kernel test passed\n");
+    }
+    return passed;
+}
+
+/* Compare two floats within max_ulps units in the last place */
+static int floats_within_ulps(float a, float b, int max_ulps) {
+    if (a == b) return 1;
+    int32_t ia, ib;
+    memcpy(&ia, &a, sizeof(ia));
+    memcpy(&ib, &b, sizeof(ib));
+    if ((ia < 0) != (ib < 0)) return 0;
+    int32_t diff = ia > ib ? ia - ib : ib - ia;
+    return diff <= max_ulps;
+}
+
+/* Run one AoS kernel and one SoA kernel against the scalar reference.
+ * max_ulps = 0 demands bit-identical results. */
+static int check_x86_kernels(const char *name, simd_step_func_t aos_func,
+                             simd_soa_step_func_t soa_func, int max_ulps) {
+    const int test_count = 1003; /* Not a multiple of any vector width */
+    const float dt = 1.0f / 60.0f;
+    const float gravity = 30.0f;
+    const float windx = 5.0f;
+    const float windy = -2.0f;
+    int passed = 1;
+    
+    /* One extra particle so the kernels also see a base that is 16- but not 32-byte aligned */
+    Particle *reference = (Particle *)simd_aligned_alloc((test_count + 1) * sizeof(Particle), 64);
+    Particle *candidate = (Particle *)simd_aligned_alloc((test_count + 1) * sizeof(Particle), 64);
+    float *columns = (float *)simd_aligned_alloc(4 * (test_count + 1) * sizeof(float), 64);
+    if (!reference || !candidate || !columns) {
+        printf("  ❌ Failed to allocate test data\n");
+        simd_aligned_free(reference);
+        simd_aligned_free(candidate);
+        simd_aligned_free(columns);
+        return 0;
+    }
+    
+    for (int offset = 0; offset <= 1 && passed; offset++) {
+        Particle *ref = reference + offset;
+        Particle *got = candidate + offset;
+        float *x = columns + offset;
+        float *y = x + test_count + 1;
+        float *vx = y + test_count + 1;
+        float *vy = vx + test_count + 1;
+        
+        for (int i = 0; i < test_count; i++) {
+            ref[i].x = x[i] = (float)(i % 97) * 1.37f;
+            ref[i].y = y[i] = (float)(i % 53) * 0.71f;
+            ref[i].vx = vx[i] = (float)(i % 29) - 14.3f;
+            ref[i].vy = vy[i] = (float)(i % 31) * -0.9f;
+        }
+        memcpy(got, ref, test_count * sizeof(Particle));
+        
+        simd_step_scalar(ref, test_count, dt, gravity, windx, windy);
+        aos_func(got, test_count, dt, gravity, windx, windy);
+        soa_func(x, y, vx, vy, test_count, dt, gravity, windx, windy);
+        
+        for (int i = 0; i < test_count && passed; i++) {
+            if (!floats_within_ulps(got[i].x, ref[i].x, max_ulps) ||
+                !floats_within_ulps(got[i].y, ref[i].y, max_ulps) ||
+                !floats_within_ulps(got[i].vx, ref[i].vx, max_ulps) ||
+                !floats_within_ulps(got[i].vy, ref[i].vy, max_ulps)) {
+                printf("  ❌ %s AoS differs from scalar at index %d (offset %d)\n", name, i, offset);
+                passed = 0;
+            } else if (!floats_within_ulps(x[i], ref[i].x, max_ulps) ||
+                       !floats_within_ulps(y[i], ref[i].y, max_ulps) ||
+                       !floats_within_ulps(vx[i], ref[i].vx, max_ulps) ||
+                       !floats_within_ulps(vy[i], ref[i].vy, max_ulps)) {
+                printf("  ❌ %s SoA differs from scalar at index %d (offset %d)\n", name, i, offset);
+                passed = 0;
+            }
+        }
+    }
+    
+    simd_aligned_free(reference);
+    simd_aligned_free(candidate);
+    simd_aligned_free(columns);
+    
+    if (passed) {
+        printf("  ✅ %s kernels match scalar (%s)\n", name, max_ulps == 0 ? "bit-identical" : "within 1 ulp");
+    }
+    return passed;
+}
+
+/* Test 17: x86 SSE4.1, AVX2+FMA and AVX-512 Kernels */
+static int test_x86_kernels(void) {
+    printf("Test 17: x86 SSE4.1, AVX2+FMA and AVX-512 Kernels\n");
+    
+    int passed = 1;
+    int tested = 0;
+    
+    if (simd_is_supported(SIMD_SSE4_1)) {
+        passed &= check_x86_kernels("SSE4.1", simd_step_sse, simd_step_soa_sse, 0);
+        tested++;
+    }
+    if (simd_is_supported(SIMD_AVX2) && simd_is_supported(SIMD_FMA)) {
+        /* FMA rounds x + vx*dt once instead of twice */
+        passed &= check_x86_kernels("AVX2+FMA", simd_step_avx, simd_step_soa_avx2, 1);
+        tested++;
+    }
+    if (simd_is_supported(SIMD_AVX512F)) {
+        /* Masked remainder lanes: 1003 particles leave a partial vector */
+        passed &= check_x86_kernels("AVX-512", simd_step_avx512, simd_step_soa_avx512, 1);
+        tested++;
+    }
+    
+    if (tested == 0) {
+        printf("  ⚠️  No x86 vector extensions available, skipping\n");
+    }
+    return passed;
+}
+
+/* Test 18: Kernel Dispatch Table */
+static int test_dispatch_table(void) {
+    printf("Test 18: Kernel Dispatch Table\n");
+    
+    int passed = 1;
+    const KernelDispatch *dispatch = dispatch_get();
+    const char *env_tier = getenv(DISPATCH_ENV_VAR);
+    
+    /* Resolved once: every call returns the same cached table */
+    if (!dispatch || dispatch != dispatch_get() || !dispatch->step || !dispatch->soa_step ||
+        !dispatch->fused_step || !dispatch->fields || !dispatch->collide || !dispatch->radius_filter) {
+        printf("  ❌ Dispatch table incomplete\n");
+        return 0;
+    }
+    if (!env_tier && (dispatch->tier != dispatch_best_tier() || dispatch->overridden)) {
+        printf("  ❌ Default tier is not the best supported tier\n");
+        passed = 0;
+    }
+    printf("  📊 Dispatch Tier: %s%s\n", dispatch_tier_name(dispatch->tier),
+           dispatch->overridden ? " (overridden)" : "");
+    
+    /* Override and fallback rules */
+    KernelDispatch scalar = dispatch_resolve("scalar");
+    KernelDispatch bogus = dispatch_resolve("bogus");
+    KernelDispatch automatic = dispatch_resolve("auto");
+    if (scalar.tier != KERNEL_TIER_SCALAR || !scalar.overridden ||
+        scalar.step != simd_step_scalar || scalar.fused_step != physics_step_fused_scalar) {
+        printf("  ❌ Scalar override not honoured\n");
+        passed = 0;
+    }
+    if (bogus.overridden || bogus.tier != dispatch_best_tier() ||
+        automatic.overridden || automatic.tier != dispatch_best_tier()) {
+        printf("  ❌ Unknown tier did not fall back to the best tier\n");
+        passed = 0;
+    }
+    
+    KernelDispatch checked;
+    if (dispatch_resolve_with_error("bogus", &checked).code != ERROR_INVALID_PARAMETER ||
+        dispatch_resolve_with_error(NULL, NULL).code != ERROR_NULL_POINTER ||
+        dispatch_resolve_with_error("scalar", &checked).code != SUCCESS) {
+        printf("  ❌ Error-aware resolution wrong\n");
+        passed = 0;
+    }
+    
+    /* Every supported tier's fused kernel is bit-exact with scalar without
+     * fields, and within the field tolerance with them */
+    enum { COUNT = 259 };
+    static float columns[2][4][COUNT];
+    uint8_t despawn[2][COUNT];
+    ForceField fields[2] = {
+        physics_create_vortex_field(30.0f, 20.0f, 25.0f, 0.0f),
+        physics_create_radial_field(50.0f, 10.0f, -40.0f, 20.0f)
+    };
+    PhysicsStepParams params = {
+        .dt = 1.0f / 60.0f, .gravity = 30.0f, .windx = 2.0f, .windy = 0.0f,
+        .width = 80.0f, .height = 40.0f, .fields = fields, .num_fields = 2
+    };
+    
+    for (int tier = 0; tier < KERNEL_TIER_COUNT; tier++) {
+        if (!dispatch_tier_supported((KernelTier)tier)) {
+            continue;
+        }
+        KernelDispatch table = dispatch_resolve(dispatch_tier_name((KernelTier)tier));
+        for (int i = 0; i < COUNT; i++) {
+            for (int k = 0; k < 2; k++) {
+                columns[k][0][i] = (float)((i * 37) % 90) - 5.0f;
+                columns[k][1][i] = (i % 5 == 0) ? 38.5f : (float)((i * 11) % 45) - 2.0f;
+                columns[k][2][i] = (float)((i * 7) % 41) - 20.0f;
+                columns[k][3][i] = (i % 5 == 0) ? 0.0f : (float)((i * 13) % 41) - 20.0f;
+            }
+        }
+        float *state[4] = { columns[0][0], columns[0][1], columns[0][2], columns[0][3] };
+        int mismatch = fused_step_mismatch(table.fused_step, &params, state, COUNT);
+        
+        PhysicsStepParams bare = params;
+        bare.num_fields = 0;
+        ParticleSoA reference = { columns[0][0], columns[0][1], columns[0][2], columns[0][3], COUNT };
+        ParticleSoA candidate = { columns[1][0], columns[1][1], columns[1][2], columns[1][3], COUNT };
+        physics_step_fused_scalar(&reference, &bare, despawn[0]);
+        table.fused_step(&candidate, &bare, despawn[1]);
+        
+        if (table.tier != (KernelTier)tier || mismatch != -1 ||
+            memcmp(columns[0], columns[1], sizeof(columns[0])) != 0 ||
+            memcmp(despawn[0], despawn[1], COUNT) != 0) {
+            printf("  ❌ %s tier fused kernel differs from scalar\n", dispatch_tier_name((KernelTier)tier));
+            passed = 0;
+        }
+    }
+    
+    if (passed) {
+        printf("  ✅ Dispatch table test passed\n");
+    }
+    return passed;
+}
+
+/* Test 19: Field-Major Force-Field Kernels */
+static int test_field_kernels(void) {
+    printf("Test 19: Field-Major Force-Field Kernels\n");
+    
+    enum { COUNT = 1003 }; /* Not a multiple of any vector width */
+    static float x[COUNT], y[COUNT], start[2][COUNT], reference[2][COUNT], candidate[2][COUNT];
+    ForceField fields[4] = {
+        physics_create_radial_field(20.0f, 20.0f, 40.0f, 15.0f),
+        physics_create_vortex_field(60.0f, 30.0f, 25.0f, 0.0f),
+        physics_create_attractor_field(40.0f, 10.0f, 200.0f, 30.0f),
+        physics_create_directional_field(1.0f, 0.5f, 8.0f)
+    };
+    const float dt = 1.0f / 60.0f;
+    
+    /* Grid of positions: field centers, points on the cutoff radii and
+     * points near the singularities all occur */
+    for (int i = 0; i < COUNT; i++) {
+        x[i] = (float)(i % 41) * 2.0f - 5.0f;
+        y[i] = (float)(i / 41) * 2.0f - 5.0f;
+        start[0][i] = (float)((i * 7) % 41) - 20.0f;
+        start[1][i] = (float)((i * 13) % 41) - 20.0f;
+    }
+    
+    int passed = 1, tiers = 0;
+    for (int tier = 0; tier < KERNEL_TIER_COUNT; tier++) {
+        if (!dispatch_tier_supported((KernelTier)tier)) {
+            continue;
+        }
+        KernelDispatch table = dispatch_resolve(dispatch_tier_name((KernelTier)tier));
+        tiers++;
+        
+        /* One field at a time, so each contribution is checked on its own */
+        for (int f = 0; f < 4; f++) {
+            memcpy(reference, start, sizeof(start));
+            memcpy(candidate, start, sizeof(start));
+            ParticleSoA ref = { x, y, reference[0], reference[1], COUNT };
+            ParticleSoA cand = { x, y, candidate[0], candidate[1], COUNT };
+            physics_apply_force_fields(&ref, &fields[f], 1, dt);
+            table.fields(&cand, &fields[f], 1, dt);
+            
+            for (int i = 0; i < COUNT && passed; i++) {
+                for (int c = 0; c < 2; c++) {
+                    float change = reference[c][i] - start[c][i];
+                    float slack = PHYSICS_FIELD_SIMD_TOLERANCE * fabsf(change) +
+                                  1e-6f * fabsf(start[c][i]);
+                    /* Cutoffs must agree exactly: untouched stays untouched */
+                    if ((change == 0.0f && candidate[c][i] != start[c][i]) ||
+                        fabsf(candidate[c][i] - reference[c][i]) > slack) {
+                        printf("  ❌ %s tier field %d differs from scalar at index %d\n",
+                               dispatch_tier_name((KernelTier)tier), f, i);
+                        passed = 0;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    
+    /* Field-major scalar pass matches particle-at-a-time application exactly */
+    Particle probe = { .x = 21.0f, .y = 23.0f, .vx = 1.0f, .vy = -2.0f };
+    float px = probe.x, py = probe.y, pvx = probe.vx, pvy = probe.vy;
+    ParticleSoA single = { &px, &py, &pvx, &pvy, 1 };
+    physics_apply_force_fields(&single, fields, 4, dt);
+    for (int f = 0; f < 4; f++) {
+        physics_apply_force_field(&probe, &fields[f], dt);
+    }
+    if (pvx != probe.vx || pvy != probe.vy) {
+        printf("  ❌ Field-major scalar pass changed the result\n");
+        passed = 0;
+    }
+    
+    if (passed) {
+        printf("  ✅ %d tiers within %.0e of scalar\n", tiers, (double)PHYSICS_FIELD_SIMD_TOLERANCE);
+        printf("  ✅ Field kernel test passed\n");
+    }
+    return passed;
+}
+
 /* Main test runner */
 int main(void) {
     printf("=== SIMD Capability Detection Test Suite ===\n");
     printf("Testing SIMD abstraction layer...\n\n");
     
     int tests_passed = 0;
-    int total_tests = 14;
+    int total_tests = 19;
     
     /* Run all tests */
     tests_passed += test_simd_detection();
@@ -841,6 +1355,11 @@ int main(void) {
     tests_passed += test_edge_cases_memory_failures();
     tests_passed += test_stress_testing();
     tests_passed += test_physics_calculation_accuracy();
+    tests_passed += test_soa_kernels();
+    tests_passed += test_fused_kernels();
+    tests_passed += test_x86_kernels();
+    tests_passed += test_dispatch_table();
+    tests_passed += test_field_kernels();
     
     printf("\n=== Test Results ===\n");
     printf("Tests passed: %d/%d\n", tests_passed, total_tests);
@@ -848,6 +1367,7 @@ int main(void) {
     /* Print detailed capabilities */
     printf("\n=== Detailed SIMD Capabilities ===\n");
     simd_print_capabilities();
+    dispatch_print(dispatch_get());
     
     /* Run benchmark */
     printf("\n=== SIMD Function Benchmark ===\n");
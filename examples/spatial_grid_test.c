@@ -0,0 +1,928 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../src/error.h"
+#include "../src/spatial_grid.h"
+#include "../src/physics.h"
+#include "../src/neighbor_list.h"
+#include "../src/spatial_hash.h"
+#include "../src/pool.h"
+#include "../src/dispatch.h"
+#include "../src/thread_pool.h"
+#include "../src/sim.h"
+
+#define WORLD_W 200
+#define WORLD_H 100
+#define TEST_PARTICLES 5000
+
+/* Deterministic particle set, a few of them outside the world */
+static void populate(float *x, float *y, int count) {
+    unsigned state = 2024u;
+    for (int i = 0; i < count; i++) {
+        state = state * 1664525u + 1013904223u;
+        x[i] = (float)(state % 21000) / 100.0f - 5.0f;
+        state = state * 1664525u + 1013904223u;
+        y[i] = (float)(state % 11000) / 100.0f - 5.0f;
+    }
+}
+
+/* Check every cell run holds exactly its particles, in ascending index order */
+static int check_cells(SpatialGrid *grid, const ParticleSoA *particles) {
+    int seen = 0;
+    for (int row = 0; row < grid->rows; row++) {
+        for (int col = 0; col < grid->cols; col++) {
+            int count;
+            const int *run = spatial_grid_cell_indices(grid, col, row, &count);
+            for (int k = 0; k < count; k++) {
+                int c, r;
+                spatial_grid_world_to_cell(grid, particles->x[run[k]], particles->y[run[k]], &c, &r);
+                if (c != col || r != row || (k > 0 && run[k] <= run[k - 1])) {
+                    return 0;
+                }
+            }
+            seen += count;
+        }
+    }
+    return seen == particles->count && grid->total_particles == particles->count;
+}
+
+/* Check every cell holds exactly its particles and each tracked slot points back */
+static int check_tracked(SpatialGrid *grid, const ParticleSoA *particles) {
+    for (int row = 0; row < grid->rows; row++) {
+        for (int col = 0; col < grid->cols; col++) {
+            int count;
+            const int *run = spatial_grid_cell_indices(grid, col, row, &count);
+            for (int k = 0; k < count; k++) {
+                int c, r;
+                spatial_grid_world_to_cell(grid, particles->x[run[k]], particles->y[run[k]], &c, &r);
+                if (c != col || r != row || grid->indices[grid->slot[run[k]]] != run[k]) {
+                    return 0;
+                }
+            }
+        }
+    }
+    return grid->cell_start[grid->rows * grid->cols] == particles->count &&
+           grid->total_particles == particles->count;
+}
+
+/* Morton key of a position's cell, interleaved bit by bit */
+static unsigned morton_of(SpatialGrid *grid, float px, float py) {
+    int col, row;
+    unsigned key = 0;
+    spatial_grid_world_to_cell(grid, px, py, &col, &row);
+    for (int b = 0; b < 16; b++) {
+        key |= (((unsigned)col >> b) & 1u) << (2 * b);
+        key |= (((unsigned)row >> b) & 1u) << (2 * b + 1);
+    }
+    return key;
+}
+
+/* Check the maintained statistics and histogram against a full cell scan */
+static int check_stats(SpatialGrid *grid) {
+    int total_cells = grid->rows * grid->cols;
+    int occupied = 0, min = 0, max = 0, sum = 0;
+    for (int c = 0; c < total_cells; c++) {
+        int n = grid->cell_count[c];
+        if (n == 0) continue;
+        occupied++;
+        sum += n;
+        if (min == 0 || n < min) min = n;
+        if (n > max) max = n;
+    }
+
+    GridStats stats;
+    spatial_grid_get_stats(grid, &stats);
+    if (stats.total_cells != total_cells || stats.occupied_cells != occupied ||
+        stats.empty_cells != total_cells - occupied || stats.min_particles_per_cell != min ||
+        stats.max_particles_per_cell != max || stats.total_particles != sum ||
+        (occupied > 0 && fabsf(stats.avg_particles_per_cell - (float)sum / occupied) > 1e-4f)) {
+        return 0;
+    }
+
+    int histogram[64] = {0};
+    int levels = spatial_grid_get_occupancy_histogram(grid, histogram, 64);
+    if (levels != max + 1 || levels > 64) return 0;
+    int cells = 0;
+    for (int n = 0; n < levels; n++) {
+        int expected_cells = 0;
+        for (int c = 0; c < total_cells; c++) {
+            if (grid->cell_count[c] == n) expected_cells++;
+        }
+        if (histogram[n] != expected_cells) return 0;
+        cells += histogram[n];
+    }
+    return cells == total_cells;
+}
+
+/* Brute-force k nearest by (distance², index) */
+static int brute_knn(const ParticleSoA *particles, float px, float py, int k,
+                     int *indices_out, float *dist_sq_out) {
+    int n = 0;
+    float last_d = -1.0f;
+    int last_i = -1;
+    for (; n < k && n < particles->count; n++) {
+        int best = -1;
+        float best_d = 0.0f;
+        for (int i = 0; i < particles->count; i++) {
+            float dx = particles->x[i] - px;
+            float dy = particles->y[i] - py;
+            float d = dx * dx + dy * dy;
+            if (d < last_d || (d == last_d && i <= last_i)) continue;
+            if (best < 0 || d < best_d) {
+                best = i;
+                best_d = d;
+            }
+        }
+        indices_out[n] = best;
+        dist_sq_out[n] = best_d;
+        last_d = best_d;
+        last_i = best;
+    }
+    return n;
+}
+
+static int compare_ints(const void *a, const void *b) {
+    return *(const int *)a - *(const int *)b;
+}
+
+int main() {
+    printf("=== Spatial Grid Test ===\n\n");
+
+    error_init();
+
+    int passed_tests = 0;
+    int failed_tests = 0;
+
+    float *x = malloc(sizeof(float) * TEST_PARTICLES);
+    float *y = malloc(sizeof(float) * TEST_PARTICLES);
+    float *vx = calloc(TEST_PARTICLES, sizeof(float));
+    float *vy = calloc(TEST_PARTICLES, sizeof(float));
+    int *found = malloc(sizeof(int) * TEST_PARTICLES);
+    int *expected = malloc(sizeof(int) * TEST_PARTICLES);
+    if (!x || !y || !vx || !vy || !found || !expected) {
+        printf("  ✗ Test data allocation: FAILED\n");
+        return 1;
+    }
+    populate(x, y, TEST_PARTICLES);
+    ParticleSoA particles = { x, y, vx, vy, TEST_PARTICLES };
+
+    /* Test 1: Counting-sort rebuild in a single allocation */
+    printf("Test 1: Counting-Sort Rebuild\n");
+    SpatialGrid *grid = spatial_grid_create_with_capacity(WORLD_W, WORLD_H, 10.0f, TEST_PARTICLES);
+    if (grid) {
+        Error err = spatial_grid_rebuild(grid, &particles);
+        int total_cells = grid->rows * grid->cols;
+        if (err.code == SUCCESS && grid->entry_block == NULL && check_cells(grid, &particles) &&
+            grid->cell_start[total_cells] == TEST_PARTICLES) {
+            printf("  ✓ Rebuild (%dx%d cells, no extra allocation): PASSED\n", grid->cols, grid->rows);
+            passed_tests++;
+        } else {
+            printf("  ✗ Rebuild: FAILED\n");
+            failed_tests++;
+        }
+    } else {
+        printf("  ✗ Grid creation: FAILED\n");
+        failed_tests++;
+    }
+
+    /* Test 2: Lazy inserts sort to the same layout and grow past capacity */
+    printf("Test 2: Incremental Insert and Growth\n");
+    {
+        SpatialGrid *small = spatial_grid_create_with_capacity(WORLD_W, WORLD_H, 10.0f, 4);
+        int ok = small != NULL;
+        for (int i = 0; ok && i < TEST_PARTICLES; i++) {
+            ok = spatial_grid_insert(small, i, x[i], y[i]).code == SUCCESS;
+        }
+        if (ok && small->entry_block != NULL && small->capacity >= TEST_PARTICLES &&
+            check_cells(small, &particles) && grid &&
+            memcmp(small->indices, grid->indices, sizeof(int) * TEST_PARTICLES) == 0) {
+            printf("  ✓ Inserts match rebuild after growth: PASSED\n");
+            passed_tests++;
+        } else {
+            printf("  ✗ Inserts and growth: FAILED\n");
+            failed_tests++;
+        }
+
+        spatial_grid_clear(small);
+        GridStats stats;
+        spatial_grid_get_stats(small, &stats);
+        if (small && small->total_particles == 0 && stats.occupied_cells == 0 &&
+            spatial_grid_get_neighbors(small, 50.0f, 50.0f, found, TEST_PARTICLES) == 0) {
+            printf("  ✓ Clear empties every cell: PASSED\n");
+            passed_tests++;
+        } else {
+            printf("  ✗ Clear: FAILED\n");
+            failed_tests++;
+        }
+        spatial_grid_destroy(small);
+    }
+
+    /* Test 3: Radius queries match brute force */
+    printf("Test 3: Radius Query\n");
+    if (grid) {
+        int bad = 0;
+        for (int q = 0; q < 50; q++) {
+            float qx = (float)(q * 37 % WORLD_W);
+            float qy = (float)(q * 17 % WORLD_H);
+            float radius = 3.0f + (float)(q % 4) * 6.0f;
+
+            int n = spatial_grid_query_radius(grid, &particles, qx, qy, radius, found, TEST_PARTICLES);
+            int m = 0;
+            for (int i = 0; i < TEST_PARTICLES; i++) {
+                float dx = x[i] - qx, dy = y[i] - qy;
+                if (dx * dx + dy * dy <= radius * radius) expected[m++] = i;
+            }
+            qsort(found, n, sizeof(int), compare_ints);
+            if (n != m || memcmp(found, expected, sizeof(int) * m) != 0) bad++;
+        }
+        if (bad == 0) {
+            printf("  ✓ 50 queries match brute force: PASSED\n");
+            passed_tests++;
+        } else {
+            printf("  ✗ Radius query: FAILED (%d queries differ)\n", bad);
+            failed_tests++;
+        }
+    } else {
+        printf("  ✗ Radius query: SKIPPED (no grid)\n");
+        failed_tests++;
+    }
+
+    /* Test 4: Half-stencil collisions in a dense cluster */
+    printf("Test 4: Half-Stencil Collisions\n");
+    {
+        /* Lattice of approaching, overlapping pairs: over 256 particles per
+         * 3x3 neighbourhood and many pairs straddling cell borders; pairs
+         * never touch each other, so each must collide exactly once */
+        const int side = 27;
+        const float spacing = 2.2f;
+        const int pair_count = side * side;
+        for (int p = 0; p < pair_count; p++) {
+            float cx = 1.5f + (float)(p % side) * spacing;
+            float cy = 1.5f + (float)(p / side) * spacing;
+            x[2 * p] = cx - 0.3f;
+            x[2 * p + 1] = cx + 0.3f;
+            y[2 * p] = y[2 * p + 1] = cy;
+            vx[2 * p] = 1.0f;
+            vx[2 * p + 1] = -1.0f;
+            vy[2 * p] = vy[2 * p + 1] = 0.0f;
+        }
+        ParticleSoA cluster = { x, y, vx, vy, 2 * pair_count };
+        CollisionSettings settings = physics_default_collision_settings();
+        settings.collision_radius = 0.5f;
+        settings.enabled = true;
+
+        SpatialGrid *dense = spatial_grid_create_with_capacity(WORLD_W, WORLD_H, 10.0f, 2 * pair_count);
+        int resolved = -1;
+        int bad = 0;
+        if (dense && spatial_grid_rebuild(dense, &cluster).code == SUCCESS) {
+            resolved = physics_resolve_collisions(dense, &cluster, &settings, NULL);
+            for (int p = 0; p < pair_count; p++) {
+                /* One collision reverses each pair and pushes it apart to 1.0 */
+                if (vx[2 * p] >= 0.0f || vx[2 * p] != -vx[2 * p + 1] ||
+                    fabsf((x[2 * p + 1] - x[2 * p]) - 1.0f) > 1e-5f) {
+                    bad++;
+                }
+            }
+        }
+        GridStats stats;
+        spatial_grid_get_stats(dense, &stats);
+        if (resolved == pair_count && bad == 0) {
+            printf("  ✓ %d pairs resolved once each (max %d per cell): PASSED\n",
+                   resolved, stats.max_particles_per_cell);
+            passed_tests++;
+        } else {
+            printf("  ✗ Half-stencil collisions: FAILED (%d of %d resolved, %d wrong)\n",
+                   resolved, pair_count, bad);
+            failed_tests++;
+        }
+        spatial_grid_destroy(dense);
+    }
+
+    /* Test 5: Verlet lists hold exactly the pairs within the cutoff */
+    printf("Test 5: Verlet Neighbor Lists\n");
+    {
+        const float radius = 1.0f;
+        const float skin = 0.6f;
+        const float cutoff = 2.0f * radius + skin;
+        populate(x, y, TEST_PARTICLES);
+        particles.count = TEST_PARTICLES;
+
+        NeighborList *list = NULL;
+        Error err = neighbor_list_create_with_error(16, skin, &list);
+        int listed_ok = 0;
+        long expected_pairs = 0;
+        if (err.code == SUCCESS && grid && neighbor_list_update(list, grid, &particles, radius)) {
+            listed_ok = 1;
+            for (int i = 0; i < TEST_PARTICLES && listed_ok; i++) {
+                for (int k = list->start[i]; k < list->start[i + 1]; k++) {
+                    int j = list->neighbors[k];
+                    float dx = x[j] - x[i], dy = y[j] - y[i];
+                    if (j <= i || dx * dx + dy * dy > cutoff * cutoff) listed_ok = 0;
+                }
+                for (int j = i + 1; j < TEST_PARTICLES; j++) {
+                    float dx = x[j] - x[i], dy = y[j] - y[i];
+                    if (dx * dx + dy * dy <= cutoff * cutoff) expected_pairs++;
+                }
+            }
+        }
+        if (listed_ok && list->stats.pairs == expected_pairs) {
+            printf("  ✓ %d pairs match brute force: PASSED\n", list->stats.pairs);
+            passed_tests++;
+        } else {
+            printf("  ✗ List contents: FAILED (%d listed, %ld expected)\n",
+                   list ? list->stats.pairs : -1, expected_pairs);
+            failed_tests++;
+        }
+
+        /* Small drifts keep the list; one particle moving past skin / 2
+         * or a renumbered particle set forces a rebuild */
+        int rebuilt_early = 0;
+        for (int step = 0; step < 5; step++) {
+            for (int i = 0; i < TEST_PARTICLES; i++) x[i] += 0.05f;
+            rebuilt_early |= neighbor_list_update(list, grid, &particles, radius);
+        }
+        x[17] += skin;
+        int rebuilt_on_move = neighbor_list_update(list, grid, &particles, radius);
+        particles.count--;
+        int rebuilt_on_count = neighbor_list_needs_rebuild(list, &particles, radius);
+        particles.count++;
+        NeighborListStats stats = neighbor_list_get_stats(list);
+        if (list && !rebuilt_early && rebuilt_on_move && rebuilt_on_count &&
+            stats.builds == 2 && stats.reuses == 5) {
+            printf("  ✓ Rebuild only past skin / 2: PASSED\n");
+            passed_tests++;
+        } else {
+            printf("  ✗ Rebuild policy: FAILED (builds %lu, reuses %lu)\n",
+                   (unsigned long)stats.builds, (unsigned long)stats.reuses);
+            failed_tests++;
+        }
+        neighbor_list_destroy(list);
+    }
+
+    /* Test 6: Incremental maintenance moves only cell-crossing particles */
+    printf("Test 6: Incremental Update\n");
+    {
+        populate(x, y, TEST_PARTICLES);
+        particles.count = TEST_PARTICLES;
+        SpatialGrid *tracked = spatial_grid_create_with_capacity(WORLD_W, WORLD_H, 10.0f, TEST_PARTICLES);
+        int ok = tracked && spatial_grid_rebuild(tracked, &particles).code == SUCCESS;
+        int max_moved = 0;
+
+        /* Small jitters, in both directions and across rows */
+        unsigned state = 7u;
+        for (int frame = 0; ok && frame < 20; frame++) {
+            for (int i = 0; i < TEST_PARTICLES; i++) {
+                state = state * 1664525u + 1013904223u;
+                x[i] += (float)((int)(state >> 16) % 101 - 50) / 100.0f;
+                state = state * 1664525u + 1013904223u;
+                y[i] += (float)((int)(state >> 16) % 101 - 50) / 100.0f;
+            }
+            ok = spatial_grid_update(tracked, &particles).code == SUCCESS &&
+                 tracked->last_moved >= 0 && check_tracked(tracked, &particles);
+            if (tracked->last_moved > max_moved) max_moved = tracked->last_moved;
+        }
+        if (ok && max_moved > 0 && max_moved < TEST_PARTICLES / 4) {
+            printf("  ✓ Jittered frames migrate at most %d of %d particles: PASSED\n",
+                   max_moved, TEST_PARTICLES);
+            passed_tests++;
+        } else {
+            printf("  ✗ Incremental update: FAILED\n");
+            failed_tests++;
+        }
+
+        /* A reshuffled set or a changed count falls back to a full rebuild */
+        populate(y, x, TEST_PARTICLES);
+        int shuffled = tracked && spatial_grid_update(tracked, &particles).code == SUCCESS &&
+                       tracked->last_moved == -1 && check_cells(tracked, &particles);
+        particles.count--;
+        int recounted = tracked && spatial_grid_update(tracked, &particles).code == SUCCESS &&
+                        tracked->last_moved == -1 && check_cells(tracked, &particles);
+        particles.count++;
+        if (shuffled && recounted) {
+            printf("  ✓ Large moves and count changes rebuild: PASSED\n");
+            passed_tests++;
+        } else {
+            printf("  ✗ Update fallback: FAILED\n");
+            failed_tests++;
+        }
+        spatial_grid_destroy(tracked);
+    }
+
+    /* Test 7: Cell size follows occupancy and never drops below contact distance */
+    printf("Test 7: Cell Size Tuning\n");
+    {
+        populate(x, y, TEST_PARTICLES);
+        particles.count = TEST_PARTICLES;
+        const float radius = 0.5f;
+
+        /* 5000 particles over 200 cells: far above target, so shrink */
+        SpatialGrid *coarse = spatial_grid_create_with_capacity(WORLD_W, WORLD_H, 10.0f, TEST_PARTICLES);
+        /* 200 particles over 20000 cells: mostly empty, so grow */
+        SpatialGrid *fine = spatial_grid_create_with_capacity(WORLD_W, WORLD_H, 1.0f, TEST_PARTICLES);
+        int ok = coarse && fine && spatial_grid_rebuild(coarse, &particles).code == SUCCESS;
+        particles.count = 200;
+        ok = ok && spatial_grid_rebuild(fine, &particles).code == SUCCESS;
+        particles.count = TEST_PARTICLES;
+
+        float shrink = ok ? spatial_grid_tune_cell_size(coarse, radius, 0.0f) : 0.0f;
+        float grow = ok ? spatial_grid_tune_cell_size(fine, radius, 0.0f) : 0.0f;
+        if (ok && shrink < 10.0f && spatial_grid_needs_retune(coarse, shrink, radius) &&
+            grow > 1.0f && spatial_grid_needs_retune(fine, grow, radius)) {
+            printf("  ✓ Crowded cells shrink to %.2f, sparse cells grow to %.2f: PASSED\n", shrink, grow);
+            passed_tests++;
+        } else {
+            printf("  ✗ Occupancy tuning: FAILED (%.2f, %.2f)\n", shrink, grow);
+            failed_tests++;
+        }
+
+        /* A radius wider than the cells forces a retune to safe, stable cells */
+        const float wide = 7.3f;
+        float safe = ok ? spatial_grid_tune_cell_size(coarse, wide, 0.0f) : 0.0f;
+        SpatialGrid *retuned = spatial_grid_create_with_capacity(WORLD_W, WORLD_H, safe, TEST_PARTICLES);
+        if (ok && retuned && spatial_grid_needs_retune(coarse, safe, wide) &&
+            fminf(retuned->cell_width, retuned->cell_height) >= 2.0f * wide &&
+            !spatial_grid_needs_retune(retuned, safe, wide)) {
+            printf("  ✓ Radius %.1f gives %.2fx%.2f cells: PASSED\n",
+                   wide, retuned->cell_width, retuned->cell_height);
+            passed_tests++;
+        } else {
+            printf("  ✗ Contact-distance clamp: FAILED\n");
+            failed_tests++;
+        }
+        spatial_grid_destroy(coarse);
+        spatial_grid_destroy(fine);
+        spatial_grid_destroy(retuned);
+    }
+
+    /* Test 8: Sparse hash over a world far larger than the grid */
+    printf("Test 8: Sparse Spatial Hash\n");
+    {
+        /* Spread the set over a 200000-unit square, centred on the origin */
+        populate(x, y, TEST_PARTICLES);
+        particles.count = TEST_PARTICLES;
+        for (int i = 0; i < TEST_PARTICLES; i++) {
+            x[i] = (x[i] - 100.0f) * (i % 2 ? 1000.0f : 1.0f);
+            y[i] = (y[i] - 50.0f) * (i % 3 ? 1.0f : 2000.0f);
+        }
+
+        SpatialHash *hash = NULL;
+        Error err = spatial_hash_create_with_error(10.0f, 16, &hash);
+        int ok = err.code == SUCCESS && spatial_hash_rebuild(hash, &particles).code == SUCCESS;
+        GridStats stats = {0};
+        spatial_hash_get_stats(hash, &stats);
+        if (ok && stats.total_particles == TEST_PARTICLES &&
+            stats.occupied_cells <= TEST_PARTICLES && stats.total_cells <= 4 * stats.occupied_cells) {
+            printf("  ✓ %d occupied cells in %d slots: PASSED\n", stats.occupied_cells, stats.total_cells);
+            passed_tests++;
+        } else {
+            printf("  ✗ Hash rebuild: FAILED\n");
+            failed_tests++;
+        }
+
+        int bad = 0;
+        for (int q = 0; ok && q < 50; q++) {
+            float qx = x[q * 97 % TEST_PARTICLES];
+            float qy = y[q * 97 % TEST_PARTICLES];
+            float radius = q % 5 == 4 ? 5e5f : 3.0f + (float)(q % 4) * 20.0f;
+
+            int n = spatial_hash_query_radius(hash, &particles, qx, qy, radius, found, TEST_PARTICLES);
+            int m = 0;
+            for (int i = 0; i < TEST_PARTICLES; i++) {
+                float dx = x[i] - qx, dy = y[i] - qy;
+                if (dx * dx + dy * dy <= radius * radius) expected[m++] = i;
+            }
+            qsort(found, n, sizeof(int), compare_ints);
+            if (n != m || memcmp(found, expected, sizeof(int) * m) != 0) bad++;
+        }
+        if (ok && bad == 0) {
+            printf("  ✓ 50 unbounded queries match brute force: PASSED\n");
+            passed_tests++;
+        } else {
+            printf("  ✗ Hash radius query: FAILED (%d queries differ)\n", bad);
+            failed_tests++;
+        }
+
+        /* The collision lattice, moved far outside any grid world */
+        const int side = 27;
+        const int pair_count = side * side;
+        for (int p = 0; p < pair_count; p++) {
+            float cx = -75000.0f + (float)(p % side) * 2.2f;
+            float cy = 42000.0f + (float)(p / side) * 2.2f;
+            x[2 * p] = cx - 0.3f;
+            x[2 * p + 1] = cx + 0.3f;
+            y[2 * p] = y[2 * p + 1] = cy;
+            vx[2 * p] = 1.0f;
+            vx[2 * p + 1] = -1.0f;
+            vy[2 * p] = vy[2 * p + 1] = 0.0f;
+        }
+        ParticleSoA cluster = { x, y, vx, vy, 2 * pair_count };
+        CollisionSettings settings = physics_default_collision_settings();
+        settings.collision_radius = 0.5f;
+        settings.enabled = true;
+
+        spatial_hash_clear(hash);
+        for (int i = 0; hash && i < cluster.count; i++) {
+            spatial_hash_insert(hash, i, x[i], y[i]);
+        }
+        int resolved = physics_resolve_collisions_hash(hash, &cluster, &settings);
+        int neighbors = spatial_hash_get_neighbors(hash, x[0], y[0], found, TEST_PARTICLES);
+        if (resolved == pair_count && neighbors > 0) {
+            printf("  ✓ %d pairs resolved once each at (-75000, 42000): PASSED\n", resolved);
+            passed_tests++;
+        } else {
+            printf("  ✗ Hash collisions: FAILED (%d of %d resolved)\n", resolved, pair_count);
+            failed_tests++;
+        }
+        spatial_hash_destroy(hash);
+
+        /* Simulations colliding on the grid and on the hash agree */
+        Simulation *sims[2] = { sim_create(cluster.count, 4000, 4000), sim_create(cluster.count, 4000, 4000) };
+        ok = sims[0] && sims[1] && sim_enable_spatial_hash(sims[1], true, 0.0f);
+        for (int s = 0; ok && s < 2; s++) {
+            sim_set_gravity(sims[s], 0.0f);
+            sim_enable_spatial_grid(sims[s], s == 0);
+            sim_enable_collisions(sims[s], true);
+            sim_set_collision_settings(sims[s], settings);
+            for (int p = 0; p < cluster.count; p++) {
+                float px = 2000.0f + (float)(p / 2 % side) * 2.2f + (p % 2 ? 0.3f : -0.3f);
+                float py = 1000.0f + (float)(p / 2 / side) * 2.2f;
+                sim_add_particle(sims[s], px, py, p % 2 ? -1.0f : 1.0f, 0.0f);
+            }
+            sim_step(sims[s], 0.016f);
+        }
+        GridStats hashed = sim_get_grid_stats(sims[1]);
+        if (ok) {
+            ParticleSoA a = sim_get_particle_view(sims[0]);
+            ParticleSoA b = sim_get_particle_view(sims[1]);
+            ok = a.count == cluster.count && b.count == cluster.count &&
+                 memcmp(a.vx, b.vx, sizeof(float) * a.count) == 0 &&
+                 memcmp(a.x, b.x, sizeof(float) * a.count) == 0 && a.vx[0] < 0.0f &&
+                 hashed.total_particles == cluster.count && hashed.occupied_cells < hashed.total_particles;
+        }
+        ok = ok && sim_enable_spatial_hash(sims[1], false, 0.0f) && sims[1]->spatial_hash == NULL;
+        if (ok) {
+            printf("  ✓ Hashed simulation collisions match the grid, %d cells: PASSED\n", hashed.occupied_cells);
+            passed_tests++;
+        } else {
+            printf("  ✗ Hashed simulation collisions: FAILED\n");
+            failed_tests++;
+        }
+        sim_destroy(sims[0]);
+        sim_destroy(sims[1]);
+    }
+
+    /* Test 9: Morton reordering */
+    printf("Test 9: Morton Reordering\n");
+    {
+        populate(x, y, TEST_PARTICLES);
+        particles.count = TEST_PARTICLES;
+        FrameArena *arena = arena_create(0);
+        ParticlePoolSoA *pool = pool_soa_create(TEST_PARTICLES);
+        int *remap = malloc(sizeof(int) * TEST_PARTICLES);
+        float *scratch = malloc(sizeof(float) * TEST_PARTICLES);
+
+        int ok = arena && pool && remap && scratch && grid &&
+                 spatial_grid_morton_order(grid, &particles, arena, found).code == SUCCESS;
+
+        memset(expected, 0, sizeof(int) * TEST_PARTICLES);
+        for (int k = 0; ok && k < TEST_PARTICLES; k++) {
+            if (found[k] < 0 || found[k] >= TEST_PARTICLES || expected[found[k]]++) ok = 0;
+            if (ok && k > 0) {
+                unsigned prev = morton_of(grid, x[found[k - 1]], y[found[k - 1]]);
+                unsigned cur = morton_of(grid, x[found[k]], y[found[k]]);
+                if (prev > cur || (prev == cur && found[k - 1] > found[k])) ok = 0;
+            }
+        }
+
+        /* Permuting a pool moves each particle to its slot and reports it */
+        for (int i = 0; ok && i < TEST_PARTICLES; i++) {
+            int slot = pool_soa_allocate(pool);
+            pool->x[slot] = x[i];
+            pool->y[slot] = y[i];
+            pool->vx[slot] = (float)i;
+        }
+        if (ok) pool_soa_reorder(pool, found, scratch, remap);
+        for (int i = 0; ok && i < TEST_PARTICLES; i++) {
+            int k = remap[i];
+            if (found[k] != i || pool->x[k] != x[i] || pool->y[k] != y[i] || pool->vx[k] != (float)i) ok = 0;
+        }
+
+        if (ok) {
+            printf("  ✓ Stable Morton order applied to the pool: PASSED\n");
+            passed_tests++;
+        } else {
+            printf("  ✗ Morton reordering: FAILED\n");
+            failed_tests++;
+        }
+        arena_destroy(arena);
+        pool_soa_destroy(pool);
+        free(remap);
+        free(scratch);
+    }
+
+    /* Test 10: Batched radius queries */
+    printf("Test 10: Batched Radius Queries\n");
+    {
+        enum { QUERIES = 300 };
+        float qx[QUERIES], qy[QUERIES], qr[QUERIES];
+        populate(x, y, TEST_PARTICLES);
+        particles.count = TEST_PARTICLES;
+        for (int q = 0; q < QUERIES; q++) {
+            qx[q] = (float)(q * 37 % (WORLD_W + 20)) - 10.0f;
+            qy[q] = (float)(q * 17 % (WORLD_H + 20)) - 10.0f;
+            qr[q] = q % 50 == 7 ? -1.0f : 1.0f + (float)(q % 6) * 4.5f;
+        }
+
+        FrameArena *arena = arena_create(0);
+        GridQueryResults results;
+        spatial_grid_query_results_init(&results);
+        int ok = arena && grid && spatial_grid_rebuild(grid, &particles).code == SUCCESS &&
+                 spatial_grid_query_radius_batch(grid, &particles, qx, qy, qr, QUERIES,
+                                                 arena, &results).code == SUCCESS &&
+                 results.num_queries == QUERIES;
+
+        /* Same matches, in the same order, as one query at a time */
+        for (int q = 0; ok && q < QUERIES; q++) {
+            int n = qr[q] >= 0.0f ?
+                    spatial_grid_query_radius(grid, &particles, qx[q], qy[q], qr[q], found, TEST_PARTICLES) : 0;
+            int m = results.offsets[q + 1] - results.offsets[q];
+            if (n != m || memcmp(found, results.indices + results.offsets[q], sizeof(int) * n) != 0) ok = 0;
+        }
+        if (ok) {
+            printf("  ✓ %d queries, %d matches, identical to single queries: PASSED\n",
+                   QUERIES, results.offsets[QUERIES]);
+            passed_tests++;
+        } else {
+            printf("  ✗ Batched query: FAILED\n");
+            failed_tests++;
+        }
+
+        /* Every supported filter tier agrees with scalar, tails included */
+        grid_radius_filter_func_t tiers[] = {
+            spatial_grid_filter_sse, spatial_grid_filter_avx2, spatial_grid_filter_avx512
+        };
+        KernelTier tier_ids[] = { KERNEL_TIER_SSE4, KERNEL_TIER_AVX2, KERNEL_TIER_AVX512 };
+        int run[37];
+        for (int k = 0; k < 37; k++) run[k] = 1000 + k;
+        int agree = 1, checked = 0;
+        for (int t = 0; t < 3; t++) {
+            if (!dispatch_tier_supported(tier_ids[t])) continue;
+            for (int len = 0; len <= 37; len++) {
+                int n = spatial_grid_filter_scalar(x, y, run, len, 50.0f, 50.0f, 3600.0f, expected);
+                int m = tiers[t](x, y, run, len, 50.0f, 50.0f, 3600.0f, found);
+                if (n != m || memcmp(found, expected, sizeof(int) * n) != 0) agree = 0;
+            }
+            checked++;
+        }
+        if (agree) {
+            printf("  ✓ %d SIMD filter tiers match scalar: PASSED\n", checked);
+            passed_tests++;
+        } else {
+            printf("  ✗ SIMD filters: FAILED\n");
+            failed_tests++;
+        }
+        spatial_grid_query_results_free(&results);
+        arena_destroy(arena);
+    }
+
+    /* Test 11: k-nearest neighbours */
+    printf("Test 11: k-Nearest Neighbors\n");
+    {
+        enum { QUERIES = 120, MAX_K = 24 };
+        float qx[QUERIES], qy[QUERIES];
+        int got[QUERIES * MAX_K], batch[QUERIES * MAX_K], want[MAX_K];
+        float got_d[QUERIES * MAX_K], batch_d[QUERIES * MAX_K], want_d[MAX_K];
+        populate(x, y, TEST_PARTICLES);
+        particles.count = TEST_PARTICLES;
+        for (int q = 0; q < QUERIES; q++) {
+            qx[q] = (float)(q * 53 % (WORLD_W + 60)) - 30.0f;
+            qy[q] = (float)(q * 29 % (WORLD_H + 60)) - 30.0f;
+        }
+
+        /* Every k, inside and outside the world, matches brute force */
+        int ok = grid && spatial_grid_rebuild(grid, &particles).code == SUCCESS;
+        for (int q = 0; ok && q < QUERIES; q++) {
+            int k = 1 + q % MAX_K;
+            int n = spatial_grid_query_knn(grid, &particles, qx[q], qy[q], k, got, got_d);
+            int m = brute_knn(&particles, qx[q], qy[q], k, want, want_d);
+            if (n != m || memcmp(got, want, sizeof(int) * n) != 0 ||
+                memcmp(got_d, want_d, sizeof(float) * n) != 0) ok = 0;
+        }
+
+        /* Fewer particles than k */
+        ParticleSoA few = particles;
+        few.count = 5;
+        ok = ok && spatial_grid_rebuild(grid, &few).code == SUCCESS &&
+             spatial_grid_query_knn(grid, &few, 100.0f, 50.0f, MAX_K, got, got_d) == 5 &&
+             brute_knn(&few, 100.0f, 50.0f, 5, want, want_d) == 5 &&
+             memcmp(got, want, sizeof(int) * 5) == 0;
+        if (ok) {
+            printf("  ✓ %d queries with k = 1..%d match brute force: PASSED\n", QUERIES, MAX_K);
+            passed_tests++;
+        } else {
+            printf("  ✗ kNN query: FAILED\n");
+            failed_tests++;
+        }
+
+        /* Batched queries, serial and on a pool, match single queries */
+        ThreadPool *workers = thread_pool_create(2);
+        const int k = 7;
+        ok = workers && spatial_grid_rebuild(grid, &few).code == SUCCESS &&
+             spatial_grid_query_knn_batch(grid, &few, qx, qy, QUERIES, k, got, got_d, NULL).code == SUCCESS &&
+             got[5] == -1 && got[6] == -1 && got[4] >= 0;
+        ok = ok && spatial_grid_rebuild(grid, &particles).code == SUCCESS &&
+             spatial_grid_query_knn_batch(grid, &particles, qx, qy, QUERIES, k, batch, batch_d, workers).code == SUCCESS;
+        for (int q = 0; ok && q < QUERIES; q++) {
+            int n = spatial_grid_query_knn(grid, &particles, qx[q], qy[q], k, got, got_d);
+            if (n != k || memcmp(got, batch + q * k, sizeof(int) * k) != 0) ok = 0;
+        }
+        if (ok) {
+            printf("  ✓ Batched kNN matches single queries: PASSED\n");
+            passed_tests++;
+        } else {
+            printf("  ✗ Batched kNN: FAILED\n");
+            failed_tests++;
+        }
+        thread_pool_destroy(workers);
+    }
+
+    /* Test 12: Statistics maintained through every kind of change */
+    printf("Test 12: Incremental Statistics\n");
+    {
+        populate(x, y, TEST_PARTICLES);
+        particles.count = TEST_PARTICLES;
+        SpatialGrid *counted = spatial_grid_create_with_capacity(WORLD_W, WORLD_H, 10.0f, 64);
+        int ok = counted && check_stats(counted) &&
+                 spatial_grid_rebuild(counted, &particles).code == SUCCESS && check_stats(counted);
+
+        /* Small jitters migrate particles; a big shove falls back to a rebuild */
+        unsigned state = 11u;
+        for (int frame = 0; ok && frame < 10; frame++) {
+            float scale = frame == 5 ? 0.5f : 0.01f;
+            for (int i = 0; i < TEST_PARTICLES; i++) {
+                state = state * 1664525u + 1013904223u;
+                x[i] += (float)((int)(state >> 16) % 101 - 50) * scale;
+                state = state * 1664525u + 1013904223u;
+                y[i] += (float)((int)(state >> 16) % 101 - 50) * scale;
+            }
+            ok = spatial_grid_update(counted, &particles).code == SUCCESS && check_stats(counted);
+        }
+
+        /* Clear, then lazy inserts (piling into one cell) before any sort */
+        spatial_grid_clear(counted);
+        ok = ok && check_stats(counted);
+        for (int i = 0; ok && i < 40; i++) {
+            ok = spatial_grid_insert(counted, i, 55.0f + (float)(i % 3), 35.0f).code == SUCCESS;
+        }
+        ok = ok && check_stats(counted);
+        if (ok) {
+            GridStats stats;
+            spatial_grid_get_stats(counted, &stats);
+            ok = stats.occupied_cells == 1 && stats.max_particles_per_cell == 40;
+        }
+        if (ok) {
+            printf("  ✓ Stats and histogram match a full scan after rebuild, update, clear, insert: PASSED\n");
+            passed_tests++;
+        } else {
+            printf("  ✗ Incremental statistics: FAILED\n");
+            failed_tests++;
+        }
+        spatial_grid_destroy(counted);
+    }
+
+    /* Test 13: Local force fields only visit the cells they overlap */
+    printf("Test 13: Grid-Culled Force Fields\n");
+    {
+        populate(x, y, TEST_PARTICLES);
+        particles.count = TEST_PARTICLES;
+        float *ref_vx = calloc(TEST_PARTICLES, sizeof(float));
+        float *ref_vy = calloc(TEST_PARTICLES, sizeof(float));
+        ForceField fields[7] = {
+            physics_create_radial_field(50.0f, 40.0f, 30.0f, 12.0f),
+            physics_create_vortex_field(3.0f, 97.0f, 20.0f, 15.0f),      /* Reaches past the corner */
+            physics_create_directional_field(0.0f, 1.0f, 4.0f),
+            physics_create_attractor_field(-8.0f, 50.0f, 500.0f, 20.0f),  /* Center outside the world */
+            physics_create_radial_field(120.0f, 60.0f, -10.0f, 0.0f),     /* Unbounded */
+            physics_create_vortex_field(100.0f, 50.0f, 5.0f, 400.0f),     /* Covers everything */
+            physics_create_radial_field(150.0f, 20.0f, 99.0f, 10.0f)
+        };
+        fields[6].active = false;
+        ForceField rest[7];
+
+        int ok = ref_vx && ref_vy && spatial_grid_rebuild(grid, &particles).code == SUCCESS &&
+                 physics_force_field_is_local(&fields[0]) && !physics_force_field_is_local(&fields[2]) &&
+                 !physics_force_field_is_local(&fields[4]) && !physics_force_field_is_local(&fields[6]);
+
+        /* Applying everything here matches the full pass exactly */
+        if (ok) {
+            memset(vx, 0, sizeof(float) * TEST_PARTICLES);
+            memset(vy, 0, sizeof(float) * TEST_PARTICLES);
+            ParticleSoA reference = { x, y, ref_vx, ref_vy, TEST_PARTICLES };
+            physics_apply_force_fields(&reference, fields, 7, 0.016f);
+            ok = physics_apply_force_fields_culled(grid, &particles, fields, 7, 0.016f, NULL) == 0 &&
+                 memcmp(vx, ref_vx, sizeof(float) * TEST_PARTICLES) == 0 &&
+                 memcmp(vy, ref_vy, sizeof(float) * TEST_PARTICLES) == 0;
+        }
+
+        /* Splitting the world-wide box's rows across a pool changes nothing */
+        if (ok) {
+            ThreadPool *workers = thread_pool_create(4);
+            memset(vx, 0, sizeof(float) * TEST_PARTICLES);
+            memset(vy, 0, sizeof(float) * TEST_PARTICLES);
+            ok = workers &&
+                 physics_apply_force_fields_culled_parallel(grid, &particles, fields, 7, 0.016f,
+                                                            NULL, workers) == 0 &&
+                 memcmp(vx, ref_vx, sizeof(float) * TEST_PARTICLES) == 0 &&
+                 memcmp(vy, ref_vy, sizeof(float) * TEST_PARTICLES) == 0;
+            thread_pool_destroy(workers);
+        }
+
+        /* Unbounded and world-wide fields are handed back in order; with
+         * them applied afterwards the sums agree up to rounding */
+        int num_rest = 0;
+        if (ok) {
+            memset(vx, 0, sizeof(float) * TEST_PARTICLES);
+            memset(vy, 0, sizeof(float) * TEST_PARTICLES);
+            num_rest = physics_apply_force_fields_culled(grid, &particles, fields, 7, 0.016f, rest);
+            ok = num_rest == 3 && rest[0].type == FORCE_FIELD_DIRECTIONAL &&
+                 rest[1].type == FORCE_FIELD_RADIAL && rest[2].radius == 400.0f;
+            if (ok) physics_apply_force_fields(&particles, rest, num_rest, 0.016f);
+            for (int i = 0; ok && i < TEST_PARTICLES; i++) {
+                float slack = 1e-5f * (1.0f + fabsf(ref_vx[i]) + fabsf(ref_vy[i]));
+                if (fabsf(vx[i] - ref_vx[i]) > slack || fabsf(vy[i] - ref_vy[i]) > slack) ok = 0;
+            }
+        }
+
+        /* One step of simulations with and without culling, clear of the walls */
+        Simulation *sims[2] = { sim_create(TEST_PARTICLES, WORLD_W, WORLD_H),
+                                sim_create(TEST_PARTICLES, WORLD_W, WORLD_H) };
+        ok = ok && sims[0] && sims[1];
+        for (int s = 0; ok && s < 2; s++) {
+            sim_set_gravity(sims[s], 0.0f);
+            sim_enable_field_culling(sims[s], s == 0);
+            for (int j = 0; j < 7; j++) sim_add_force_field(sims[s], fields[j]);
+            for (int i = 0; i < 2000; i++) {
+                sim_add_particle(sims[s], 20.0f + (float)(i % 80) * 2.0f, 8.0f + (float)(i / 80) * 3.4f,
+                                 0.0f, 0.0f);
+            }
+            sim_step(sims[s], 0.016f);
+        }
+        if (ok) {
+            ParticleSoA a = sim_get_particle_view(sims[0]);
+            ParticleSoA b = sim_get_particle_view(sims[1]);
+            ok = a.count == b.count && a.count > 0;
+            for (int i = 0; ok && i < a.count; i++) {
+                float slack = 1e-3f * (1.0f + fabsf(b.vx[i]) + fabsf(b.vy[i]));
+                if (fabsf(a.vx[i] - b.vx[i]) > slack || fabsf(a.vy[i] - b.vy[i]) > slack) ok = 0;
+            }
+        }
+        if (ok) {
+            printf("  ✓ Culled pass matches the full pass, %d fields left for it: PASSED\n", num_rest);
+            passed_tests++;
+        } else {
+            printf("  ✗ Grid-culled force fields: FAILED\n");
+            failed_tests++;
+        }
+        sim_destroy(sims[0]);
+        sim_destroy(sims[1]);
+        free(ref_vx);
+        free(ref_vy);
+    }
+
+    /* Test 14: Error handling */
+    printf("Test 14: Error Handling\n");
+    {
+        int count = -1;
+        Error err = spatial_grid_rebuild(NULL, &particles);
+        if (err.code == ERROR_NULL_POINTER &&
+            spatial_grid_update(grid, NULL).code == ERROR_NULL_POINTER &&
+            spatial_hash_create(0.0f, 16) == NULL &&
+            spatial_hash_cell_indices(NULL, 0, 0, &count) == NULL &&
+            spatial_grid_cell_indices(grid, -1, 0, &count) == NULL && count == 0 &&
+            spatial_grid_query_knn(grid, &particles, 0.0f, 0.0f, 0, &count, NULL) == 0 &&
+            spatial_grid_query_knn_batch(grid, &particles, NULL, NULL, 4, 3, NULL, NULL, NULL).code == ERROR_NULL_POINTER &&
+            spatial_grid_create_with_capacity(WORLD_W, WORLD_H, 10.0f, -1) == NULL &&
+            physics_apply_force_fields_culled(NULL, &particles, NULL, 0, 0.016f, NULL) == 0) {
+            printf("  ✓ Invalid arguments rejected: PASSED\n");
+            passed_tests++;
+        } else {
+            printf("  ✗ Invalid arguments rejected: FAILED\n");
+            failed_tests++;
+        }
+    }
+
+    spatial_grid_destroy(grid);
+    free(x);
+    free(y);
+    free(vx);
+    free(vy);
+    free(found);
+    free(expected);
+
+    printf("\n=== Test Results ===\n");
+    printf("Passed: %d\n", passed_tests);
+    printf("Failed: %d\n", failed_tests);
+
+    return failed_tests == 0 ? 0 : 1;
+}
@@ -0,0 +1,256 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../src/error.h"
+#include "../src/sph.h"
+#include "../src/thread_pool.h"
+#include "../src/sim.h"
+
+#define WORLD_W 120
+#define WORLD_H 40
+#define TEST_PARTICLES 3001  /* Above SPH_PARALLEL_MIN_PARTICLES */
+
+/* A jittered block of fluid plus a few particles outside the world */
+static void populate(float *x, float *y, float *vx, float *vy, int count) {
+    unsigned state = 7u;
+    for (int i = 0; i < count; i++) {
+        state = state * 1664525u + 1013904223u;
+        float jx = (float)(state % 1000) / 1000.0f - 0.5f;
+        state = state * 1664525u + 1013904223u;
+        float jy = (float)(state % 1000) / 1000.0f - 0.5f;
+        x[i] = 10.0f + (float)(i % 75) * 0.9f + jx;
+        y[i] = 2.0f + (float)(i / 75) * 0.9f + jy;
+        vx[i] = jy * 4.0f;
+        vy[i] = jx * 4.0f;
+    }
+    x[0] = -1.5f;
+    y[1] = (float)WORLD_H + 0.7f;
+}
+
+/* Reference density of one particle by direct summation */
+static float brute_density(const SPHKernel *kernel, float mass, const float *x, const float *y,
+                           int count, int i) {
+    double sum = 0.0;
+    for (int j = 0; j < count; j++) {
+        double dx = x[j] - x[i], dy = y[j] - y[i];
+        double t = kernel->h_sq - (dx * dx + dy * dy);
+        if (t > 0.0) sum += t * t * t;
+    }
+    return (float)(mass * kernel->poly6 * sum);
+}
+
+int main() {
+    printf("=== SPH Test ===\n\n");
+
+    error_init();
+
+    int passed_tests = 0;
+    int failed_tests = 0;
+
+    static float x[TEST_PARTICLES], y[TEST_PARTICLES];
+    static float vx[2][TEST_PARTICLES], vy[2][TEST_PARTICLES];
+    static float v0x[TEST_PARTICLES], v0y[TEST_PARTICLES];
+    populate(x, y, v0x, v0y, TEST_PARTICLES);
+    SPHSettings settings = sph_default_settings();
+    ThreadPool *pool = thread_pool_create(4);
+
+    /* Test 1: The density kernel integrates to one over its support */
+    printf("Test 1: Kernel Normalization\n");
+    {
+        SPHKernel kernel = sph_make_kernel(1.5f, 2.0f);
+        double step = 0.005, integral = 0.0;
+        for (double px = -1.5; px <= 1.5; px += step) {
+            for (double py = -1.5; py <= 1.5; py += step) {
+                double t = kernel.h_sq - (px * px + py * py);
+                if (t > 0.0) integral += kernel.poly6 * t * t * t * step * step;
+            }
+        }
+        if (fabs(integral - 1.0) < 1e-2 && kernel.spiky_grad < 0.0f && kernel.visc_lap > 0.0f &&
+            kernel.mass_poly6 == 2.0f * kernel.poly6) {
+            printf("  ✓ Integral of W_poly6 = %.4f: PASSED\n", integral);
+            passed_tests++;
+        } else {
+            printf("  ✗ Kernel normalization: FAILED (%.4f)\n", integral);
+            failed_tests++;
+        }
+    }
+
+    SPHSolver *solver = sph_create(WORLD_W, WORLD_H, &settings, 0);
+
+    /* Test 2: Grid density pass matches direct summation */
+    printf("Test 2: Density\n");
+    {
+        memcpy(vx[0], v0x, sizeof(v0x));
+        memcpy(vy[0], v0y, sizeof(v0y));
+        ParticleSoA particles = { x, y, vx[0], vy[0], TEST_PARTICLES };
+        int ok = solver && pool && sph_compute_density(solver, &particles, NULL, NULL).code == SUCCESS;
+        float worst = 0.0f;
+        for (int i = 0; ok && i < TEST_PARTICLES; i++) {
+            float expected = brute_density(&solver->kernel, settings.particle_mass, x, y, TEST_PARTICLES, i);
+            float error = fabsf(solver->density[i] - expected) / expected;
+            if (error > worst) worst = error;
+        }
+        if (ok && worst < 1e-5f && solver->stats.neighbors > (uint64_t)TEST_PARTICLES) {
+            printf("  ✓ Worst relative error %.1e, %.1f neighbours each: PASSED\n", (double)worst,
+                   (double)solver->stats.neighbors / TEST_PARTICLES);
+            passed_tests++;
+        } else {
+            printf("  ✗ Density: FAILED (worst %.1e)\n", (double)worst);
+            failed_tests++;
+        }
+    }
+
+    /* Test 3: Pressure and viscosity kicks match direct summation */
+    printf("Test 3: Forces\n");
+    {
+        ParticleSoA particles = { x, y, vx[0], vy[0], TEST_PARTICLES };
+        const float dt = 0.001f;
+        int ok = solver && sph_apply_forces(solver, &particles, dt, NULL).code == SUCCESS;
+
+        const SPHKernel *kernel = &solver->kernel;
+        const float m = settings.particle_mass;
+        double worst = 0.0, largest = 0.0;
+        for (int i = 0; ok && i < TEST_PARTICLES; i++) {
+            double rho_i = solver->density[i];
+            double p_i = fmax(settings.stiffness * (rho_i - settings.rest_density), 0.0);
+            double ax = 0.0, ay = 0.0;
+            for (int j = 0; j < TEST_PARTICLES; j++) {
+                double dx = x[i] - x[j], dy = y[i] - y[j];
+                double r = sqrt(dx * dx + dy * dy);
+                if (j == i || r >= kernel->h) continue;
+                double rho_j = solver->density[j];
+                double p_j = fmax(settings.stiffness * (rho_j - settings.rest_density), 0.0);
+                double w = kernel->h - r;
+                if (r > 0.0) {
+                    double push = -m * (p_i + p_j) / (2.0 * rho_j) * kernel->spiky_grad * w * w / r;
+                    ax += push * dx;
+                    ay += push * dy;
+                }
+                double drag = settings.viscosity * m * kernel->visc_lap * w / rho_j;
+                ax += drag * (v0x[j] - v0x[i]);
+                ay += drag * (v0y[j] - v0y[i]);
+            }
+            ax /= rho_i;
+            ay /= rho_i;
+            double got_x = (vx[0][i] - v0x[i]) / dt, got_y = (vy[0][i] - v0y[i]) / dt;
+            worst = fmax(worst, hypot(got_x - ax, got_y - ay));
+            largest = fmax(largest, hypot(ax, ay));
+        }
+        if (ok && worst < 1e-3 * largest) {
+            printf("  ✓ Worst error %.1e of largest acceleration %.1e: PASSED\n", worst, largest);
+            passed_tests++;
+        } else {
+            printf("  ✗ Forces: FAILED (worst %.1e of %.1e)\n", worst, largest);
+            failed_tests++;
+        }
+    }
+
+    /* Test 4: Threaded passes give identical results and reuse memory */
+    printf("Test 4: Parallel Passes\n");
+    {
+        int capacity = solver ? solver->capacity : 0;
+        int ok = solver != NULL;
+        for (int run = 0; ok && run < 2; run++) {
+            memcpy(vx[run], v0x, sizeof(v0x));
+            memcpy(vy[run], v0y, sizeof(v0y));
+            ParticleSoA particles = { x, y, vx[run], vy[run], TEST_PARTICLES };
+            ok = sph_step(solver, &particles, 0.016f, run ? pool : NULL, NULL).code == SUCCESS;
+        }
+        ok = ok && solver->capacity == capacity &&
+             memcmp(vx[0], vx[1], sizeof(vx[0])) == 0 && memcmp(vy[0], vy[1], sizeof(vy[0])) == 0;
+        if (ok) {
+            printf("  ✓ Serial and 4-worker passes bit-identical: PASSED\n");
+            passed_tests++;
+        } else {
+            printf("  ✗ Parallel passes: FAILED\n");
+            failed_tests++;
+        }
+    }
+    sph_destroy(solver);
+
+    /* Test 5: Dam break in the simulation */
+    printf("Test 5: Simulation Fluid Mode\n");
+    {
+        Simulation *sim = sim_create(1000, WORLD_W, WORLD_H);
+        int ok = sim && sim_enable_sph(sim, true, NULL) && sim_get_sph(sim) != NULL;
+        for (int i = 0; ok && i < 900; i++) {
+            sim_add_particle(sim, 1.0f + (float)(i % 30), 9.0f + (float)(i / 30), 0.0f, 0.0f);
+        }
+        ok = ok && sim_get_particle_count(sim) == 900;
+        for (int step = 0; ok && step < 600; step++) {
+            sim_step(sim, 0.016f);
+        }
+
+        /* Nothing despawns or escapes, and the settled pool is near rest density */
+        double mean_density = 0.0, spread = 0.0;
+        if (ok) {
+            ParticleSoA view = sim_get_particle_view(sim);
+            const SPHSolver *sph = sim_get_sph(sim);
+            ok = view.count == 900;
+            double min_x = WORLD_W, max_x = 0.0;
+            for (int i = 0; ok && i < view.count; i++) {
+                if (!(view.x[i] >= 0.0f && view.x[i] < WORLD_W && view.y[i] >= 0.0f && view.y[i] < WORLD_H)) ok = 0;
+                mean_density += sph->density[i];
+                min_x = fmin(min_x, view.x[i]);
+                max_x = fmax(max_x, view.x[i]);
+            }
+            mean_density /= view.count;
+            spread = max_x - min_x;
+        }
+        ok = ok && fabs(mean_density - settings.rest_density) < 0.15 && spread > 60.0;
+        ok = ok && sim_enable_sph(sim, false, NULL) && sim_get_sph(sim) == NULL;
+
+        /* Asked to, the fluid resting on the floor drains like other particles */
+        SPHSettings draining = settings;
+        draining.despawn_resting = true;
+        ok = ok && !settings.despawn_resting && sim_enable_sph(sim, true, &draining);
+        for (int i = 0; ok && i < 900 - sim_get_particle_count(sim); i++) {
+            sim_add_particle(sim, 1.0f + (float)(i % 30), 9.0f + (float)(i / 30), 0.0f, 0.0f);
+        }
+        for (int step = 0; ok && step < 600; step++) {
+            sim_step(sim, 0.016f);
+        }
+        ok = ok && sim_get_particle_count(sim) < 900;
+        if (ok) {
+            printf("  ✓ Column spread to %.0f units at mean density %.2f: PASSED\n", spread, mean_density);
+            passed_tests++;
+        } else {
+            printf("  ✗ Simulation fluid mode: FAILED (density %.2f, spread %.0f)\n", mean_density, spread);
+            failed_tests++;
+        }
+        sim_destroy(sim);
+    }
+
+    /* Test 6: Error handling */
+    printf("Test 6: Error Handling\n");
+    {
+        SPHSolver *created = NULL;
+        SPHSettings bad = settings;
+        bad.smoothing_radius = 0.0f;
+        ParticleSoA particles = { x, y, vx[0], vy[0], TEST_PARTICLES };
+        SPHSolver *fresh = sph_create(WORLD_W, WORLD_H, NULL, 16);
+        if (sph_create(WORLD_W, WORLD_H, &bad, 0) == NULL &&
+            sph_create_with_error(WORLD_W, WORLD_H, &bad, 0, &created).code == ERROR_INVALID_PARAMETER &&
+            sph_create_with_error(0, WORLD_H, NULL, 0, &created).code == ERROR_INVALID_PARAMETER &&
+            sph_create_with_error(WORLD_W, WORLD_H, NULL, 0, NULL).code == ERROR_NULL_POINTER &&
+            sph_compute_density(NULL, &particles, NULL, NULL).code == ERROR_NULL_POINTER &&
+            fresh && sph_apply_forces(fresh, &particles, 0.016f, NULL).code == ERROR_INVALID_PARAMETER &&
+            !sim_enable_sph(NULL, true, NULL) && sim_get_sph(NULL) == NULL) {
+            printf("  ✓ Invalid arguments rejected: PASSED\n");
+            passed_tests++;
+        } else {
+            printf("  ✗ Invalid arguments rejected: FAILED\n");
+            failed_tests++;
+        }
+        sph_destroy(fresh);
+    }
+
+    thread_pool_destroy(pool);
+
+    printf("\n=== Test Results ===\n");
+    printf("Passed: %d\n", passed_tests);
+    printf("Failed: %d\n", failed_tests);
+
+    return failed_tests == 0 ? 0 : 1;
+}
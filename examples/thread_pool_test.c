@@ -0,0 +1,346 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../src/error.h"
+#include "../src/thread_pool.h"
+#include "../src/sim.h"
+
+#define COVERAGE_ITEMS 100003
+
+typedef struct {
+    int *hits;
+    int *owner;
+} CoverageJob;
+
+/* Mark every item once; record which worker ran it */
+static void coverage_chunk(void *ctx, int begin, int end, int worker_id) {
+    CoverageJob *job = (CoverageJob *)ctx;
+    for (int i = begin; i < end; i++) {
+        job->hits[i]++;
+        job->owner[i] = worker_id;
+    }
+}
+
+/* Make worker 0's chunks expensive so the others have to steal them */
+static void skewed_chunk(void *ctx, int begin, int end, int worker_id) {
+    volatile double *sink = (volatile double *)ctx;
+    int spins = begin < 64 ? 200000 : 10;
+    double acc = 0.0;
+    for (int i = 0; i < spins * (end - begin); i++) {
+        acc += (double)i * 1e-9;
+    }
+    *sink += acc * 0.0;
+    (void)worker_id;
+}
+
+/* Fill a simulation with a deterministic particle set, including some
+ * resting near the floor so despawns happen during the step */
+static void populate(Simulation *sim, int count) {
+    unsigned state = 12345u;
+    for (int i = 0; i < count; i++) {
+        state = state * 1664525u + 1013904223u;
+        float x = (float)(state % 1000) / 1000.0f * (sim->width - 1);
+        state = state * 1664525u + 1013904223u;
+        float y = (float)(state % 1000) / 1000.0f * (sim->height - 1);
+        state = state * 1664525u + 1013904223u;
+        float vx = ((float)(state % 2000) / 1000.0f - 1.0f) * 20.0f;
+        float vy = ((float)((state >> 11) % 2000) / 1000.0f - 1.0f) * 20.0f;
+        if (i % 7 == 0) {
+            y = sim->height - 1.5f;
+            vx = 0.1f;
+            vy = 0.0f;
+        }
+        sim_add_particle(sim, x, y, vx, vy);
+    }
+}
+
+static void position_sums(const Simulation *sim, double *sx, double *sy) {
+    *sx = 0.0;
+    *sy = 0.0;
+    for (int i = 0; i < sim->count; i++) {
+        Particle p;
+        if (sim_get_particle(sim, i, &p)) {
+            *sx += p.x;
+            *sy += p.y;
+        }
+    }
+}
+
+int main() {
+    printf("=== Thread Pool Test ===\n\n");
+
+    error_init();
+
+    int passed_tests = 0;
+    int failed_tests = 0;
+
+    /* Test 1: Every item is processed exactly once */
+    printf("Test 1: Parallel-For Coverage\n");
+    ThreadPool *pool = NULL;
+    Error err = thread_pool_create_with_error(4, &pool);
+    int *hits = calloc(COVERAGE_ITEMS, sizeof(int));
+    int *owner = calloc(COVERAGE_ITEMS, sizeof(int));
+    if (err.code == SUCCESS && pool && hits && owner) {
+        CoverageJob job = { hits, owner };
+        thread_pool_parallel_for(pool, COVERAGE_ITEMS, 97, coverage_chunk, &job);
+
+        int bad = 0;
+        int used[4] = {0};
+        for (int i = 0; i < COVERAGE_ITEMS; i++) {
+            if (hits[i] != 1) bad++;
+            if (owner[i] >= 0 && owner[i] < 4) used[owner[i]] = 1;
+        }
+        if (bad == 0 && thread_pool_get_thread_count(pool) == 4) {
+            printf("  ✓ Coverage (%d workers active): PASSED\n", used[0] + used[1] + used[2] + used[3]);
+            passed_tests++;
+        } else {
+            printf("  ✗ Coverage: FAILED (%d items not run exactly once)\n", bad);
+            failed_tests++;
+        }
+    } else {
+        printf("  ✗ Pool creation: FAILED\n");
+        error_print(&err);
+        failed_tests++;
+    }
+
+    /* Test 2: Idle workers steal from a loaded queue */
+    printf("Test 2: Work Stealing\n");
+    if (pool) {
+        volatile double sink = 0.0;
+        ThreadPoolStats before = thread_pool_get_stats(pool);
+        thread_pool_parallel_for(pool, 4096, 1, skewed_chunk, (void *)&sink);
+        ThreadPoolStats after = thread_pool_get_stats(pool);
+
+        if (after.jobs == before.jobs + 1 && after.chunks - before.chunks == 4096 &&
+            after.steals > before.steals) {
+            printf("  ✓ Stealing (%llu steals): PASSED\n",
+                   (unsigned long long)(after.steals - before.steals));
+            passed_tests++;
+        } else {
+            printf("  ✗ Stealing: FAILED (chunks=%llu steals=%llu)\n",
+                   (unsigned long long)(after.chunks - before.chunks),
+                   (unsigned long long)(after.steals - before.steals));
+            failed_tests++;
+        }
+    } else {
+        printf("  ✗ Stealing: SKIPPED (no pool)\n");
+        failed_tests++;
+    }
+
+    /* Test 3: NULL pool and invalid sizes */
+    printf("Test 3: Inline Fallback and Validation\n");
+    {
+        memset(hits, 0, COVERAGE_ITEMS * sizeof(int));
+        CoverageJob job = { hits, owner };
+        thread_pool_parallel_for(NULL, 1000, 16, coverage_chunk, &job);
+        int bad = 0;
+        for (int i = 0; i < 1000; i++) {
+            if (hits[i] != 1 || owner[i] != 0) bad++;
+        }
+
+        ThreadPool *invalid = NULL;
+        err = thread_pool_create_with_error(0, &invalid);
+        if (bad == 0 && err.code == ERROR_INVALID_PARAMETER && invalid == NULL) {
+            printf("  ✓ Inline fallback and validation: PASSED\n");
+            passed_tests++;
+        } else {
+            printf("  ✗ Inline fallback and validation: FAILED\n");
+            failed_tests++;
+        }
+    }
+
+    free(hits);
+    free(owner);
+    thread_pool_destroy(pool);
+
+    /* Test 4: Parallel sim_step matches single-threaded stepping */
+    printf("Test 4: Parallel Simulation Step\n");
+    {
+        const int count = 40000;
+        Simulation *serial = sim_create(count, 200, 100);
+        Simulation *parallel = sim_create(count, 200, 100);
+
+        if (serial && parallel) {
+            populate(serial, count);
+            populate(parallel, count);
+            sim_add_force_field(serial, physics_create_vortex_field(100.0f, 50.0f, 5.0f, 40.0f));
+            sim_add_force_field(parallel, physics_create_vortex_field(100.0f, 50.0f, 5.0f, 40.0f));
+
+            int threads = sim_set_thread_count(parallel, 4);
+
+            for (int step = 0; step < 30; step++) {
+                sim_step(serial, 0.016f);
+                sim_step(parallel, 0.016f);
+            }
+
+            double sx1, sy1, sx2, sy2;
+            position_sums(serial, &sx1, &sy1);
+            position_sums(parallel, &sx2, &sy2);
+
+            bool same_count = serial->count == parallel->count;
+            bool despawned = parallel->count < count;
+            bool close = fabs(sx1 - sx2) <= 1e-3 * fabs(sx1) && fabs(sy1 - sy2) <= 1e-3 * fabs(sy1);
+
+            if (threads == 4 && same_count && despawned && close) {
+                printf("  ✓ Parallel step matches serial (%d particles): PASSED\n", parallel->count);
+                passed_tests++;
+            } else {
+                printf("  ✗ Parallel step: FAILED (threads=%d count %d vs %d, sum x %.2f vs %.2f)\n",
+                       threads, serial->count, parallel->count, sx1, sx2);
+                failed_tests++;
+            }
+
+            if (sim_set_thread_count(parallel, 1) == 1 && sim_get_thread_count(parallel) == 1) {
+                printf("  ✓ Return to single thread: PASSED\n");
+                passed_tests++;
+            } else {
+                printf("  ✗ Return to single thread: FAILED\n");
+                failed_tests++;
+            }
+        } else {
+            printf("  ✗ Simulation creation: FAILED\n");
+            failed_tests++;
+        }
+
+        sim_destroy(serial);
+        sim_destroy(parallel);
+    }
+
+    /* Test 5: Colour-scheduled collisions match the single-threaded pass */
+    printf("Test 5: Parallel Collision Resolution\n");
+    {
+        const int count = 20000;
+        float *columns[2][4];
+        int allocated = 1;
+        for (int k = 0; k < 2; k++) {
+            for (int c = 0; c < 4; c++) {
+                columns[k][c] = malloc(sizeof(float) * count);
+                if (!columns[k][c]) allocated = 0;
+            }
+        }
+
+        ThreadPool *workers = thread_pool_create(4);
+        FrameArena *arena = arena_create(0);
+        SpatialGrid *grid = spatial_grid_create_with_capacity(200, 100, 10.0f, count);
+
+        if (allocated && workers && arena && grid) {
+            /* Dense enough that most cells hold dozens of overlapping particles */
+            unsigned state = 777u;
+            for (int i = 0; i < count; i++) {
+                float values[4];
+                for (int c = 0; c < 4; c++) {
+                    state = state * 1664525u + 1013904223u;
+                    values[c] = (float)(state % 10000) / 10000.0f;
+                }
+                for (int k = 0; k < 2; k++) {
+                    columns[k][0][i] = values[0] * 199.0f;
+                    columns[k][1][i] = values[1] * 99.0f;
+                    columns[k][2][i] = (values[2] - 0.5f) * 20.0f;
+                    columns[k][3][i] = (values[3] - 0.5f) * 20.0f;
+                }
+            }
+            ParticleSoA serial_view = { columns[0][0], columns[0][1], columns[0][2], columns[0][3], count };
+            ParticleSoA parallel_view = { columns[1][0], columns[1][1], columns[1][2], columns[1][3], count };
+            CollisionSettings settings = physics_default_collision_settings();
+            settings.enabled = true;
+
+            spatial_grid_rebuild(grid, &serial_view);
+            int serial_hits = physics_resolve_collisions(grid, &serial_view, &settings, NULL);
+            int parallel_hits = physics_resolve_collisions_parallel(grid, &parallel_view, &settings,
+                                                                    arena, workers);
+
+            int same = 1;
+            for (int c = 0; c < 4; c++) {
+                if (memcmp(columns[0][c], columns[1][c], sizeof(float) * count) != 0) same = 0;
+            }
+            if (same && serial_hits == parallel_hits && serial_hits > 0) {
+                printf("  ✓ %d collisions, identical to serial: PASSED\n", parallel_hits);
+                passed_tests++;
+            } else {
+                printf("  ✗ Parallel collisions: FAILED (serial %d, parallel %d, identical=%d)\n",
+                       serial_hits, parallel_hits, same);
+                failed_tests++;
+            }
+        } else {
+            printf("  ✗ Setup: FAILED\n");
+            failed_tests++;
+        }
+
+        spatial_grid_destroy(grid);
+        arena_destroy(arena);
+        thread_pool_destroy(workers);
+        for (int k = 0; k < 2; k++) {
+            for (int c = 0; c < 4; c++) {
+                free(columns[k][c]);
+            }
+        }
+    }
+
+    /* Test 6: Parallel grid build gives the serial layout */
+    printf("Test 6: Parallel Grid Build\n");
+    {
+        const int count = 50000;
+        float *x = malloc(sizeof(float) * count);
+        float *y = malloc(sizeof(float) * count);
+        ThreadPool *workers = thread_pool_create(4);
+        FrameArena *arena = arena_create(0);
+        SpatialGrid *serial = spatial_grid_create_with_capacity(200, 100, 10.0f, count);
+        SpatialGrid *parallel = spatial_grid_create_with_capacity(200, 100, 10.0f, 16);
+
+        if (x && y && workers && arena && serial && parallel) {
+            /* Some particles outside the world land in clamped edge cells */
+            unsigned state = 4242u;
+            for (int i = 0; i < count; i++) {
+                state = state * 1664525u + 1013904223u;
+                x[i] = (float)(state % 22000) / 100.0f - 10.0f;
+                state = state * 1664525u + 1013904223u;
+                y[i] = (float)(state % 12000) / 100.0f - 10.0f;
+            }
+            ParticleSoA view = { x, y, NULL, NULL, count };
+            int total_cells = serial->rows * serial->cols;
+
+            Error serial_err = spatial_grid_rebuild(serial, &view);
+            Error parallel_err = spatial_grid_rebuild_parallel(parallel, &view, workers, arena);
+            int same = serial_err.code == SUCCESS && parallel_err.code == SUCCESS &&
+                       parallel->total_particles == count && parallel->tracking &&
+                       memcmp(serial->cell_start, parallel->cell_start, sizeof(int) * (total_cells + 1)) == 0 &&
+                       memcmp(serial->cell_count, parallel->cell_count, sizeof(int) * total_cells) == 0 &&
+                       memcmp(serial->indices, parallel->indices, sizeof(int) * count) == 0 &&
+                       memcmp(serial->slot, parallel->slot, sizeof(int) * count) == 0 &&
+                       serial->max_occupancy == parallel->max_occupancy &&
+                       memcmp(serial->occupancy, parallel->occupancy,
+                              sizeof(int) * ((size_t)serial->max_occupancy + 1)) == 0;
+
+            /* The parallel-built grid keeps updating incrementally */
+            for (int i = 0; i < count; i += 50) x[i] += 10.0f;
+            int updated = spatial_grid_update_parallel(parallel, &view, workers, arena).code == SUCCESS &&
+                          parallel->last_moved > 0;
+
+            if (same && updated) {
+                printf("  ✓ %d particles on %d workers, identical to serial: PASSED\n",
+                       count, thread_pool_get_thread_count(workers));
+                passed_tests++;
+            } else {
+                printf("  ✗ Parallel grid build: FAILED (identical=%d, updated=%d)\n", same, updated);
+                failed_tests++;
+            }
+        } else {
+            printf("  ✗ Setup: FAILED\n");
+            failed_tests++;
+        }
+
+        spatial_grid_destroy(serial);
+        spatial_grid_destroy(parallel);
+        arena_destroy(arena);
+        thread_pool_destroy(workers);
+        free(x);
+        free(y);
+    }
+
+    printf("\n=== Test Results ===\n");
+    printf("Passed: %d\n", passed_tests);
+    printf("Failed: %d\n", failed_tests);
+
+    return failed_tests == 0 ? 0 : 1;
+}
@@ -0,0 +1,169 @@
+#include "arena.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Overflow block header; the payload starts ARENA_ALIGNMENT bytes in */
+struct ArenaOverflow {
+    ArenaOverflow *next;
+};
+
+static size_t arena_align(size_t size) {
+    return (size + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+}
+
+static uint8_t *arena_alloc_block(size_t size) {
+    void *block = NULL;
+    if (posix_memalign(&block, ARENA_ALIGNMENT, size) != 0) {
+        return NULL;
+    }
+    return (uint8_t *)block;
+}
+
+/* Free all overflow blocks */
+static void arena_free_overflow(FrameArena *arena) {
+    ArenaOverflow *block = arena->overflow;
+    while (block) {
+        ArenaOverflow *next = block->next;
+        free(block);
+        block = next;
+    }
+    arena->overflow = NULL;
+}
+
+/* Create an arena with a main block of at least capacity bytes */
+FrameArena *arena_create(size_t capacity) {
+    FrameArena *arena = calloc(1, sizeof(FrameArena));
+    if (!arena) {
+        return NULL;
+    }
+
+    arena->capacity = arena_align(capacity > 0 ? capacity : ARENA_DEFAULT_CAPACITY);
+    arena->base = arena_alloc_block(arena->capacity);
+    if (!arena->base) {
+        free(arena);
+        return NULL;
+    }
+
+    arena->stats.capacity = arena->capacity;
+    return arena;
+}
+
+/* Destroy arena and every block it owns */
+void arena_destroy(FrameArena *arena) {
+    if (arena) {
+        arena_free_overflow(arena);
+        free(arena->base);
+        free(arena);
+    }
+}
+
+/* Bump-allocate from the main block, spilling into an overflow block */
+void *arena_alloc(FrameArena *arena, size_t size) {
+    if (!arena) {
+        return NULL;
+    }
+
+    size_t aligned = arena_align(size > 0 ? size : 1);
+    void *ptr;
+
+    if (aligned <= arena->capacity - arena->offset) {
+        ptr = arena->base + arena->offset;
+        arena->offset += aligned;
+    } else {
+        uint8_t *block = arena_alloc_block(ARENA_ALIGNMENT + aligned);
+        if (!block) {
+            return NULL;
+        }
+        ArenaOverflow *header = (ArenaOverflow *)block;
+        header->next = arena->overflow;
+        arena->overflow = header;
+        ptr = block + ARENA_ALIGNMENT;
+        arena->stats.overflow_allocations++;
+    }
+
+    arena->stats.allocations++;
+    arena->stats.used += aligned;
+    if (arena->stats.used > arena->stats.high_water) {
+        arena->stats.high_water = arena->stats.used;
+    }
+    return ptr;
+}
+
+/* Start a new frame */
+void arena_reset(FrameArena *arena) {
+    if (!arena) {
+        return;
+    }
+
+    /* Last frame spilled: grow the main block so the next one fits */
+    if (arena->overflow) {
+        arena_free_overflow(arena);
+
+        size_t new_capacity = arena_align(arena->stats.high_water + arena->stats.high_water / 4);
+        uint8_t *new_base = arena_alloc_block(new_capacity);
+        if (new_base) {
+            free(arena->base);
+            arena->base = new_base;
+            arena->capacity = new_capacity;
+            arena->stats.capacity = new_capacity;
+            arena->stats.grows++;
+        }
+    }
+
+    arena->offset = 0;
+    arena->stats.used = 0;
+    arena->stats.resets++;
+}
+
+/* Get arena statistics */
+ArenaStats arena_get_stats(const FrameArena *arena) {
+    if (!arena) {
+        return (ArenaStats){0};
+    }
+    return arena->stats;
+}
+
+void arena_print_status(const FrameArena *arena) {
+    if (!arena) {
+        printf("Arena: NULL\n");
+        return;
+    }
+
+    printf("Frame Arena Status:\n");
+    printf("  Capacity: %zu bytes\n", arena->stats.capacity);
+    printf("  Used This Frame: %zu bytes\n", arena->stats.used);
+    printf("  High-Water Mark: %zu bytes\n", arena->stats.high_water);
+    printf("  Allocations: %lu\n", (unsigned long)arena->stats.allocations);
+    printf("  Overflow Allocations: %lu\n", (unsigned long)arena->stats.overflow_allocations);
+    printf("  Frames: %lu\n", (unsigned long)arena->stats.resets);
+    printf("  Grows: %lu\n", (unsigned long)arena->stats.grows);
+}
+
+/* ===== ERROR-AWARE ARENA FUNCTIONS ===== */
+
+/* Create arena with error handling */
+Error arena_create_with_error(size_t capacity, FrameArena **arena_out) {
+    ERROR_CHECK_NULL(arena_out, "Arena output pointer");
+
+    FrameArena *arena = arena_create(capacity);
+    if (!arena) {
+        return ERROR_CREATE(ERROR_MEMORY_ALLOCATION, "Failed to allocate frame arena");
+    }
+
+    *arena_out = arena;
+    return (Error){SUCCESS, NULL, NULL, 0, NULL};
+}
+
+/* Allocate from arena with error handling */
+Error arena_alloc_with_error(FrameArena *arena, size_t size, void **ptr_out) {
+    ERROR_CHECK_NULL(arena, "Arena");
+    ERROR_CHECK_NULL(ptr_out, "Arena output pointer");
+
+    void *ptr = arena_alloc(arena, size);
+    if (!ptr) {
+        return ERROR_CREATE(ERROR_MEMORY_ALLOCATION, "Frame arena allocation failed");
+    }
+
+    *ptr_out = ptr;
+    return (Error){SUCCESS, NULL, NULL, 0, NULL};
+}
@@ -0,0 +1,70 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "error.h"
+
+/**
+ * Frame Arena
+ *
+ * Bump allocator for per-frame scratch memory (despawn marks and other
+ * per-step buffers). Allocations are never freed individually;
+ * arena_reset() releases everything at the start of the next frame.
+ *
+ * Requests that do not fit the main block are served from overflow
+ * blocks so a frame never fails; the next reset grows the main block to
+ * the frame's high-water mark, so steady-state frames touch the heap
+ * zero times.
+ *
+ * Not thread-safe: allocate on the stepping thread before handing
+ * memory to workers.
+ */
+
+/* Alignment of every allocation (one cache line / AVX-512 vector) */
+#define ARENA_ALIGNMENT 64
+
+/* Main block size used when none is given */
+#define ARENA_DEFAULT_CAPACITY (64 * 1024)
+
+/* Arena usage statistics */
+typedef struct {
+    size_t capacity;               /* Bytes in the main block */
+    size_t used;                   /* Bytes handed out since the last reset */
+    size_t high_water;             /* Peak bytes used in any one frame */
+    uint64_t allocations;          /* Allocations since creation */
+    uint64_t overflow_allocations; /* Allocations that missed the main block */
+    uint64_t resets;               /* Frames started */
+    uint64_t grows;                /* Times the main block was enlarged */
+} ArenaStats;
+
+typedef struct ArenaOverflow ArenaOverflow;
+
+/* Frame arena */
+typedef struct {
+    uint8_t *base;                 /* Main block */
+    size_t capacity;               /* Size of the main block */
+    size_t offset;                 /* Bump pointer into the main block */
+    ArenaOverflow *overflow;       /* Blocks for requests that did not fit */
+    ArenaStats stats;              /* Usage statistics */
+} FrameArena;
+
+/* Arena management functions */
+FrameArena *arena_create(size_t capacity);
+void arena_destroy(FrameArena *arena);
+
+/* Allocate size bytes aligned to ARENA_ALIGNMENT (NULL only when out of memory) */
+void *arena_alloc(FrameArena *arena, size_t size);
+
+/* Release every allocation; grows the main block if the last frame overflowed */
+void arena_reset(FrameArena *arena);
+
+/* Statistics */
+ArenaStats arena_get_stats(const FrameArena *arena);
+void arena_print_status(const FrameArena *arena);
+
+/* Error-aware arena functions */
+Error arena_create_with_error(size_t capacity, FrameArena **arena_out);
+Error arena_alloc_with_error(FrameArena *arena, size_t size, void **ptr_out);
+
+#endif /* ARENA_H */
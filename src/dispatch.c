@@ -0,0 +1,171 @@
+#include "dispatch.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+static const char *const TIER_NAMES[KERNEL_TIER_COUNT] = {
+    "scalar", "neon", "sse4", "avx2", "avx512"
+};
+
+static KernelDispatch g_dispatch;
+static pthread_once_t g_dispatch_once = PTHREAD_ONCE_INIT;
+
+/* Parse a tier name; returns -1 for NULL, "auto" or unknown names */
+static int dispatch_parse_tier(const char *tier_name) {
+    if (!tier_name) {
+        return -1;
+    }
+    for (int i = 0; i < KERNEL_TIER_COUNT; i++) {
+        if (strcmp(tier_name, TIER_NAMES[i]) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/* Fill the kernel slots for a tier the CPU supports */
+static KernelDispatch dispatch_build(KernelTier tier) {
+    KernelDispatch dispatch = {
+        .tier = tier,
+        .overridden = false,
+        .step = simd_step_scalar,
+        .soa_step = simd_step_soa_scalar,
+        .fused_step = physics_step_fused_scalar,
+        .fields = physics_apply_force_fields,
+        .collide = physics_resolve_collisions_parallel,
+        .radius_filter = spatial_grid_filter_scalar,
+        .lattice_sample = field_lattice_sample_scalar
+    };
+
+    switch (tier) {
+        case KERNEL_TIER_AVX512:
+            dispatch.step = simd_step_avx512;
+            dispatch.soa_step = simd_step_soa_avx512;
+            dispatch.fused_step = physics_step_fused_avx512;
+            dispatch.fields = physics_apply_force_fields_avx512;
+            dispatch.radius_filter = spatial_grid_filter_avx512;
+            dispatch.lattice_sample = field_lattice_sample_avx512;
+            break;
+        case KERNEL_TIER_AVX2:
+            dispatch.step = simd_step_avx;
+            dispatch.soa_step = simd_step_soa_avx2;
+            dispatch.fused_step = physics_step_fused_avx2;
+            dispatch.fields = physics_apply_force_fields_avx2;
+            dispatch.radius_filter = spatial_grid_filter_avx2;
+            dispatch.lattice_sample = field_lattice_sample_avx2;
+            break;
+        case KERNEL_TIER_SSE4:
+            dispatch.step = simd_step_sse;
+            dispatch.soa_step = simd_step_soa_sse;
+            dispatch.fused_step = physics_step_fused_sse;
+            dispatch.fields = physics_apply_force_fields_sse;
+            dispatch.radius_filter = spatial_grid_filter_sse;
+            break;
+        case KERNEL_TIER_NEON:
+            dispatch.step = simd_step_neon_optimized;
+            dispatch.soa_step = simd_step_soa_neon;
+            dispatch.fused_step = physics_step_fused_neon;
+            break;
+        default:
+            break;
+    }
+    return dispatch;
+}
+
+/* Resolve the global table from the environment */
+static void dispatch_init(void) {
+    g_dispatch = dispatch_resolve(getenv(DISPATCH_ENV_VAR));
+}
+
+/* Run the resolution at load time so the first frame pays nothing */
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((constructor))
+static void dispatch_load(void) {
+    pthread_once(&g_dispatch_once, dispatch_init);
+}
+#endif
+
+/* Get the table resolved at load time */
+const KernelDispatch *dispatch_get(void) {
+    pthread_once(&g_dispatch_once, dispatch_init);
+    return &g_dispatch;
+}
+
+/* Build the table for a tier name */
+KernelDispatch dispatch_resolve(const char *tier_name) {
+    int requested = dispatch_parse_tier(tier_name);
+
+    if (requested >= 0 && dispatch_tier_supported((KernelTier)requested)) {
+        KernelDispatch dispatch = dispatch_build((KernelTier)requested);
+        dispatch.overridden = true;
+        return dispatch;
+    }
+    return dispatch_build(dispatch_best_tier());
+}
+
+/* Check whether this CPU can run a tier's kernels */
+bool dispatch_tier_supported(KernelTier tier) {
+    switch (tier) {
+        case KERNEL_TIER_SCALAR:
+            return true;
+        case KERNEL_TIER_NEON:
+            return simd_is_supported(SIMD_NEON) != 0;
+        case KERNEL_TIER_SSE4:
+            return simd_is_supported(SIMD_SSE4_1) != 0;
+        case KERNEL_TIER_AVX2:
+            return simd_is_supported(SIMD_AVX2) && simd_is_supported(SIMD_FMA);
+        case KERNEL_TIER_AVX512:
+            return simd_is_supported(SIMD_AVX512F) != 0;
+        default:
+            return false;
+    }
+}
+
+/* Pick the widest supported tier */
+KernelTier dispatch_best_tier(void) {
+    for (int tier = KERNEL_TIER_COUNT - 1; tier > KERNEL_TIER_SCALAR; tier--) {
+        if (dispatch_tier_supported((KernelTier)tier)) {
+            return (KernelTier)tier;
+        }
+    }
+    return KERNEL_TIER_SCALAR;
+}
+
+const char *dispatch_tier_name(KernelTier tier) {
+    if ((int)tier < 0 || tier >= KERNEL_TIER_COUNT) {
+        return "unknown";
+    }
+    return TIER_NAMES[tier];
+}
+
+void dispatch_print(const KernelDispatch *dispatch) {
+    if (!dispatch) {
+        printf("Kernel Dispatch: NULL\n");
+        return;
+    }
+
+    printf("Kernel Dispatch:\n");
+    printf("  Tier: %s%s\n", dispatch_tier_name(dispatch->tier),
+           dispatch->overridden ? " (from " DISPATCH_ENV_VAR ")" : "");
+    printf("  Step: %s\n", simd_get_function_name(dispatch->step));
+    printf("  SoA Step: %s\n", simd_get_soa_function_name(dispatch->soa_step));
+    printf("  Fused Step: %s\n", physics_get_step_function_name(dispatch->fused_step));
+}
+
+/* ===== ERROR-AWARE DISPATCH FUNCTIONS ===== */
+
+/* Build the table for a tier name, rejecting unknown or unsupported tiers */
+Error dispatch_resolve_with_error(const char *tier_name, KernelDispatch *dispatch_out) {
+    ERROR_CHECK_NULL(dispatch_out, "Dispatch output pointer");
+
+    if (tier_name && strcmp(tier_name, "auto") != 0) {
+        int requested = dispatch_parse_tier(tier_name);
+        ERROR_CHECK_CONDITION(requested >= 0, ERROR_INVALID_PARAMETER, "Unknown kernel tier");
+        ERROR_CHECK_CONDITION(dispatch_tier_supported((KernelTier)requested), ERROR_INVALID_PARAMETER,
+                              "Kernel tier not supported by this CPU");
+    }
+
+    *dispatch_out = dispatch_resolve(tier_name);
+    return (Error){SUCCESS, NULL, NULL, 0, NULL};
+}
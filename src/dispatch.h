@@ -0,0 +1,73 @@
+#ifndef DISPATCH_H
+#define DISPATCH_H
+
+#include <stdbool.h>
+#include "error.h"
+#include "simd.h"
+#include "physics.h"
+#include "field_lattice.h"
+
+/**
+ * Kernel Dispatch Table
+ *
+ * Every hot-loop kernel that has more than one implementation is picked
+ * once, when the program loads, and cached in a table; callers index the
+ * table instead of re-walking the CPU capability flags every frame.
+ *
+ * The tier can be forced for A/B benchmarking with the SIM_KERNEL
+ * environment variable (scalar, sse4, avx2, avx512, neon or auto). A tier
+ * the CPU cannot run is ignored and the best supported tier is used.
+ */
+
+/* Environment variable that overrides the selected tier */
+#define DISPATCH_ENV_VAR "SIM_KERNEL"
+
+/* Kernel tiers, in x86 preference order */
+typedef enum {
+    KERNEL_TIER_SCALAR,
+    KERNEL_TIER_NEON,
+    KERNEL_TIER_SSE4,
+    KERNEL_TIER_AVX2,
+    KERNEL_TIER_AVX512,
+    KERNEL_TIER_COUNT
+} KernelTier;
+
+/* Force-field and collision kernel signatures */
+typedef void (*physics_fields_func_t)(ParticleSoA *particles, ForceField *fields,
+                                      int num_fields, float dt);
+typedef int (*physics_collide_func_t)(SpatialGrid *grid, ParticleSoA *particles,
+                                      CollisionSettings *settings, FrameArena *arena,
+                                      ThreadPool *pool);
+
+/* Resolved kernels for one tier */
+typedef struct {
+    KernelTier tier;
+    bool overridden;                 /* Tier came from SIM_KERNEL */
+    simd_step_func_t step;           /* AoS integration */
+    simd_soa_step_func_t soa_step;   /* SoA integration */
+    physics_step_func_t fused_step;  /* Integration + force fields + walls */
+    physics_fields_func_t fields;    /* Standalone force-field pass */
+    physics_collide_func_t collide;  /* Grid collision pass */
+    grid_radius_filter_func_t radius_filter;  /* Batched radius query distance test */
+    field_lattice_sample_func_t lattice_sample; /* Baked force-field sampling */
+} KernelDispatch;
+
+/* Get the table resolved at load time (never NULL) */
+const KernelDispatch *dispatch_get(void);
+
+/* Build the table for a tier name (NULL or "auto" = best supported);
+ * unknown or unsupported names fall back to the best supported tier */
+KernelDispatch dispatch_resolve(const char *tier_name);
+
+/* Tier queries */
+bool dispatch_tier_supported(KernelTier tier);
+KernelTier dispatch_best_tier(void);
+const char *dispatch_tier_name(KernelTier tier);
+
+/* Debug */
+void dispatch_print(const KernelDispatch *dispatch);
+
+/* Error-aware dispatch functions */
+Error dispatch_resolve_with_error(const char *tier_name, KernelDispatch *dispatch_out);
+
+#endif /* DISPATCH_H */
@@ -0,0 +1,268 @@
+#include "field_lattice.h"
+#include "dispatch.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define LATTICE_TARGET_AVX2 __attribute__((target("avx2")))
+#define LATTICE_TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+
+/* Helper: Bilinear sample at one position, added to one velocity */
+static inline void lattice_sample_one(const FieldLattice *lattice, float x, float y,
+                                      float *vx, float *vy, float dt) {
+    const float max_gx = (float)lattice->cols;
+    const float max_gy = (float)lattice->rows;
+
+    /* Lattice coordinates, clamped to the edge (NaN lands on 0) */
+    float gx = x * lattice->inv_spacing;
+    float gy = y * lattice->inv_spacing;
+    if (!(gx >= 0.0f)) gx = 0.0f;
+    if (gx > max_gx) gx = max_gx;
+    if (!(gy >= 0.0f)) gy = 0.0f;
+    if (gy > max_gy) gy = max_gy;
+
+    int i = (int)gx;
+    int j = (int)gy;
+    if (i > lattice->cols - 1) i = lattice->cols - 1;
+    if (j > lattice->rows - 1) j = lattice->rows - 1;
+    float t = gx - (float)i;
+    float u = gy - (float)j;
+
+    int n = j * lattice->stride + i;
+    int s = lattice->stride;
+
+    float top = lattice->ax[n] + (lattice->ax[n + 1] - lattice->ax[n]) * t;
+    float bottom = lattice->ax[n + s] + (lattice->ax[n + s + 1] - lattice->ax[n + s]) * t;
+    *vx += (top + (bottom - top) * u) * dt;
+
+    top = lattice->ay[n] + (lattice->ay[n + 1] - lattice->ay[n]) * t;
+    bottom = lattice->ay[n + s] + (lattice->ay[n + s + 1] - lattice->ay[n + s]) * t;
+    *vy += (top + (bottom - top) * u) * dt;
+}
+
+/* Create a lattice: struct and node columns in one block */
+FieldLattice *field_lattice_create(int world_width, int world_height, float spacing) {
+    if (world_width <= 0 || world_height <= 0) {
+        return NULL;
+    }
+    if (spacing <= 0.0f) {
+        spacing = FIELD_LATTICE_DEFAULT_SPACING;
+    }
+
+    int cols = (int)ceilf((float)world_width / spacing);
+    int rows = (int)ceilf((float)world_height / spacing);
+    if (cols < 1) cols = 1;
+    if (rows < 1) rows = 1;
+
+    size_t nodes = (size_t)(cols + 1) * (size_t)(rows + 1);
+    FieldLattice *lattice = calloc(1, sizeof(FieldLattice) + 4 * nodes * sizeof(float));
+    if (!lattice) {
+        return NULL;
+    }
+
+    lattice->cols = cols;
+    lattice->rows = rows;
+    lattice->stride = cols + 1;
+    lattice->num_nodes = (int)nodes;
+    lattice->spacing = spacing;
+    lattice->inv_spacing = 1.0f / spacing;
+
+    float *block = (float *)(lattice + 1);
+    lattice->node_x = block;
+    lattice->node_y = block + nodes;
+    lattice->ax = block + 2 * nodes;
+    lattice->ay = block + 3 * nodes;
+
+    for (int j = 0; j <= rows; j++) {
+        for (int i = 0; i <= cols; i++) {
+            lattice->node_x[j * lattice->stride + i] = (float)i * spacing;
+            lattice->node_y[j * lattice->stride + i] = (float)j * spacing;
+        }
+    }
+    return lattice;
+}
+
+/* Destroy lattice */
+void field_lattice_destroy(FieldLattice *lattice) {
+    free(lattice);
+}
+
+/* Rasterize the summed field acceleration onto the nodes */
+Error field_lattice_bake(FieldLattice *lattice, ForceField *fields, int num_fields) {
+    ERROR_CHECK_NULL(lattice, "Field lattice");
+    ERROR_CHECK_CONDITION(num_fields >= 0, ERROR_INVALID_PARAMETER, "Field count must be non-negative");
+    ERROR_CHECK_CONDITION(num_fields == 0 || fields, ERROR_NULL_POINTER, "Force fields cannot be NULL");
+
+    memset(lattice->ax, 0, sizeof(float) * (size_t)lattice->num_nodes);
+    memset(lattice->ay, 0, sizeof(float) * (size_t)lattice->num_nodes);
+
+    /* Nodes are particles at rest: one unit of time leaves the acceleration */
+    if (num_fields > 0) {
+        ParticleSoA nodes = {
+            lattice->node_x, lattice->node_y, lattice->ax, lattice->ay, lattice->num_nodes
+        };
+        dispatch_get()->fields(&nodes, fields, num_fields, 1.0f);
+    }
+
+    lattice->bakes++;
+    return (Error){SUCCESS};
+}
+
+/* Scalar sampling (reference implementation) */
+void field_lattice_sample_scalar(const FieldLattice *lattice, ParticleSoA *particles, float dt) {
+    if (!lattice || !particles) return;
+
+    for (int i = 0; i < particles->count; i++) {
+        lattice_sample_one(lattice, particles->x[i], particles->y[i],
+                           &particles->vx[i], &particles->vy[i], dt);
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+/* Eight particles per iteration, four gathers per component */
+LATTICE_TARGET_AVX2
+static void avx2_sample(const FieldLattice *lattice, ParticleSoA *particles, float dt) {
+    const __m256 inv = _mm256_set1_ps(lattice->inv_spacing);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 max_gx = _mm256_set1_ps((float)lattice->cols);
+    const __m256 max_gy = _mm256_set1_ps((float)lattice->rows);
+    const __m256i max_i = _mm256_set1_epi32(lattice->cols - 1);
+    const __m256i max_j = _mm256_set1_epi32(lattice->rows - 1);
+    const __m256i stride = _mm256_set1_epi32(lattice->stride);
+    const __m256 dt_vec = _mm256_set1_ps(dt);
+    const int s = lattice->stride;
+    const float *ax = lattice->ax, *ay = lattice->ay;
+
+    float *px = particles->x, *py = particles->y;
+    float *pvx = particles->vx, *pvy = particles->vy;
+    const int vectorized_count = particles->count & ~7;
+    int k = 0;
+
+    for (; k < vectorized_count; k += 8) {
+        /* max returns its second operand for NaN, as the scalar clamp does */
+        __m256 gx = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(px + k), inv), zero), max_gx);
+        __m256 gy = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(py + k), inv), zero), max_gy);
+        __m256i i = _mm256_min_epi32(_mm256_cvttps_epi32(gx), max_i);
+        __m256i j = _mm256_min_epi32(_mm256_cvttps_epi32(gy), max_j);
+        __m256 t = _mm256_sub_ps(gx, _mm256_cvtepi32_ps(i));
+        __m256 u = _mm256_sub_ps(gy, _mm256_cvtepi32_ps(j));
+        __m256i n = _mm256_add_epi32(_mm256_mullo_epi32(j, stride), i);
+
+        __m256 a00 = _mm256_i32gather_ps(ax, n, 4);
+        __m256 a10 = _mm256_i32gather_ps(ax + 1, n, 4);
+        __m256 a01 = _mm256_i32gather_ps(ax + s, n, 4);
+        __m256 a11 = _mm256_i32gather_ps(ax + s + 1, n, 4);
+        __m256 top = _mm256_add_ps(a00, _mm256_mul_ps(_mm256_sub_ps(a10, a00), t));
+        __m256 bottom = _mm256_add_ps(a01, _mm256_mul_ps(_mm256_sub_ps(a11, a01), t));
+        __m256 accel = _mm256_add_ps(top, _mm256_mul_ps(_mm256_sub_ps(bottom, top), u));
+        _mm256_storeu_ps(pvx + k, _mm256_add_ps(_mm256_loadu_ps(pvx + k), _mm256_mul_ps(accel, dt_vec)));
+
+        a00 = _mm256_i32gather_ps(ay, n, 4);
+        a10 = _mm256_i32gather_ps(ay + 1, n, 4);
+        a01 = _mm256_i32gather_ps(ay + s, n, 4);
+        a11 = _mm256_i32gather_ps(ay + s + 1, n, 4);
+        top = _mm256_add_ps(a00, _mm256_mul_ps(_mm256_sub_ps(a10, a00), t));
+        bottom = _mm256_add_ps(a01, _mm256_mul_ps(_mm256_sub_ps(a11, a01), t));
+        accel = _mm256_add_ps(top, _mm256_mul_ps(_mm256_sub_ps(bottom, top), u));
+        _mm256_storeu_ps(pvy + k, _mm256_add_ps(_mm256_loadu_ps(pvy + k), _mm256_mul_ps(accel, dt_vec)));
+    }
+
+    for (; k < particles->count; k++) {
+        lattice_sample_one(lattice, px[k], py[k], &pvx[k], &pvy[k], dt);
+    }
+}
+
+/* Sixteen particles per iteration with a masked tail */
+LATTICE_TARGET_AVX512
+static void avx512_sample(const FieldLattice *lattice, ParticleSoA *particles, float dt) {
+    const __m512 inv = _mm512_set1_ps(lattice->inv_spacing);
+    const __m512 zero = _mm512_setzero_ps();
+    const __m512 max_gx = _mm512_set1_ps((float)lattice->cols);
+    const __m512 max_gy = _mm512_set1_ps((float)lattice->rows);
+    const __m512i max_i = _mm512_set1_epi32(lattice->cols - 1);
+    const __m512i max_j = _mm512_set1_epi32(lattice->rows - 1);
+    const __m512i stride = _mm512_set1_epi32(lattice->stride);
+    const __m512 dt_vec = _mm512_set1_ps(dt);
+    const int s = lattice->stride;
+    const float *ax = lattice->ax, *ay = lattice->ay;
+
+    float *px = particles->x, *py = particles->y;
+    float *pvx = particles->vx, *pvy = particles->vy;
+    const int count = particles->count;
+
+    for (int k = 0; k < count; k += 16) {
+        int remaining = count - k;
+        __mmask16 valid = remaining >= 16 ? (__mmask16)0xFFFF : (__mmask16)((1u << remaining) - 1);
+
+        /* Inactive lanes load 0 and sample node 0, which always exists */
+        __m512 gx = _mm512_min_ps(_mm512_max_ps(_mm512_mul_ps(_mm512_maskz_loadu_ps(valid, px + k), inv), zero), max_gx);
+        __m512 gy = _mm512_min_ps(_mm512_max_ps(_mm512_mul_ps(_mm512_maskz_loadu_ps(valid, py + k), inv), zero), max_gy);
+        __m512i i = _mm512_min_epi32(_mm512_cvttps_epi32(gx), max_i);
+        __m512i j = _mm512_min_epi32(_mm512_cvttps_epi32(gy), max_j);
+        __m512 t = _mm512_sub_ps(gx, _mm512_cvtepi32_ps(i));
+        __m512 u = _mm512_sub_ps(gy, _mm512_cvtepi32_ps(j));
+        __m512i n = _mm512_add_epi32(_mm512_mullo_epi32(j, stride), i);
+
+        __m512 a00 = _mm512_i32gather_ps(n, ax, 4);
+        __m512 a10 = _mm512_i32gather_ps(n, ax + 1, 4);
+        __m512 a01 = _mm512_i32gather_ps(n, ax + s, 4);
+        __m512 a11 = _mm512_i32gather_ps(n, ax + s + 1, 4);
+        __m512 top = _mm512_add_ps(a00, _mm512_mul_ps(_mm512_sub_ps(a10, a00), t));
+        __m512 bottom = _mm512_add_ps(a01, _mm512_mul_ps(_mm512_sub_ps(a11, a01), t));
+        __m512 accel = _mm512_add_ps(top, _mm512_mul_ps(_mm512_sub_ps(bottom, top), u));
+        __m512 vx = _mm512_maskz_loadu_ps(valid, pvx + k);
+        _mm512_mask_storeu_ps(pvx + k, valid, _mm512_add_ps(vx, _mm512_mul_ps(accel, dt_vec)));
+
+        a00 = _mm512_i32gather_ps(n, ay, 4);
+        a10 = _mm512_i32gather_ps(n, ay + 1, 4);
+        a01 = _mm512_i32gather_ps(n, ay + s, 4);
+        a11 = _mm512_i32gather_ps(n, ay + s + 1, 4);
+        top = _mm512_add_ps(a00, _mm512_mul_ps(_mm512_sub_ps(a10, a00), t));
+        bottom = _mm512_add_ps(a01, _mm512_mul_ps(_mm512_sub_ps(a11, a01), t));
+        accel = _mm512_add_ps(top, _mm512_mul_ps(_mm512_sub_ps(bottom, top), u));
+        __m512 vy = _mm512_maskz_loadu_ps(valid, pvy + k);
+        _mm512_mask_storeu_ps(pvy + k, valid, _mm512_add_ps(vy, _mm512_mul_ps(accel, dt_vec)));
+    }
+}
+#endif
+
+/* AVX2 sampling */
+void field_lattice_sample_avx2(const FieldLattice *lattice, ParticleSoA *particles, float dt) {
+    #if defined(__x86_64__) || defined(__i386__)
+    if (!lattice || !particles) return;
+    avx2_sample(lattice, particles, dt);
+    #else
+    field_lattice_sample_scalar(lattice, particles, dt);
+    #endif
+}
+
+/* AVX-512 sampling */
+void field_lattice_sample_avx512(const FieldLattice *lattice, ParticleSoA *particles, float dt) {
+    #if defined(__x86_64__) || defined(__i386__)
+    if (!lattice || !particles) return;
+    avx512_sample(lattice, particles, dt);
+    #else
+    field_lattice_sample_scalar(lattice, particles, dt);
+    #endif
+}
+
+/* ===== ERROR-AWARE LATTICE FUNCTIONS ===== */
+
+/* Create a lattice with error handling */
+Error field_lattice_create_with_error(int world_width, int world_height, float spacing,
+                                      FieldLattice **lattice_out) {
+    ERROR_CHECK_NULL(lattice_out, "Field lattice output pointer");
+    ERROR_CHECK_CONDITION(world_width > 0 && world_height > 0, ERROR_INVALID_PARAMETER,
+                          "World size must be positive");
+
+    FieldLattice *lattice = field_lattice_create(world_width, world_height, spacing);
+    if (!lattice) {
+        return ERROR_CREATE(ERROR_MEMORY_ALLOCATION, "Failed to allocate field lattice");
+    }
+
+    *lattice_out = lattice;
+    return (Error){SUCCESS, NULL, NULL, 0, NULL};
+}
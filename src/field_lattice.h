@@ -0,0 +1,80 @@
+#ifndef FIELD_LATTICE_H
+#define FIELD_LATTICE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "particle.h"
+#include "error.h"
+#include "physics.h"
+
+/**
+ * Baked Force-Field Lattice
+ *
+ * Evaluating every force field for every particle costs O(fields) per
+ * particle. For fields that rarely change, their summed acceleration is
+ * instead rasterized once onto a lattice of nodes spaced `spacing` apart,
+ * and particles take a bilinear sample of the four surrounding nodes:
+ * O(1) per particle however many fields there are.
+ *
+ * Node (i, j) sits at (i * spacing, j * spacing); the lattice covers the
+ * world with cols x rows cells, so it has (cols + 1) x (rows + 1) nodes.
+ * Positions outside it sample the nearest edge.
+ *
+ * Sampling smooths the fields over one cell: sharp radius cutoffs and the
+ * singularity guards near field centers are blurred, so pick a spacing
+ * well below the smallest field radius.
+ */
+
+/* Node spacing used when none is given (world units) */
+#define FIELD_LATTICE_DEFAULT_SPACING 1.0f
+
+/* Lattice */
+typedef struct {
+    int cols, rows;            /* Cells; nodes are (cols + 1) x (rows + 1) */
+    int stride;                /* Nodes per row (cols + 1) */
+    int num_nodes;             /* Total nodes */
+    float spacing;             /* Distance between neighbouring nodes */
+    float inv_spacing;         /* 1 / spacing */
+    float *node_x, *node_y;    /* Node positions */
+    float *ax, *ay;            /* Summed field acceleration at each node */
+    uint64_t bakes;            /* Times the fields were rasterized */
+} FieldLattice;
+
+/* Sampling kernel: adds dt * sampled acceleration to every velocity */
+typedef void (*field_lattice_sample_func_t)(const FieldLattice *lattice, ParticleSoA *particles,
+                                            float dt);
+
+/**
+ * Create a lattice covering a world
+ *
+ * @param world_width World width in simulation units
+ * @param world_height World height in simulation units
+ * @param spacing Node spacing (<= 0 = FIELD_LATTICE_DEFAULT_SPACING)
+ * @return New lattice with zero acceleration, or NULL on error
+ */
+FieldLattice *field_lattice_create(int world_width, int world_height, float spacing);
+void field_lattice_destroy(FieldLattice *lattice);
+
+/**
+ * Rasterize the summed acceleration of the active fields onto the nodes
+ * (uses the dispatched force-field pass)
+ */
+Error field_lattice_bake(FieldLattice *lattice, ForceField *fields, int num_fields);
+
+/**
+ * Bilinearly sample the lattice at each particle and add dt times the
+ * acceleration to its velocity
+ *
+ * Vector kernels gather the four nodes per lane and use the scalar
+ * operation order without FMA, so every tier matches scalar exactly.
+ * (They fall back to scalar when built for another architecture.)
+ */
+void field_lattice_sample_scalar(const FieldLattice *lattice, ParticleSoA *particles, float dt);
+void field_lattice_sample_avx2(const FieldLattice *lattice, ParticleSoA *particles, float dt);
+void field_lattice_sample_avx512(const FieldLattice *lattice, ParticleSoA *particles, float dt);
+
+/* Error-aware lattice functions */
+Error field_lattice_create_with_error(int world_width, int world_height, float spacing,
+                                      FieldLattice **lattice_out);
+
+#endif /* FIELD_LATTICE_H */
@@ -312,30 +312,27 @@ int main(int argc, char *argv[]) {
         /* Clear renderer */
         renderer_clear(renderer);
         
-        /* Render all particles with optimized loop */
-        int particle_count = sim_get_particle_count(sim);
-        for (int i = 0; i < particle_count; i++) {
-            const Particle *p = sim_get_particle(sim, i);
-            if (p) {
-                int x = (int)roundf(p->x);
-                int y = (int)roundf(p->y);
-                
-                /* Bounds checking for performance */
-                if (x < 0 || x >= width || y < 0 || y >= height) continue;
-                
-                /* Choose glyph based on speed */
-                float speed = sim_get_particle_speed(p);
-                char glyph;
-                if (speed < 5.0f) glyph = '.';
-                else if (speed < 15.0f) glyph = '*';
-                else glyph = '+';
-                
-                /* Get color based on speed */
-                uint32_t color = sim_speed_to_color(speed);
-                
-                /* Plot particle */
-                renderer_plot(renderer, x, y, glyph, color);
-            }
+        /* Render all particles straight from the simulation's columns */
+        ParticleSoA view = sim_get_particle_view(sim);
+        for (int i = 0; i < view.count; i++) {
+            int x = (int)roundf(view.x[i]);
+            int y = (int)roundf(view.y[i]);
+            
+            /* Bounds checking for performance */
+            if (x < 0 || x >= width || y < 0 || y >= height) continue;
+            
+            /* Choose glyph based on speed */
+            float speed = sqrtf(view.vx[i] * view.vx[i] + view.vy[i] * view.vy[i]);
+            char glyph;
+            if (speed < 5.0f) glyph = '.';
+            else if (speed < 15.0f) glyph = '*';
+            else glyph = '+';
+            
+            /* Get color based on speed */
+            uint32_t color = sim_speed_to_color(speed);
+            
+            /* Plot particle */
+            renderer_plot(renderer, x, y, glyph, color);
         }
         
         /* Render HUD if enabled */
@@ -355,7 +352,7 @@ int main(int argc, char *argv[]) {
             char perf_text[128];
             snprintf(perf_text, sizeof(perf_text), 
                     "FPS: %.1f/%d | Particles: %d/%d | Frame: %d", 
-                    current_fps, config.target_fps, particle_count, config.max_particles, frames);
+                    current_fps, config.target_fps, view.count, config.max_particles, frames);
             renderer_draw_text(renderer, 0, 1, perf_text, rgb_to_color(200, 200, 200));
             
             /* Physics parameters */
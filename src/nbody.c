@@ -0,0 +1,715 @@
+#include "nbody.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/* Traversal stack: each of the at most 17 levels leaves at most 3
+ * unvisited siblings behind, plus the up to 4 children just pushed */
+#define NBODY_STACK_DEPTH 64
+
+/* Particles per traversal chunk */
+#define NBODY_TRAVERSAL_GRAIN 256
+
+/* Helper: Make room for count particles (contents are rebuilt afterwards) */
+static bool nbody_reserve(NBodyTree *tree, int count) {
+    if (count <= tree->capacity) {
+        return true;
+    }
+
+    int new_capacity = tree->capacity > 0 ? tree->capacity : 1024;
+    while (new_capacity < count) {
+        new_capacity *= 2;
+    }
+
+    size_t n = (size_t)new_capacity;
+    NBodyNode *nodes = malloc(sizeof(NBodyNode) * 2 * n);
+    uint32_t *keys = malloc(sizeof(uint32_t) * n);
+    uint32_t *scratch_keys = malloc(sizeof(uint32_t) * n);
+    int *order = malloc(sizeof(int) * n);
+    int *scratch_order = malloc(sizeof(int) * n);
+    float *sorted_x = malloc(sizeof(float) * n);
+    float *sorted_y = malloc(sizeof(float) * n);
+    float *accel_x = malloc(sizeof(float) * n);
+    float *accel_y = malloc(sizeof(float) * n);
+    if (!nodes || !keys || !scratch_keys || !order || !scratch_order ||
+        !sorted_x || !sorted_y || !accel_x || !accel_y) {
+        free(nodes);
+        free(keys);
+        free(scratch_keys);
+        free(order);
+        free(scratch_order);
+        free(sorted_x);
+        free(sorted_y);
+        free(accel_x);
+        free(accel_y);
+        return false;
+    }
+
+    free(tree->nodes);
+    free(tree->keys);
+    free(tree->scratch_keys);
+    free(tree->order);
+    free(tree->scratch_order);
+    free(tree->sorted_x);
+    free(tree->sorted_y);
+    free(tree->accel_x);
+    free(tree->accel_y);
+    tree->nodes = nodes;
+    tree->keys = keys;
+    tree->scratch_keys = scratch_keys;
+    tree->order = order;
+    tree->scratch_order = scratch_order;
+    tree->sorted_x = sorted_x;
+    tree->sorted_y = sorted_y;
+    tree->accel_x = accel_x;
+    tree->accel_y = accel_y;
+    tree->capacity = new_capacity;
+    return true;
+}
+
+/* Helper: Make room for the per-block sort histograms and bounds */
+static bool nbody_reserve_blocks(NBodyTree *tree, int blocks) {
+    if (blocks <= tree->block_capacity) {
+        return true;
+    }
+
+    int *histograms = malloc(sizeof(int) * 256 * (size_t)blocks);
+    float *block_bounds = malloc(sizeof(float) * 4 * (size_t)blocks);
+    if (!histograms || !block_bounds) {
+        free(histograms);
+        free(block_bounds);
+        return false;
+    }
+
+    free(tree->histograms);
+    free(tree->block_bounds);
+    tree->histograms = histograms;
+    tree->block_bounds = block_bounds;
+    tree->block_capacity = blocks;
+    return true;
+}
+
+/* Helper: Append one entry to a growable int list */
+static bool nbody_push(int **list, int *capacity, int size, int value) {
+    if (size >= *capacity) {
+        int new_capacity = *capacity > 0 ? *capacity * 2 : 256;
+        int *grown = realloc(*list, sizeof(int) * (size_t)new_capacity);
+        if (!grown) {
+            return false;
+        }
+        *list = grown;
+        *capacity = new_capacity;
+    }
+    (*list)[size] = value;
+    return true;
+}
+
+/* Create an empty tree with room for capacity particles */
+NBodyTree *nbody_tree_create(int capacity) {
+    if (capacity < 0) {
+        return NULL;
+    }
+
+    NBodyTree *tree = calloc(1, sizeof(NBodyTree));
+    if (!tree) {
+        return NULL;
+    }
+    tree->root = -1;
+
+    if (capacity > 0 && !nbody_reserve(tree, capacity)) {
+        free(tree);
+        return NULL;
+    }
+    return tree;
+}
+
+/* Destroy a tree and its buffers */
+void nbody_tree_destroy(NBodyTree *tree) {
+    if (!tree) return;
+
+    free(tree->nodes);
+    free(tree->keys);
+    free(tree->scratch_keys);
+    free(tree->order);
+    free(tree->scratch_order);
+    free(tree->sorted_x);
+    free(tree->sorted_y);
+    free(tree->accel_x);
+    free(tree->accel_y);
+    free(tree->histograms);
+    free(tree->block_bounds);
+    free(tree->tasks);
+    free(tree->top);
+    free(tree);
+}
+
+/* ===== TREE BUILD ===== */
+
+/* Shared state for the parallel build passes */
+typedef struct {
+    NBodyTree *tree;
+    const ParticleSoA *particles;
+    int blocks;                /* Particle blocks (one histogram row each) */
+    int block_size;            /* Particles per block */
+    float scale;               /* Key units per world unit */
+    int shift;                 /* Digit of the current radix pass */
+    const uint32_t *src_keys;  /* Radix pass input */
+    const int *src_order;
+    uint32_t *dst_keys;        /* Radix pass output */
+    int *dst_order;
+    int nodes;                 /* Nodes created by the subtree tasks */
+} NBodyBuildJob;
+
+/* Helper: Particle range of one block */
+static inline void nbody_block_range(const NBodyBuildJob *job, int b, int *first, int *last) {
+    *first = b * job->block_size;
+    *last = *first + job->block_size < job->tree->count ? *first + job->block_size : job->tree->count;
+}
+
+/* Spread the low 16 bits of v to the even bit positions */
+static inline uint32_t nbody_spread_bits(uint32_t v) {
+    v &= 0xFFFFu;
+    v = (v | (v << 8)) & 0x00FF00FFu;
+    v = (v | (v << 4)) & 0x0F0F0F0Fu;
+    v = (v | (v << 2)) & 0x33333333u;
+    v = (v | (v << 1)) & 0x55555555u;
+    return v;
+}
+
+/* Helper: Quantize one coordinate into 16 key bits (non-finite = 0) */
+static inline uint32_t nbody_quantize(float offset, float scale) {
+    float q = offset * scale;
+    if (!(q >= 0.0f)) return 0;
+    if (q > 65535.0f) return 65535;
+    return (uint32_t)q;
+}
+
+/* Bounding box of the finite positions in each block */
+static void nbody_block_bounds(void *ctx, int begin, int end, int worker_id) {
+    NBodyBuildJob *job = (NBodyBuildJob *)ctx;
+    const ParticleSoA *particles = job->particles;
+    (void)worker_id;
+
+    for (int b = begin; b < end; b++) {
+        int first, last;
+        nbody_block_range(job, b, &first, &last);
+
+        float min_x = INFINITY, min_y = INFINITY, max_x = -INFINITY, max_y = -INFINITY;
+        for (int i = first; i < last; i++) {
+            float x = particles->x[i], y = particles->y[i];
+            if (!isfinite(x) || !isfinite(y)) continue;
+            min_x = fminf(min_x, x);
+            min_y = fminf(min_y, y);
+            max_x = fmaxf(max_x, x);
+            max_y = fmaxf(max_y, y);
+        }
+
+        float *bounds = job->tree->block_bounds + 4 * (size_t)b;
+        bounds[0] = min_x;
+        bounds[1] = min_y;
+        bounds[2] = max_x;
+        bounds[3] = max_y;
+    }
+}
+
+/* Morton key of every particle in a block */
+static void nbody_block_keys(void *ctx, int begin, int end, int worker_id) {
+    NBodyBuildJob *job = (NBodyBuildJob *)ctx;
+    NBodyTree *tree = job->tree;
+    const ParticleSoA *particles = job->particles;
+    (void)worker_id;
+
+    for (int b = begin; b < end; b++) {
+        int first, last;
+        nbody_block_range(job, b, &first, &last);
+
+        for (int i = first; i < last; i++) {
+            uint32_t qx = nbody_quantize(particles->x[i] - tree->min_x, job->scale);
+            uint32_t qy = nbody_quantize(particles->y[i] - tree->min_y, job->scale);
+            tree->keys[i] = nbody_spread_bits(qx) | (nbody_spread_bits(qy) << 1);
+            tree->order[i] = i;
+        }
+    }
+}
+
+/* Count one radix digit over a block into its own histogram row */
+static void nbody_radix_histogram(void *ctx, int begin, int end, int worker_id) {
+    NBodyBuildJob *job = (NBodyBuildJob *)ctx;
+    (void)worker_id;
+
+    for (int b = begin; b < end; b++) {
+        int first, last;
+        nbody_block_range(job, b, &first, &last);
+
+        int *histogram = job->tree->histograms + 256 * (size_t)b;
+        memset(histogram, 0, sizeof(int) * 256);
+        for (int i = first; i < last; i++) {
+            histogram[(job->src_keys[i] >> job->shift) & 0xFFu]++;
+        }
+    }
+}
+
+/* Scatter a block to its digit offsets; blocks are in order, so the sort is stable */
+static void nbody_radix_scatter(void *ctx, int begin, int end, int worker_id) {
+    NBodyBuildJob *job = (NBodyBuildJob *)ctx;
+    (void)worker_id;
+
+    for (int b = begin; b < end; b++) {
+        int first, last;
+        nbody_block_range(job, b, &first, &last);
+
+        int *offsets = job->tree->histograms + 256 * (size_t)b;
+        for (int i = first; i < last; i++) {
+            uint32_t key = job->src_keys[i];
+            int pos = offsets[(key >> job->shift) & 0xFFu]++;
+            job->dst_keys[pos] = key;
+            job->dst_order[pos] = job->src_order[i];
+        }
+    }
+}
+
+/* Copy positions into key order */
+static void nbody_block_gather(void *ctx, int begin, int end, int worker_id) {
+    NBodyBuildJob *job = (NBodyBuildJob *)ctx;
+    NBodyTree *tree = job->tree;
+    (void)worker_id;
+
+    for (int b = begin; b < end; b++) {
+        int first, last;
+        nbody_block_range(job, b, &first, &last);
+
+        for (int k = first; k < last; k++) {
+            tree->sorted_x[k] = job->particles->x[tree->order[k]];
+            tree->sorted_y[k] = job->particles->y[tree->order[k]];
+        }
+    }
+}
+
+/* Helper: Stable LSD radix sort of keys and order, 8 bits a pass; passes
+ * where every key shares the digit are skipped */
+static void nbody_sort_keys(NBodyBuildJob *job, ThreadPool *pool) {
+    NBodyTree *tree = job->tree;
+
+    for (int shift = 0; shift < 32; shift += 8) {
+        job->shift = shift;
+        job->src_keys = tree->keys;
+        job->src_order = tree->order;
+        job->dst_keys = tree->scratch_keys;
+        job->dst_order = tree->scratch_order;
+        thread_pool_parallel_for(pool, job->blocks, 1, nbody_radix_histogram, job);
+
+        /* Exclusive scan, digit-major then block-major */
+        int running = 0;
+        bool uniform = false;
+        for (int digit = 0; digit < 256; digit++) {
+            int digit_start = running;
+            for (int b = 0; b < job->blocks; b++) {
+                int *slot = &tree->histograms[256 * (size_t)b + digit];
+                int count = *slot;
+                *slot = running;
+                running += count;
+            }
+            if (running - digit_start == tree->count) {
+                uniform = true;
+                break;
+            }
+        }
+        if (uniform) {
+            continue;
+        }
+
+        thread_pool_parallel_for(pool, job->blocks, 1, nbody_radix_scatter, job);
+
+        /* Output becomes the next pass's input */
+        uint32_t *keys = tree->keys;
+        int *order = tree->order;
+        tree->keys = tree->scratch_keys;
+        tree->order = tree->scratch_order;
+        tree->scratch_keys = keys;
+        tree->scratch_order = order;
+    }
+}
+
+/* Helper: First position in [begin, end) whose key is at least key */
+static inline int nbody_lower_bound(const uint32_t *keys, int begin, int end, uint32_t key) {
+    while (begin < end) {
+        int mid = begin + (end - begin) / 2;
+        if (keys[mid] < key) {
+            begin = mid + 1;
+        } else {
+            end = mid;
+        }
+    }
+    return begin;
+}
+
+/* Helper: Set up the node for [begin, end) at slot and split its range by
+ * the first key digit its particles differ in. Returns false for leaves,
+ * which get their mass and center of mass here; otherwise bounds[0..4]
+ * delimit the four child ranges. */
+static bool nbody_split_node(NBodyTree *tree, int begin, int end, int slot, int bounds[5]) {
+    NBodyNode *node = &tree->nodes[slot];
+    uint32_t first = tree->keys[begin];
+    uint32_t last = tree->keys[end - 1];
+    int level = first == last ? 16 : __builtin_clz(first ^ last) / 2;
+
+    node->begin = begin;
+    node->end = end;
+    node->size = ldexpf(tree->size, -level);
+    node->child[0] = node->child[1] = node->child[2] = node->child[3] = -1;
+
+    if (end - begin <= NBODY_LEAF_SIZE || first == last) {
+        float sum_x = 0.0f, sum_y = 0.0f;
+        for (int k = begin; k < end; k++) {
+            sum_x += tree->sorted_x[k];
+            sum_y += tree->sorted_y[k];
+        }
+        node->mass = (float)(end - begin);
+        node->com_x = sum_x / node->mass;
+        node->com_y = sum_y / node->mass;
+        return false;
+    }
+
+    /* Keys share the digits above level, so each child is one key interval */
+    int shift = 30 - 2 * level;
+    uint32_t prefix = (uint32_t)((uint64_t)first & ~((4ull << shift) - 1));
+    bounds[0] = begin;
+    for (int digit = 1; digit < 4; digit++) {
+        bounds[digit] = nbody_lower_bound(tree->keys, bounds[digit - 1], end,
+                                          prefix | ((uint32_t)digit << shift));
+    }
+    bounds[4] = end;
+    return true;
+}
+
+/* Helper: Mass and center of mass of an internal node from its children */
+static void nbody_aggregate(NBodyTree *tree, int slot) {
+    NBodyNode *node = &tree->nodes[slot];
+    float mass = 0.0f, moment_x = 0.0f, moment_y = 0.0f;
+
+    for (int c = 0; c < 4; c++) {
+        if (node->child[c] < 0) continue;
+        const NBodyNode *child = &tree->nodes[node->child[c]];
+        mass += child->mass;
+        moment_x += child->mass * child->com_x;
+        moment_y += child->mass * child->com_y;
+    }
+    node->mass = mass;
+    node->com_x = moment_x / mass;
+    node->com_y = moment_y / mass;
+}
+
+/* Build the subtree over [begin, end) rooted at slot. Children are laid
+ * out back to back after their parent, each in 2m - 1 slots for its m
+ * particles, so sibling subtrees never overlap. Returns nodes created. */
+static int nbody_build_subtree(NBodyTree *tree, int begin, int end, int slot) {
+    int bounds[5];
+    if (!nbody_split_node(tree, begin, end, slot, bounds)) {
+        return 1;
+    }
+
+    int created = 1;
+    int child_slot = slot + 1;
+    for (int c = 0; c < 4; c++) {
+        if (bounds[c] == bounds[c + 1]) continue;
+        tree->nodes[slot].child[c] = child_slot;
+        created += nbody_build_subtree(tree, bounds[c], bounds[c + 1], child_slot);
+        child_slot += 2 * (bounds[c + 1] - bounds[c]) - 1;
+    }
+    nbody_aggregate(tree, slot);
+    return created;
+}
+
+/* Build the top of the tree serially, leaving ranges of at most
+ * NBODY_PARALLEL_MIN_SUBTREE particles as tasks */
+static bool nbody_build_top(NBodyTree *tree, int begin, int end, int slot,
+                            int *num_tasks, int *num_top) {
+    if (end - begin <= NBODY_PARALLEL_MIN_SUBTREE) {
+        int size = 3 * *num_tasks;
+        if (!nbody_push(&tree->tasks, &tree->task_capacity, size, begin) ||
+            !nbody_push(&tree->tasks, &tree->task_capacity, size + 1, end) ||
+            !nbody_push(&tree->tasks, &tree->task_capacity, size + 2, slot)) {
+            return false;
+        }
+        (*num_tasks)++;
+        return true;
+    }
+
+    int bounds[5];
+    tree->stats.nodes++;
+    if (!nbody_split_node(tree, begin, end, slot, bounds)) {
+        return true;  /* Oversized leaf: every key equal */
+    }
+    if (!nbody_push(&tree->top, &tree->top_capacity, (*num_top)++, slot)) {
+        return false;
+    }
+
+    int child_slot = slot + 1;
+    for (int c = 0; c < 4; c++) {
+        if (bounds[c] == bounds[c + 1]) continue;
+        tree->nodes[slot].child[c] = child_slot;
+        if (!nbody_build_top(tree, bounds[c], bounds[c + 1], child_slot, num_tasks, num_top)) {
+            return false;
+        }
+        child_slot += 2 * (bounds[c + 1] - bounds[c]) - 1;
+    }
+    return true;
+}
+
+/* Build the subtrees left as tasks */
+static void nbody_build_tasks(void *ctx, int begin, int end, int worker_id) {
+    NBodyBuildJob *job = (NBodyBuildJob *)ctx;
+    NBodyTree *tree = job->tree;
+    (void)worker_id;
+
+    int created = 0;
+    for (int t = begin; t < end; t++) {
+        const int *task = tree->tasks + 3 * (size_t)t;
+        created += nbody_build_subtree(tree, task[0], task[1], task[2]);
+    }
+    __atomic_fetch_add(&job->nodes, created, __ATOMIC_RELAXED);
+}
+
+/* Build the quadtree over the current positions */
+Error nbody_tree_build(NBodyTree *tree, const ParticleSoA *particles, ThreadPool *pool) {
+    ERROR_CHECK_NULL(tree, "N-body tree");
+    ERROR_CHECK_NULL(particles, "Particle columns");
+    ERROR_CHECK_CONDITION(particles->count >= 0, ERROR_INVALID_PARAMETER,
+                          "Particle count must be non-negative");
+
+    int count = particles->count;
+    int workers = pool ? thread_pool_get_thread_count(pool) : 1;
+    int blocks = count >= NBODY_PARALLEL_MIN_SUBTREE && workers > 1 ? workers : 1;
+
+    if (!nbody_reserve(tree, count) || !nbody_reserve_blocks(tree, blocks)) {
+        return ERROR_CREATE(ERROR_MEMORY_ALLOCATION, "Failed to expand N-body tree");
+    }
+
+    tree->count = count;
+    tree->root = -1;
+    tree->stats.builds++;
+    tree->stats.nodes = 0;
+    tree->stats.subtrees = 0;
+    if (count == 0) {
+        return (Error){SUCCESS};
+    }
+
+    NBodyBuildJob job;
+    memset(&job, 0, sizeof(job));
+    job.tree = tree;
+    job.particles = particles;
+    job.blocks = blocks;
+    job.block_size = (count + blocks - 1) / blocks;
+
+    /* Bounding square of the finite positions */
+    thread_pool_parallel_for(pool, blocks, 1, nbody_block_bounds, &job);
+    float min_x = INFINITY, min_y = INFINITY, max_x = -INFINITY, max_y = -INFINITY;
+    for (int b = 0; b < blocks; b++) {
+        const float *bounds = tree->block_bounds + 4 * (size_t)b;
+        min_x = fminf(min_x, bounds[0]);
+        min_y = fminf(min_y, bounds[1]);
+        max_x = fmaxf(max_x, bounds[2]);
+        max_y = fmaxf(max_y, bounds[3]);
+    }
+    if (min_x > max_x) {
+        min_x = min_y = max_x = max_y = 0.0f;  /* No finite position */
+    }
+    float size = fmaxf(max_x - min_x, max_y - min_y);
+    tree->min_x = min_x;
+    tree->min_y = min_y;
+    tree->size = size > 0.0f ? size : 1.0f;
+    job.scale = 65536.0f / tree->size;
+
+    thread_pool_parallel_for(pool, blocks, 1, nbody_block_keys, &job);
+    nbody_sort_keys(&job, pool);
+    thread_pool_parallel_for(pool, blocks, 1, nbody_block_gather, &job);
+
+    /* Serial top levels, then independent subtrees, then the top levels'
+     * mass bottom-up (reverse pre-order visits children first) */
+    int num_tasks = 0, num_top = 0;
+    if (!nbody_build_top(tree, 0, count, 0, &num_tasks, &num_top)) {
+        return ERROR_CREATE(ERROR_MEMORY_ALLOCATION, "Failed to expand N-body tree");
+    }
+    thread_pool_parallel_for(pool, num_tasks, 1, nbody_build_tasks, &job);
+    for (int t = num_top - 1; t >= 0; t--) {
+        nbody_aggregate(tree, tree->top[t]);
+    }
+
+    tree->root = 0;
+    tree->stats.nodes += job.nodes;
+    tree->stats.subtrees = num_tasks;
+    return (Error){SUCCESS};
+}
+
+/* ===== FORCE EVALUATION ===== */
+
+/* Shared state for the traversal */
+typedef struct {
+    const NBodyTree *tree;
+    const ParticleSoA *particles;  /* Brute force only */
+    float theta_sq;
+    float softening_sq;
+    float g;
+    float *accel_x, *accel_y;
+} NBodyForceJob;
+
+/* Helper: Add one softened body's pull on a particle */
+static inline void nbody_accumulate(float dx, float dy, float mass, float softening_sq,
+                                    float *ax, float *ay) {
+    float r2 = dx * dx + dy * dy + softening_sq;
+    if (r2 > 0.0f) {
+        float inv_r = 1.0f / sqrtf(r2);
+        float s = mass * inv_r * inv_r * inv_r;
+        *ax += dx * s;
+        *ay += dy * s;
+    }
+}
+
+/* Walk the tree for a run of particles in key order */
+static void nbody_traverse_chunk(void *ctx, int begin, int end, int worker_id) {
+    NBodyForceJob *job = (NBodyForceJob *)ctx;
+    const NBodyTree *tree = job->tree;
+    const NBodyNode *nodes = tree->nodes;
+    (void)worker_id;
+
+    int stack[NBODY_STACK_DEPTH];
+    for (int k = begin; k < end; k++) {
+        float px = tree->sorted_x[k], py = tree->sorted_y[k];
+        float ax = 0.0f, ay = 0.0f;
+        int top = 0;
+        stack[top++] = tree->root;
+
+        while (top > 0) {
+            const NBodyNode *node = &nodes[stack[--top]];
+
+            /* Leaves have every child at -1, so the AND keeps the sign bit */
+            if ((node->child[0] & node->child[1] & node->child[2] & node->child[3]) < 0) {
+                for (int j = node->begin; j < node->end; j++) {
+                    nbody_accumulate(tree->sorted_x[j] - px, tree->sorted_y[j] - py, 1.0f,
+                                     job->softening_sq, &ax, &ay);
+                }
+                continue;
+            }
+
+            float dx = node->com_x - px, dy = node->com_y - py;
+            if (node->size * node->size < job->theta_sq * (dx * dx + dy * dy)) {
+                nbody_accumulate(dx, dy, node->mass, job->softening_sq, &ax, &ay);
+                continue;
+            }
+            for (int c = 3; c >= 0; c--) {
+                if (node->child[c] >= 0) {
+                    stack[top++] = node->child[c];
+                }
+            }
+        }
+
+        int i = tree->order[k];
+        job->accel_x[i] = job->g * ax;
+        job->accel_y[i] = job->g * ay;
+    }
+}
+
+/* Direct sum over every particle for a run of particles */
+static void nbody_brute_chunk(void *ctx, int begin, int end, int worker_id) {
+    NBodyForceJob *job = (NBodyForceJob *)ctx;
+    const ParticleSoA *particles = job->particles;
+    (void)worker_id;
+
+    for (int i = begin; i < end; i++) {
+        float px = particles->x[i], py = particles->y[i];
+        float ax = 0.0f, ay = 0.0f;
+        for (int j = 0; j < particles->count; j++) {
+            nbody_accumulate(particles->x[j] - px, particles->y[j] - py, 1.0f,
+                             job->softening_sq, &ax, &ay);
+        }
+        job->accel_x[i] = job->g * ax;
+        job->accel_y[i] = job->g * ay;
+    }
+}
+
+/* Helper: Validate settings and fill the shared force parameters */
+static Error nbody_force_job(NBodyForceJob *job, const NBodySettings *settings,
+                             float *accel_x, float *accel_y) {
+    ERROR_CHECK_NULL(settings, "N-body settings");
+    ERROR_CHECK_NULL(accel_x, "Acceleration output");
+    ERROR_CHECK_NULL(accel_y, "Acceleration output");
+    ERROR_CHECK_CONDITION(settings->theta >= 0.0f, ERROR_INVALID_PARAMETER,
+                          "Opening angle must be non-negative");
+    ERROR_CHECK_CONDITION(settings->softening >= 0.0f, ERROR_INVALID_PARAMETER,
+                          "Softening must be non-negative");
+
+    job->theta_sq = settings->theta * settings->theta;
+    job->softening_sq = settings->softening * settings->softening;
+    job->g = settings->gravity_constant;
+    job->accel_x = accel_x;
+    job->accel_y = accel_y;
+    return (Error){SUCCESS};
+}
+
+/* Barnes-Hut accelerations from a built tree */
+Error nbody_compute_accelerations(const NBodyTree *tree, const NBodySettings *settings,
+                                  float *accel_x, float *accel_y, ThreadPool *pool) {
+    ERROR_CHECK_NULL(tree, "N-body tree");
+
+    NBodyForceJob job = { tree, NULL, 0.0f, 0.0f, 0.0f, NULL, NULL };
+    Error err = nbody_force_job(&job, settings, accel_x, accel_y);
+    if (err.code != SUCCESS) {
+        return err;
+    }
+    if (tree->root < 0) {
+        return (Error){SUCCESS};
+    }
+
+    thread_pool_parallel_for(pool, tree->count, NBODY_TRAVERSAL_GRAIN, nbody_traverse_chunk, &job);
+    return (Error){SUCCESS};
+}
+
+/* Reference direct sum */
+Error nbody_compute_accelerations_brute(const ParticleSoA *particles, const NBodySettings *settings,
+                                        float *accel_x, float *accel_y, ThreadPool *pool) {
+    ERROR_CHECK_NULL(particles, "Particle columns");
+
+    NBodyForceJob job = { NULL, particles, 0.0f, 0.0f, 0.0f, NULL, NULL };
+    Error err = nbody_force_job(&job, settings, accel_x, accel_y);
+    if (err.code != SUCCESS) {
+        return err;
+    }
+
+    thread_pool_parallel_for(pool, particles->count, 16, nbody_brute_chunk, &job);
+    return (Error){SUCCESS};
+}
+
+/* Build, evaluate and kick velocities */
+Error nbody_apply_gravity(NBodyTree *tree, ParticleSoA *particles, const NBodySettings *settings,
+                          float dt, ThreadPool *pool) {
+    Error err = nbody_tree_build(tree, particles, pool);
+    if (err.code != SUCCESS) {
+        return err;
+    }
+    err = nbody_compute_accelerations(tree, settings, tree->accel_x, tree->accel_y, pool);
+    if (err.code != SUCCESS) {
+        return err;
+    }
+
+    for (int i = 0; i < particles->count; i++) {
+        particles->vx[i] += tree->accel_x[i] * dt;
+        particles->vy[i] += tree->accel_y[i] * dt;
+    }
+    return (Error){SUCCESS};
+}
+
+/* ===== ERROR-AWARE N-BODY FUNCTIONS ===== */
+
+/* Create a tree with error handling */
+Error nbody_tree_create_with_error(int capacity, NBodyTree **tree_out) {
+    ERROR_CHECK_NULL(tree_out, "N-body tree output pointer");
+    ERROR_CHECK_CONDITION(capacity >= 0, ERROR_INVALID_PARAMETER, "Capacity must be non-negative");
+
+    NBodyTree *tree = nbody_tree_create(capacity);
+    if (!tree) {
+        return ERROR_CREATE(ERROR_MEMORY_ALLOCATION, "Failed to allocate N-body tree");
+    }
+
+    *tree_out = tree;
+    return (Error){SUCCESS, NULL, NULL, 0, NULL};
+}
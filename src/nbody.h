@@ -0,0 +1,152 @@
+#ifndef NBODY_H
+#define NBODY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "particle.h"
+#include "error.h"
+#include "thread_pool.h"
+
+/**
+ * Barnes-Hut N-Body Gravity
+ *
+ * Every particle attracts every other with unit mass:
+ *   a_i = G * sum_j (p_j - p_i) / (|p_j - p_i|^2 + softening^2)^(3/2)
+ * Summed directly this is O(n²). Barnes-Hut instead builds a quadtree
+ * with each node's total mass and center of mass, and treats a whole node
+ * as one body once it looks small from the particle: side / distance <
+ * theta. Far-away clusters collapse into single terms, so a step costs
+ * O(n log n). theta = 0 opens every node and gives the direct sum.
+ *
+ * Build:
+ * - Particles get 32-bit Morton keys (16 bits per axis) inside the
+ *   bounding square, and a stable parallel LSD radix sort orders them
+ * - The tree is compressed: a node splits at the first key digit where
+ *   its particles differ, so every internal node has 2-4 children and a
+ *   tree over m particles fits in 2m - 1 node slots. Sibling subtrees
+ *   get fixed, disjoint slot ranges, so subtrees below the top levels are
+ *   built and aggregated in parallel with no shared counters
+ *
+ * Traversal walks particles in key order, so neighbouring particles open
+ * the same nodes, and splits them across the worker pool.
+ *
+ * All buffers belong to the tree and grow to the high-water mark, so
+ * steady-state frames do not touch the heap.
+ */
+
+/* Defaults */
+#define NBODY_DEFAULT_THETA 0.5f       /* Opening angle */
+#define NBODY_DEFAULT_G 1.0f           /* Gravitational constant (unit masses) */
+#define NBODY_DEFAULT_SOFTENING 1.0f   /* Softening length (world units) */
+
+/* Leaves hold at most this many particles (unless they share one key) */
+#define NBODY_LEAF_SIZE 8
+
+/* Below this many particles in a range, build the subtree as one task */
+#define NBODY_PARALLEL_MIN_SUBTREE 2048
+
+/* N-body settings */
+typedef struct {
+    float gravity_constant;    /* G */
+    float theta;               /* Opening angle (0 = exact direct sum) */
+    float softening;           /* Plummer softening length; keeps close pairs finite */
+} NBodySettings;
+
+/* Quadtree node */
+typedef struct {
+    float com_x, com_y;        /* Center of mass */
+    float mass;                /* Particles below this node */
+    float size;                /* Side of the node's square */
+    int child[4];              /* Child slots (-1 = none; all -1 for leaves) */
+    int begin, end;            /* Particle range in key order */
+} NBodyNode;
+
+/* Tree statistics */
+typedef struct {
+    uint64_t builds;           /* Trees built */
+    int nodes;                 /* Nodes in the last tree */
+    int subtrees;              /* Subtrees built as separate tasks */
+} NBodyStats;
+
+/* Tree and its reusable buffers */
+typedef struct {
+    NBodyNode *nodes;          /* 2 * count slots; unused slots are never linked */
+    int root;                  /* Root slot (-1 = empty tree) */
+    int count;                 /* Particles in the last build */
+    float min_x, min_y;        /* Bounding square corner */
+    float size;                /* Bounding square side */
+
+    uint32_t *keys;            /* Morton keys in sorted order */
+    int *order;                /* order[k] = particle at position k in key order */
+    float *sorted_x, *sorted_y; /* Positions in key order */
+    float *accel_x, *accel_y;  /* Accelerations from the last nbody_apply_gravity() */
+    uint32_t *scratch_keys;    /* Radix sort ping-pong buffers */
+    int *scratch_order;
+    int capacity;              /* Particles the arrays above hold */
+
+    int *histograms;           /* Radix sort: blocks x 256 digit counts */
+    float *block_bounds;       /* Bounding box of each block (4 floats per block) */
+    int block_capacity;        /* Blocks the two arrays above hold */
+
+    int *tasks;                /* Subtrees left for the workers (begin, end, slot) */
+    int task_capacity;
+    int *top;                  /* Slots built serially above the tasks, in pre-order */
+    int top_capacity;
+
+    NBodyStats stats;          /* Usage statistics */
+} NBodyTree;
+
+/* Default settings */
+static inline NBodySettings nbody_default_settings(void) {
+    NBodySettings settings = { NBODY_DEFAULT_G, NBODY_DEFAULT_THETA, NBODY_DEFAULT_SOFTENING };
+    return settings;
+}
+
+/* Tree management */
+NBodyTree *nbody_tree_create(int capacity);
+void nbody_tree_destroy(NBodyTree *tree);
+
+/**
+ * Build the quadtree over the current positions
+ *
+ * Key computation, sorting and subtree construction are split across
+ * pool (NULL = this thread); the tree is the same either way.
+ *
+ * @param tree N-body tree
+ * @param particles Particle columns
+ * @param pool Worker pool (may be NULL)
+ * @return Error status
+ */
+Error nbody_tree_build(NBodyTree *tree, const ParticleSoA *particles, ThreadPool *pool);
+
+/**
+ * Barnes-Hut accelerations from a tree built over the same positions
+ *
+ * @param tree Tree from nbody_tree_build()
+ * @param settings G, opening angle and softening
+ * @param accel_x Output, one entry per particle (particle order)
+ * @param accel_y Output, one entry per particle (particle order)
+ * @param pool Worker pool (may be NULL)
+ * @return Error status
+ */
+Error nbody_compute_accelerations(const NBodyTree *tree, const NBodySettings *settings,
+                                  float *accel_x, float *accel_y, ThreadPool *pool);
+
+/**
+ * Reference O(n²) direct sum with the same softened kernel, for
+ * validation and benchmarking
+ */
+Error nbody_compute_accelerations_brute(const ParticleSoA *particles, const NBodySettings *settings,
+                                        float *accel_x, float *accel_y, ThreadPool *pool);
+
+/**
+ * Build the tree, compute accelerations into tree->accel_x/accel_y and
+ * add dt times them to every velocity
+ */
+Error nbody_apply_gravity(NBodyTree *tree, ParticleSoA *particles, const NBodySettings *settings,
+                          float dt, ThreadPool *pool);
+
+/* Error-aware tree functions */
+Error nbody_tree_create_with_error(int capacity, NBodyTree **tree_out);
+
+#endif /* NBODY_H */
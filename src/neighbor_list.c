@@ -0,0 +1,215 @@
+#include "neighbor_list.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/* Helper: Make room for count particles (contents are rebuilt afterwards) */
+static bool neighbor_list_reserve(NeighborList *list, int count) {
+    if (count <= list->capacity) {
+        return true;
+    }
+
+    int new_capacity = list->capacity > 0 ? list->capacity : 1024;
+    while (new_capacity < count) {
+        new_capacity *= 2;
+    }
+
+    int *start = malloc(sizeof(int) * ((size_t)new_capacity + 1));
+    float *ref_x = malloc(sizeof(float) * (size_t)new_capacity);
+    float *ref_y = malloc(sizeof(float) * (size_t)new_capacity);
+    if (!start || !ref_x || !ref_y) {
+        free(start);
+        free(ref_x);
+        free(ref_y);
+        return false;
+    }
+
+    free(list->start);
+    free(list->ref_x);
+    free(list->ref_y);
+    list->start = start;
+    list->ref_x = ref_x;
+    list->ref_y = ref_y;
+    list->capacity = new_capacity;
+    return true;
+}
+
+/* Helper: Append one partner, doubling the pair array when full */
+static bool neighbor_list_push(NeighborList *list, int pairs, int j) {
+    if (pairs >= list->pair_capacity) {
+        int new_capacity = list->pair_capacity > 0 ? list->pair_capacity * 2 : 4096;
+        int *neighbors = realloc(list->neighbors, sizeof(int) * (size_t)new_capacity);
+        if (!neighbors) {
+            return false;
+        }
+        list->neighbors = neighbors;
+        list->pair_capacity = new_capacity;
+    }
+    list->neighbors[pairs] = j;
+    return true;
+}
+
+/* Create an empty list with room for capacity particles */
+NeighborList *neighbor_list_create(int capacity, float skin) {
+    if (capacity < 0 || skin < 0.0f) {
+        return NULL;
+    }
+
+    NeighborList *list = calloc(1, sizeof(NeighborList));
+    if (!list) {
+        return NULL;
+    }
+
+    list->skin = skin;
+    list->count = -1;
+    if (!neighbor_list_reserve(list, capacity > 0 ? capacity : 1)) {
+        free(list);
+        return NULL;
+    }
+    return list;
+}
+
+/* Destroy list and free memory */
+void neighbor_list_destroy(NeighborList *list) {
+    if (list) {
+        free(list->start);
+        free(list->neighbors);
+        free(list->ref_x);
+        free(list->ref_y);
+        free(list);
+    }
+}
+
+/* Force the next update to rebuild */
+void neighbor_list_invalidate(NeighborList *list) {
+    if (list) {
+        list->count = -1;
+    }
+}
+
+/* Check whether any contact could be missing from the list */
+bool neighbor_list_needs_rebuild(const NeighborList *list, const ParticleSoA *particles,
+                                 float collision_radius) {
+    if (!list || !particles) {
+        return true;
+    }
+    if (list->count != particles->count || list->cutoff != 2.0f * collision_radius + list->skin) {
+        return true;
+    }
+
+    float limit = list->skin * 0.5f;
+    float limit_sq = limit * limit;
+
+    for (int i = 0; i < particles->count; i++) {
+        float dx = particles->x[i] - list->ref_x[i];
+        float dy = particles->y[i] - list->ref_y[i];
+        if (dx * dx + dy * dy > limit_sq) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Build the list from a grid binned with the current positions */
+Error neighbor_list_build(NeighborList *list, SpatialGrid *grid, const ParticleSoA *particles,
+                          float collision_radius) {
+    ERROR_CHECK_NULL(list, "Neighbor list");
+    ERROR_CHECK_NULL(grid, "Spatial grid");
+    ERROR_CHECK_NULL(particles, "Particle columns");
+
+    list->count = -1;
+    if (!neighbor_list_reserve(list, particles->count)) {
+        return ERROR_CREATE(ERROR_MEMORY_ALLOCATION, "Failed to expand neighbor list");
+    }
+
+    float cutoff = 2.0f * collision_radius + list->skin;
+    float cutoff_sq = cutoff * cutoff;
+    int reach = (int)ceilf(cutoff / fminf(grid->cell_width, grid->cell_height));
+    int pairs = 0;
+
+    spatial_grid_finalize(grid);
+
+    for (int i = 0; i < particles->count; i++) {
+        float x = particles->x[i];
+        float y = particles->y[i];
+        int col, row;
+        spatial_grid_world_to_cell(grid, x, y, &col, &row);
+
+        list->start[i] = pairs;
+
+        /* Each row of the search square is one contiguous run */
+        for (int r = row - reach; r <= row + reach; r++) {
+            int run_count;
+            const int *run = spatial_grid_row_indices(grid, r, col - reach, col + reach, &run_count);
+
+            for (int k = 0; k < run_count; k++) {
+                int j = run[k];
+                if (j <= i) continue;
+
+                float dx = particles->x[j] - x;
+                float dy = particles->y[j] - y;
+                if (dx * dx + dy * dy <= cutoff_sq) {
+                    if (!neighbor_list_push(list, pairs, j)) {
+                        return ERROR_CREATE(ERROR_MEMORY_ALLOCATION, "Failed to expand neighbor list");
+                    }
+                    pairs++;
+                }
+            }
+        }
+
+        list->ref_x[i] = x;
+        list->ref_y[i] = y;
+    }
+
+    list->start[particles->count] = pairs;
+    list->count = particles->count;
+    list->cutoff = cutoff;
+    list->stats.builds++;
+    list->stats.pairs = pairs;
+    return (Error){SUCCESS};
+}
+
+/* Refresh the grid and rebuild the list only if needed */
+bool neighbor_list_update(NeighborList *list, SpatialGrid *grid, const ParticleSoA *particles,
+                          float collision_radius) {
+    if (!list || !grid || !particles) {
+        return false;
+    }
+
+    if (!neighbor_list_needs_rebuild(list, particles, collision_radius)) {
+        list->stats.reuses++;
+        return false;
+    }
+
+    if (spatial_grid_update(grid, particles).code != SUCCESS ||
+        neighbor_list_build(list, grid, particles, collision_radius).code != SUCCESS) {
+        neighbor_list_invalidate(list);
+        return false;
+    }
+    return true;
+}
+
+/* Get list statistics */
+NeighborListStats neighbor_list_get_stats(const NeighborList *list) {
+    if (!list) {
+        return (NeighborListStats){0};
+    }
+    return list->stats;
+}
+
+/* ===== ERROR-AWARE NEIGHBOR LIST FUNCTIONS ===== */
+
+/* Create a neighbor list with error handling */
+Error neighbor_list_create_with_error(int capacity, float skin, NeighborList **list_out) {
+    ERROR_CHECK_NULL(list_out, "Neighbor list output pointer");
+    ERROR_CHECK_CONDITION(capacity >= 0, ERROR_INVALID_PARAMETER, "Capacity must be non-negative");
+    ERROR_CHECK_CONDITION(skin >= 0.0f, ERROR_INVALID_PARAMETER, "Skin must be non-negative");
+
+    NeighborList *list = neighbor_list_create(capacity, skin);
+    if (!list) {
+        return ERROR_CREATE(ERROR_MEMORY_ALLOCATION, "Failed to allocate neighbor list");
+    }
+
+    *list_out = list;
+    return (Error){SUCCESS, NULL, NULL, 0, NULL};
+}
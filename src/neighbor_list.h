@@ -0,0 +1,88 @@
+#ifndef NEIGHBOR_LIST_H
+#define NEIGHBOR_LIST_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "particle.h"
+#include "error.h"
+#include "spatial_grid.h"
+
+/**
+ * Verlet Neighbor Lists
+ *
+ * Each particle keeps the particles within 2 * collision_radius + skin of
+ * it at the last build. Until some particle has moved more than skin / 2
+ * from where it was at that build, no pair outside the list can have come
+ * into contact, so collision passes reuse the list instead of rebuilding
+ * the grid. Dense, slow-moving piles rebuild only every few frames.
+ *
+ * Lists are half lists in CSR layout: particle i owns
+ * neighbors[start[i] .. start[i + 1]) and only stores partners j > i.
+ */
+
+/* Skin used when none is given (world units) */
+#define NEIGHBOR_LIST_DEFAULT_SKIN 0.5f
+
+/* Neighbor list statistics */
+typedef struct {
+    uint64_t builds;           /* Lists built from the grid */
+    uint64_t reuses;           /* Updates that kept the existing list */
+    int pairs;                 /* Pairs in the current list */
+} NeighborListStats;
+
+/* Neighbor list */
+typedef struct {
+    int *start;                /* count + 1 offsets into neighbors */
+    int *neighbors;            /* Partners j > i of each particle i */
+    float *ref_x, *ref_y;      /* Positions at the last build */
+    int count;                 /* Particles covered by the last build (-1 = none) */
+    int capacity;              /* Particles the per-particle arrays hold */
+    int pair_capacity;         /* Entries the neighbors array holds */
+    float skin;                /* Extra reach beyond contact distance */
+    float cutoff;              /* Pair distance kept by the last build */
+    NeighborListStats stats;   /* Usage statistics */
+} NeighborList;
+
+/* Neighbor list management */
+NeighborList *neighbor_list_create(int capacity, float skin);
+void neighbor_list_destroy(NeighborList *list);
+
+/* Force the next update to rebuild (call when particle indices change) */
+void neighbor_list_invalidate(NeighborList *list);
+
+/**
+ * Check whether the list still covers every contact
+ *
+ * @return true if the particle set or radius changed, or some particle
+ *         moved more than skin / 2 since the last build
+ */
+bool neighbor_list_needs_rebuild(const NeighborList *list, const ParticleSoA *particles,
+                                 float collision_radius);
+
+/**
+ * Build the list from a grid binned with the current positions
+ *
+ * @param list Neighbor list
+ * @param grid Spatial grid holding every particle of particles
+ * @param particles Particle columns the grid indices refer to
+ * @param collision_radius Particle collision radius
+ * @return Error status
+ */
+Error neighbor_list_build(NeighborList *list, SpatialGrid *grid, const ParticleSoA *particles,
+                          float collision_radius);
+
+/**
+ * Refresh the grid and rebuild the list only if needed
+ *
+ * @return true if the list was rebuilt
+ */
+bool neighbor_list_update(NeighborList *list, SpatialGrid *grid, const ParticleSoA *particles,
+                          float collision_radius);
+
+/* Statistics */
+NeighborListStats neighbor_list_get_stats(const NeighborList *list);
+
+/* Error-aware neighbor list functions */
+Error neighbor_list_create_with_error(int capacity, float skin, NeighborList **list_out);
+
+#endif /* NEIGHBOR_LIST_H */
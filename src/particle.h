@@ -7,4 +7,11 @@ typedef struct {
     float vx, vy;   /* Velocity */
 } Particle;
 
+/* Structure-of-arrays view over particle columns (index i is one particle) */
+typedef struct {
+    float *x, *y;   /* Position columns */
+    float *vx, *vy; /* Velocity columns */
+    int count;      /* Number of particles in the view */
+} ParticleSoA;
+
 #endif /* PARTICLE_H */
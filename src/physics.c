@@ -1,7 +1,20 @@
 #include "physics.h"
+#include "simd.h"
 #include <math.h>
 #include <string.h>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#ifdef __aarch64__
+#include <arm_neon.h>
+#endif
+
 /* Helper: Calculate distance squared between two points */
 static inline float dist_sq(float x1, float y1, float x2, float y2) {
     float dx = x2 - x1;
@@ -18,11 +31,11 @@ static inline void normalize(float *x, float *y) {
     }
 }
 
-/* Resolve collision between two particles */
-static void resolve_particle_collision(Particle *p1, Particle *p2,
+/* Resolve collision between particles i and j; returns 1 if they collided */
+static int resolve_particle_collision(ParticleSoA *p, int i, int j,
                                       CollisionSettings *settings) {
-    float dx = p2->x - p1->x;
-    float dy = p2->y - p1->y;
+    float dx = p->x[j] - p->x[i];
+    float dy = p->y[j] - p->y[i];
     float dist_sq_val = dx * dx + dy * dy;
 
     float min_dist = settings->collision_radius * 2.0f;
@@ -30,93 +43,239 @@ static void resolve_particle_collision(Particle *p1, Particle *p2,
 
     /* Check if particles are colliding */
     if (dist_sq_val >= min_dist_sq || dist_sq_val < 0.0001f) {
-        return;
+        return 0;
     }
 
     float dist = sqrtf(dist_sq_val);
 
-    /* Collision normal (from p1 to p2) */
+    /* Collision normal (from i to j) */
     float nx = dx / dist;
     float ny = dy / dist;
 
     /* Relative velocity */
-    float dvx = p2->vx - p1->vx;
-    float dvy = p2->vy - p1->vy;
+    float dvx = p->vx[j] - p->vx[i];
+    float dvy = p->vy[j] - p->vy[i];
 
     /* Relative velocity in collision normal direction */
     float dvn = dvx * nx + dvy * ny;
 
     /* Don't resolve if particles are separating */
     if (dvn >= 0) {
-        return;
+        return 0;
     }
 
     /* Calculate impulse (assuming equal mass) */
     float impulse = -(1.0f + settings->restitution) * dvn / 2.0f;
 
     /* Apply impulse */
-    p1->vx -= impulse * nx * settings->friction;
-    p1->vy -= impulse * ny * settings->friction;
-    p2->vx += impulse * nx * settings->friction;
-    p2->vy += impulse * ny * settings->friction;
+    p->vx[i] -= impulse * nx * settings->friction;
+    p->vy[i] -= impulse * ny * settings->friction;
+    p->vx[j] += impulse * nx * settings->friction;
+    p->vy[j] += impulse * ny * settings->friction;
 
     /* Separate particles to prevent overlap */
     float overlap = min_dist - dist;
     float separation = overlap * 0.5f;
 
-    p1->x -= nx * separation;
-    p1->y -= ny * separation;
-    p2->x += nx * separation;
-    p2->y += ny * separation;
+    p->x[i] -= nx * separation;
+    p->y[i] -= ny * separation;
+    p->x[j] += nx * separation;
+    p->y[j] += ny * separation;
+    return 1;
+}
+
+/* Resolve every pair within one run of particle indices */
+static int collide_run_self(ParticleSoA *p, const int *run, int count,
+                            CollisionSettings *settings) {
+    int collisions = 0;
+    for (int a = 0; a < count; a++) {
+        for (int b = a + 1; b < count; b++) {
+            collisions += resolve_particle_collision(p, run[a], run[b], settings);
+        }
+    }
+    return collisions;
+}
+
+/* Resolve every pair between two disjoint runs of particle indices */
+static int collide_runs(ParticleSoA *p, const int *run_a, int count_a,
+                        const int *run_b, int count_b, CollisionSettings *settings) {
+    int collisions = 0;
+    for (int a = 0; a < count_a; a++) {
+        for (int b = 0; b < count_b; b++) {
+            collisions += resolve_particle_collision(p, run_a[a], run_b[b], settings);
+        }
+    }
+    return collisions;
+}
+
+/* Cell colouring for parallel collisions: the half stencil of (row, col)
+ * touches rows row..row+1 and columns col-1..col+1, so two cells whose rows
+ * differ by a multiple of 2 or whose columns differ by a multiple of 3
+ * never share a particle and can be resolved at the same time */
+#define COLLISION_COLOR_ROWS 2
+#define COLLISION_COLOR_COLS 3
+
+/* Per-worker collision counts are spaced one cache line apart */
+#define COLLISION_COUNT_STRIDE (ARENA_ALIGNMENT / (int)sizeof(int))
+
+/* Shared state for one colour of the parallel collision pass */
+typedef struct {
+    SpatialGrid *grid;
+    ParticleSoA *particles;
+    CollisionSettings *settings;
+    int first_row;             /* Colour's first cell */
+    int first_col;
+    int color_cols;            /* Cells of this colour in each row */
+    int *worker_counts;        /* Collisions found by each worker */
+} CollisionJob;
+
+/* Half stencil: a cell against itself, its east neighbour and the three
+ * cells below, so every neighbouring pair is visited once */
+static int collide_cell(SpatialGrid *grid, ParticleSoA *particles,
+                        CollisionSettings *settings, int row, int col) {
+    int count;
+    const int *cell = spatial_grid_cell_indices(grid, col, row, &count);
+    if (count == 0) {
+        return 0;
+    }
+
+    int collisions = collide_run_self(particles, cell, count, settings);
+
+    int east_count;
+    const int *east = spatial_grid_cell_indices(grid, col + 1, row, &east_count);
+    collisions += collide_runs(particles, cell, count, east, east_count, settings);
+
+    /* South-west, south and south-east cells are one contiguous run */
+    int below_count;
+    const int *below = spatial_grid_row_indices(grid, row + 1, col - 1, col + 1, &below_count);
+    collisions += collide_runs(particles, cell, count, below, below_count, settings);
+
+    return collisions;
+}
+
+/* Resolve a range of same-coloured cells */
+static void collision_chunk(void *ctx, int begin, int end, int worker_id) {
+    CollisionJob *job = (CollisionJob *)ctx;
+    int collisions = 0;
+
+    for (int k = begin; k < end; k++) {
+        int row = job->first_row + (k / job->color_cols) * COLLISION_COLOR_ROWS;
+        int col = job->first_col + (k % job->color_cols) * COLLISION_COLOR_COLS;
+        collisions += collide_cell(job->grid, job->particles, job->settings, row, col);
+    }
+
+    job->worker_counts[worker_id * COLLISION_COUNT_STRIDE] += collisions;
 }
 
 /* Detect and resolve collisions */
-int physics_resolve_collisions(SpatialGrid *grid, Particle **particles,
-                               int num_particles, CollisionSettings *settings) {
+int physics_resolve_collisions(SpatialGrid *grid, ParticleSoA *particles,
+                               CollisionSettings *settings, FrameArena *arena) {
+    return physics_resolve_collisions_parallel(grid, particles, settings, arena, NULL);
+}
+
+/* Detect and resolve collisions, one cell colour at a time across a pool */
+int physics_resolve_collisions_parallel(SpatialGrid *grid, ParticleSoA *particles,
+                                        CollisionSettings *settings, FrameArena *arena,
+                                        ThreadPool *pool) {
     if (!grid || !particles || !settings || !settings->enabled) {
         return 0;
     }
 
-    int collision_count = 0;
+    /* Workers only read the grid */
+    spatial_grid_finalize(grid);
 
-    /* Buffer for neighbor queries */
-    #define MAX_NEIGHBORS 256
-    Particle *neighbors[MAX_NEIGHBORS];
+    /* Per-worker counts; without an arena the pass stays on this thread */
+    int single_count[COLLISION_COUNT_STRIDE];
+    int *worker_counts = single_count;
+    int workers = 1;
 
-    /* Check each particle against its neighbors */
-    for (int i = 0; i < num_particles; i++) {
-        Particle *p1 = particles[i];
-        if (!p1) continue;
+    if (pool && arena) {
+        int pool_workers = thread_pool_get_thread_count(pool);
+        int *counts = arena_alloc(arena, sizeof(int) * COLLISION_COUNT_STRIDE * pool_workers);
+        if (counts) {
+            worker_counts = counts;
+            workers = pool_workers;
+        }
+    }
+    if (workers == 1) {
+        pool = NULL;
+    }
+    for (int w = 0; w < workers; w++) {
+        worker_counts[w * COLLISION_COUNT_STRIDE] = 0;
+    }
 
-        /* Get neighbors in 3x3 grid cells */
-        int num_neighbors = spatial_grid_get_neighbors(grid, p1->x, p1->y,
-                                                       neighbors, MAX_NEIGHBORS);
+    /* Colours run one after another; cells within a colour run in parallel */
+    for (int color_row = 0; color_row < COLLISION_COLOR_ROWS; color_row++) {
+        for (int color_col = 0; color_col < COLLISION_COLOR_COLS; color_col++) {
+            int color_rows = (grid->rows - color_row + COLLISION_COLOR_ROWS - 1) / COLLISION_COLOR_ROWS;
+            int color_cols = (grid->cols - color_col + COLLISION_COLOR_COLS - 1) / COLLISION_COLOR_COLS;
+            int cells = color_rows * color_cols;
+            if (cells <= 0) continue;
 
-        /* Check collisions with neighbors */
-        for (int j = 0; j < num_neighbors; j++) {
-            Particle *p2 = neighbors[j];
+            CollisionJob job = {
+                grid, particles, settings, color_row, color_col, color_cols, worker_counts
+            };
+            int grain = cells / (workers * 4);
+            thread_pool_parallel_for(pool, cells, grain > 0 ? grain : 1, collision_chunk, &job);
+        }
+    }
 
-            /* Skip self */
-            if (p2 == p1) continue;
+    int collision_count = 0;
+    for (int w = 0; w < workers; w++) {
+        collision_count += worker_counts[w * COLLISION_COUNT_STRIDE];
+    }
+    return collision_count;
+}
+
+/* Detect and resolve collisions on a sparse spatial hash */
+int physics_resolve_collisions_hash(SpatialHash *hash, ParticleSoA *particles,
+                                    CollisionSettings *settings) {
+    if (!hash || !particles || !settings || !settings->enabled) {
+        return 0;
+    }
+
+    /* East, then south-west, south and south-east: the grid's half stencil */
+    static const int stencil[4][2] = { {1, 0}, {-1, 1}, {0, 1}, {1, 1} };
 
-            /* Skip if we already checked this pair (p2 index < p1 index) */
-            /* This assumes particles array is stable */
-            if (p2 < p1) continue;
+    spatial_hash_finalize(hash);
 
-            resolve_particle_collision(p1, p2, settings);
-            collision_count++;
+    int collision_count = 0;
+    for (int c = 0; c < hash->num_cells; c++) {
+        const SpatialHashCell *cell = &hash->cells[c];
+        const int *run = hash->indices + cell->start;
+        collision_count += collide_run_self(particles, run, cell->count, settings);
+
+        for (int k = 0; k < 4; k++) {
+            int other_count;
+            const int *other = spatial_hash_cell_indices(hash, cell->cx + stencil[k][0],
+                                                         cell->cy + stencil[k][1], &other_count);
+            collision_count += collide_runs(particles, run, cell->count, other, other_count, settings);
         }
     }
-
     return collision_count;
+}
+
+/* Resolve collisions from a Verlet neighbor list */
+int physics_resolve_collisions_verlet(const NeighborList *list, ParticleSoA *particles,
+                                      CollisionSettings *settings) {
+    if (!list || !particles || !settings || !settings->enabled || list->count != particles->count) {
+        return 0;
+    }
 
-    #undef MAX_NEIGHBORS
+    int collision_count = 0;
+    for (int i = 0; i < list->count; i++) {
+        for (int k = list->start[i]; k < list->start[i + 1]; k++) {
+            collision_count += resolve_particle_collision(particles, i, list->neighbors[k], settings);
+        }
+    }
+    return collision_count;
 }
 
 /* Apply radial force field */
-static void apply_radial_force(Particle *p, ForceField *field, float dt) {
-    float dx = p->x - field->x;
-    float dy = p->y - field->y;
+static void apply_radial_force(float x, float y, float *vx, float *vy,
+                               const ForceField *field, float dt) {
+    float dx = x - field->x;
+    float dy = y - field->y;
     float dist_sq_val = dx * dx + dy * dy;
 
     /* Check radius */
@@ -134,20 +293,21 @@ static void apply_radial_force(Particle *p, ForceField *field, float dt) {
     /* Force falls off with distance */
     float force = field->strength / (1.0f + dist * 0.1f);
 
-    p->vx += nx * force * dt;
-    p->vy += ny * force * dt;
+    *vx += nx * force * dt;
+    *vy += ny * force * dt;
 }
 
 /* Apply directional force field */
-static void apply_directional_force(Particle *p, ForceField *field, float dt) {
-    p->vx += field->direction_x * field->strength * dt;
-    p->vy += field->direction_y * field->strength * dt;
+static void apply_directional_force(float *vx, float *vy, const ForceField *field, float dt) {
+    *vx += field->direction_x * field->strength * dt;
+    *vy += field->direction_y * field->strength * dt;
 }
 
 /* Apply vortex force field */
-static void apply_vortex_force(Particle *p, ForceField *field, float dt) {
-    float dx = p->x - field->x;
-    float dy = p->y - field->y;
+static void apply_vortex_force(float x, float y, float *vx, float *vy,
+                               const ForceField *field, float dt) {
+    float dx = x - field->x;
+    float dy = y - field->y;
     float dist_sq_val = dx * dx + dy * dy;
 
     /* Check radius */
@@ -167,14 +327,15 @@ static void apply_vortex_force(Particle *p, ForceField *field, float dt) {
     /* Force falls off with distance */
     float force = field->strength / (1.0f + dist * 0.05f);
 
-    p->vx += tx * force * dt;
-    p->vy += ty * force * dt;
+    *vx += tx * force * dt;
+    *vy += ty * force * dt;
 }
 
 /* Apply attractor force field */
-static void apply_attractor_force(Particle *p, ForceField *field, float dt) {
-    float dx = field->x - p->x;
-    float dy = field->y - p->y;
+static void apply_attractor_force(float x, float y, float *vx, float *vy,
+                                  const ForceField *field, float dt) {
+    float dx = field->x - x;
+    float dy = field->y - y;
     float dist_sq_val = dx * dx + dy * dy;
 
     /* Check radius */
@@ -192,47 +353,1109 @@ static void apply_attractor_force(Particle *p, ForceField *field, float dt) {
     /* Gravitational force: F = G / r² */
     float force = field->strength / dist_sq_val;
 
-    p->vx += nx * force * dt;
-    p->vy += ny * force * dt;
+    *vx += nx * force * dt;
+    *vy += ny * force * dt;
 }
 
-/* Apply single force field to particle */
-void physics_apply_force_field(Particle *particle, ForceField *field, float dt) {
-    if (!particle || !field || !field->active) {
-        return;
-    }
-
+/* Apply one field to a single particle's position/velocity */
+static void apply_field(float x, float y, float *vx, float *vy, const ForceField *field, float dt) {
     switch (field->type) {
         case FORCE_FIELD_RADIAL:
-            apply_radial_force(particle, field, dt);
+            apply_radial_force(x, y, vx, vy, field, dt);
             break;
 
         case FORCE_FIELD_DIRECTIONAL:
-            apply_directional_force(particle, field, dt);
+            apply_directional_force(vx, vy, field, dt);
             break;
 
         case FORCE_FIELD_VORTEX:
-            apply_vortex_force(particle, field, dt);
+            apply_vortex_force(x, y, vx, vy, field, dt);
             break;
 
         case FORCE_FIELD_ATTRACTOR:
-            apply_attractor_force(particle, field, dt);
+            apply_attractor_force(x, y, vx, vy, field, dt);
             break;
     }
 }
 
-/* Apply multiple force fields to all particles */
-void physics_apply_force_fields(Particle **particles, int num_particles,
+/* Apply single force field to particle */
+void physics_apply_force_field(Particle *particle, ForceField *field, float dt) {
+    if (!particle || !field || !field->active) {
+        return;
+    }
+
+    apply_field(particle->x, particle->y, &particle->vx, &particle->vy, field, dt);
+}
+
+/* Helper: Add a directional field's constant velocity change to every particle */
+static void apply_directional_pass(ParticleSoA *particles, const ForceField *field, float dt) {
+    const float ax = field->direction_x * field->strength * dt;
+    const float ay = field->direction_y * field->strength * dt;
+    for (int i = 0; i < particles->count; i++) {
+        particles->vx[i] += ax;
+        particles->vy[i] += ay;
+    }
+}
+
+/* Apply multiple force fields to all particles, one pass per field.
+ * Each particle still sees the fields in array order, so results are the
+ * same as applying every field to one particle before the next. */
+void physics_apply_force_fields(ParticleSoA *particles,
                                 ForceField *fields, int num_fields, float dt) {
     if (!particles || !fields) return;
 
-    for (int i = 0; i < num_particles; i++) {
-        if (!particles[i]) continue;
+    for (int j = 0; j < num_fields; j++) {
+        const ForceField *field = &fields[j];
+        if (!field->active) continue;
+
+        if (field->type == FORCE_FIELD_DIRECTIONAL) {
+            apply_directional_pass(particles, field, dt);
+            continue;
+        }
+        for (int i = 0; i < particles->count; i++) {
+            apply_field(particles->x[i], particles->y[i],
+                        &particles->vx[i], &particles->vy[i], field, dt);
+        }
+    }
+}
+
+/* Check whether a field only reaches a bounded area */
+bool physics_force_field_is_local(const ForceField *field) {
+    return field && field->active && field->type != FORCE_FIELD_DIRECTIONAL &&
+           field->radius > 0.0f && isfinite(field->x + field->radius) &&
+           isfinite(field->y + field->radius);
+}
+
+/* Helper: Grid cells covering a local field's bounding box. The box is
+ * padded by 0.1% so rounding in the distance test cannot admit a particle
+ * outside it; corners are clamped to the world first, and cells are found
+ * the way particles are binned, so out-of-world particles in edge cells
+ * are still covered. */
+static void field_cell_span(SpatialGrid *grid, const ForceField *field,
+                            int *first_col, int *first_row, int *last_col, int *last_row) {
+    const float reach = field->radius * 1.001f;
+    const float w = (float)grid->world_width, h = (float)grid->world_height;
+
+    spatial_grid_world_to_cell(grid, fminf(fmaxf(field->x - reach, 0.0f), w),
+                               fminf(fmaxf(field->y - reach, 0.0f), h), first_col, first_row);
+    spatial_grid_world_to_cell(grid, fminf(fmaxf(field->x + reach, 0.0f), w),
+                               fminf(fmaxf(field->y + reach, 0.0f), h), last_col, last_row);
+}
+
+/* Helper: Binned particles inside a field's cell span */
+static int field_span_count(const SpatialGrid *grid, int first_col, int first_row,
+                            int last_col, int last_row) {
+    int touched = 0;
+    for (int row = first_row; row <= last_row; row++) {
+        touched += grid->cell_start[row * grid->cols + last_col + 1] -
+                   grid->cell_start[row * grid->cols + first_col];
+    }
+    return touched;
+}
+
+/* Shared state for one local field's row-parallel walk */
+typedef struct {
+    SpatialGrid *grid;
+    ParticleSoA *particles;
+    const ForceField *field;
+    float dt;
+    int first_row, first_col, last_col;
+} CulledFieldJob;
+
+/* Apply one local field to a range of its box rows; rows hold disjoint
+ * particles, so workers never share one */
+static void culled_field_rows(void *ctx, int begin, int end, int worker_id) {
+    CulledFieldJob *job = (CulledFieldJob *)ctx;
+    ParticleSoA *particles = job->particles;
+    (void)worker_id;
+
+    /* Each row of the box is one contiguous run */
+    for (int k = begin; k < end; k++) {
+        int run_count;
+        const int *run = spatial_grid_row_indices(job->grid, job->first_row + k,
+                                                  job->first_col, job->last_col, &run_count);
+        for (int r = 0; r < run_count; r++) {
+            int i = run[r];
+            apply_field(particles->x[i], particles->y[i],
+                        &particles->vx[i], &particles->vy[i], job->field, job->dt);
+        }
+    }
+}
+
+/* Apply force fields to the grid cells each local field overlaps */
+int physics_apply_force_fields_culled(SpatialGrid *grid, ParticleSoA *particles,
+                                      ForceField *fields, int num_fields, float dt,
+                                      ForceField *rest_out) {
+    return physics_apply_force_fields_culled_parallel(grid, particles, fields, num_fields, dt,
+                                                      rest_out, NULL);
+}
+
+/* Apply force fields to the grid cells each local field overlaps, splitting
+ * each busy box's rows across a pool */
+int physics_apply_force_fields_culled_parallel(SpatialGrid *grid, ParticleSoA *particles,
+                                               ForceField *fields, int num_fields, float dt,
+                                               ForceField *rest_out, ThreadPool *pool) {
+    if (!grid || !particles || !fields) return 0;
+
+    /* Workers only read the grid */
+    spatial_grid_finalize(grid);
+
+    const int max_touched = (int)(PHYSICS_FIELD_CULL_MAX_FRACTION * (float)particles->count);
+    int num_rest = 0;
+
+    for (int j = 0; j < num_fields; j++) {
+        ForceField *field = &fields[j];
+        if (!field->active) continue;
+
+        if (!physics_force_field_is_local(field)) {
+            if (rest_out) {
+                rest_out[num_rest++] = *field;
+            } else {
+                physics_apply_force_fields(particles, field, 1, dt);
+            }
+            continue;
+        }
+
+        int first_col, first_row, last_col, last_row;
+        field_cell_span(grid, field, &first_col, &first_row, &last_col, &last_row);
+        int touched = field_span_count(grid, first_col, first_row, last_col, last_row);
+
+        /* Wide boxes go to the caller's vector pass */
+        if (rest_out && touched > max_touched) {
+            rest_out[num_rest++] = *field;
+            continue;
+        }
+
+        /* Fields run one after another, so each particle still sees them
+         * in array order; small boxes stay on this thread */
+        CulledFieldJob job = { grid, particles, field, dt, first_row, first_col, last_col };
+        thread_pool_parallel_for(touched >= PHYSICS_FIELD_CULL_PARALLEL_MIN ? pool : NULL,
+                                 last_row - first_row + 1, 1, culled_field_rows, &job);
+    }
+    return num_rest;
+}
+
+/* Split fields into those worth culling and those left to a full pass */
+int physics_partition_force_fields(SpatialGrid *grid, const ForceField *fields, int num_fields,
+                                   ForceField *local_out, int *num_local_out, ForceField *rest_out) {
+    if (num_local_out) *num_local_out = 0;
+    if (!grid || !fields || !local_out || !num_local_out || !rest_out) return 0;
+
+    spatial_grid_finalize(grid);
+
+    const int max_touched = (int)(PHYSICS_FIELD_CULL_MAX_FRACTION * (float)grid->total_particles);
+    int num_rest = 0;
+
+    for (int j = 0; j < num_fields; j++) {
+        const ForceField *field = &fields[j];
+        if (!field->active) continue;
+
+        bool cull = physics_force_field_is_local(field);
+        if (cull) {
+            int first_col, first_row, last_col, last_row;
+            field_cell_span(grid, field, &first_col, &first_row, &last_col, &last_row);
+            cull = field_span_count(grid, first_col, first_row, last_col, last_row) <= max_touched;
+        }
+        if (cull) {
+            local_out[(*num_local_out)++] = *field;
+        } else {
+            rest_out[num_rest++] = *field;
+        }
+    }
+    return num_rest;
+}
+
+/* ===== FUSED STEP KERNELS ===== */
+
+/* One point field reduced to lane constants. With d = position - center
+ * and dist = |d|, every point field adds
+ *   strength * d / dist * falloff(dist) * dt
+ * rotated a quarter turn for vortices; attractors pull, so their strength
+ * is negated. */
+typedef struct {
+    float fx, fy;            /* Field center */
+    float strength;          /* Signed strength */
+    float falloff;           /* k in 1 / (1 + k * dist); 0 = 1 / dist² */
+    float min_d2;            /* Singularity guard */
+    float max_d2;            /* Radius cutoff (INFINITY = unbounded) */
+    bool tangential;         /* Push along (-dy, dx) instead of (dx, dy) */
+} FieldLanes;
+
+/* Helper: Lane constants for a radial, vortex or attractor field */
+static inline FieldLanes field_lanes(const ForceField *field) {
+    FieldLanes lanes = {
+        .fx = field->x,
+        .fy = field->y,
+        .strength = field->strength,
+        .falloff = 0.1f,
+        .min_d2 = 0.0001f,
+        .max_d2 = field->radius > 0 ? field->radius * field->radius : INFINITY,
+        .tangential = false
+    };
+    if (field->type == FORCE_FIELD_VORTEX) {
+        lanes.falloff = 0.05f;
+        lanes.tangential = true;
+    } else if (field->type == FORCE_FIELD_ATTRACTOR) {
+        lanes.strength = -field->strength;
+        lanes.falloff = 0.0f;
+        lanes.min_d2 = 1.0f;
+    }
+    return lanes;
+}
+
+#define WALL_DAMPING 0.6f     /* Velocity damping on wall collisions */
+#define GROUND_FRICTION 0.98f /* Ground friction */
+
+/* Step one particle through integration, fields, walls and the despawn test */
+static inline bool fused_step_one(float *x_io, float *y_io, float *vx_io, float *vy_io,
+                                  const PhysicsStepParams *params) {
+    const float dt = params->dt;
+    const float max_x = params->width - 1;
+    const float max_y = params->height - 1;
+
+    float x = *x_io, y = *y_io;
+    float vx = *vx_io, vy = *vy_io;
+
+    /* Integrate */
+    vx += params->windx * dt;
+    vy += (params->gravity + params->windy) * dt;
+    x += vx * dt;
+    y += vy * dt;
+
+    /* Force fields */
+    for (int f = 0; f < params->num_fields; f++) {
+        if (params->fields[f].active) {
+            apply_field(x, y, &vx, &vy, &params->fields[f], dt);
+        }
+    }
+
+    /* Wall collision detection and response */
+    if (x < 0) {
+        x = 0;
+        vx = -vx * WALL_DAMPING;
+    } else if (x >= max_x) {
+        x = max_x;
+        vx = -vx * WALL_DAMPING;
+    }
+
+    if (y < 0) {
+        y = 0;
+        vy = -vy * WALL_DAMPING;
+    } else if (y >= max_y) {
+        y = max_y;
+        vy = -vy * WALL_DAMPING;
+
+        /* Apply ground friction when near bottom */
+        if (fabsf(vy) < 2.0f) {
+            vx *= GROUND_FRICTION;
+        }
+    }
+
+    *x_io = x;
+    *y_io = y;
+    *vx_io = vx;
+    *vy_io = vy;
+
+    /* Particles that are too slow and near the bottom despawn */
+    return y >= params->height - 2 && fabsf(vx) < 0.5f && fabsf(vy) < 0.5f;
+}
+
+/* Scalar fused kernel (reference implementation) */
+int physics_step_fused_scalar(ParticleSoA *particles, const PhysicsStepParams *params,
+                              uint8_t *despawn) {
+    if (!particles || !params || !despawn) return 0;
+
+    int despawned = 0;
+    for (int i = 0; i < particles->count; i++) {
+        despawn[i] = fused_step_one(&particles->x[i], &particles->y[i],
+                                    &particles->vx[i], &particles->vy[i], params);
+        despawned += despawn[i];
+    }
+    return despawned;
+}
+
+#if defined(__SSE2__)
+/* Lane-wise mask ? a : b */
+static inline __m128 sse_select(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+static inline __m128 sse_abs(__m128 v) {
+    return _mm_andnot_ps(_mm_set1_ps(-0.0f), v);
+}
+
+/* Apply one field to four particles: 1 / dist from a refined rsqrt
+ * estimate and the cutoffs as a lane mask, as in the field-major passes */
+static inline void sse_apply_field(__m128 x, __m128 y, __m128 *vx, __m128 *vy,
+                                   const ForceField *field, float dt) {
+    if (field->type == FORCE_FIELD_DIRECTIONAL) {
+        *vx = _mm_add_ps(*vx, _mm_set1_ps(field->direction_x * field->strength * dt));
+        *vy = _mm_add_ps(*vy, _mm_set1_ps(field->direction_y * field->strength * dt));
+        return;
+    }
+
+    const FieldLanes lanes = field_lanes(field);
+    __m128 dx = _mm_sub_ps(x, _mm_set1_ps(lanes.fx));
+    __m128 dy = _mm_sub_ps(y, _mm_set1_ps(lanes.fy));
+    __m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+
+    /* Lanes inside the radius and clear of the singularity */
+    __m128 mask = _mm_and_ps(_mm_cmpnlt_ps(d2, _mm_set1_ps(lanes.min_d2)),
+                             _mm_cmpngt_ps(d2, _mm_set1_ps(lanes.max_d2)));
+    if (_mm_movemask_ps(mask) == 0) {
+        return;
+    }
+
+    /* 1 / dist: estimate plus one Newton-Raphson step */
+    __m128 inv = _mm_rsqrt_ps(d2);
+    inv = _mm_mul_ps(inv, _mm_sub_ps(_mm_set1_ps(1.5f),
+                                     _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), d2), _mm_mul_ps(inv, inv))));
+
+    __m128 strength_dt = _mm_set1_ps(lanes.strength * dt);
+    __m128 scale = lanes.falloff > 0.0f ?
+        _mm_div_ps(_mm_mul_ps(strength_dt, inv),
+                   _mm_add_ps(_mm_set1_ps(1.0f), _mm_mul_ps(_mm_set1_ps(lanes.falloff), _mm_mul_ps(d2, inv)))) :
+        _mm_mul_ps(strength_dt, _mm_mul_ps(inv, _mm_mul_ps(inv, inv)));
+    scale = _mm_and_ps(mask, scale);
+
+    __m128 inc_x = lanes.tangential ? _mm_mul_ps(_mm_xor_ps(dy, _mm_set1_ps(-0.0f)), scale)
+                                    : _mm_mul_ps(dx, scale);
+    __m128 inc_y = lanes.tangential ? _mm_mul_ps(dx, scale) : _mm_mul_ps(dy, scale);
+    *vx = _mm_add_ps(*vx, inc_x);
+    *vy = _mm_add_ps(*vy, inc_y);
+}
+#endif
+
+/* SSE2 fused kernel: four particles per iteration */
+int physics_step_fused_sse(ParticleSoA *particles, const PhysicsStepParams *params,
+                           uint8_t *despawn) {
+    #if defined(__SSE2__)
+    if (!particles || !params || !despawn) return 0;
+
+    const float dt = params->dt;
+    const __m128 dt_vec = _mm_set1_ps(dt);
+    const __m128 ax_dt = _mm_set1_ps(params->windx * dt);
+    const __m128 ay_dt = _mm_set1_ps((params->gravity + params->windy) * dt);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 max_x = _mm_set1_ps(params->width - 1);
+    const __m128 max_y = _mm_set1_ps(params->height - 1);
+    const __m128 rest_y = _mm_set1_ps(params->height - 2);
+    const __m128 damping = _mm_set1_ps(WALL_DAMPING);
+    const __m128 friction = _mm_set1_ps(GROUND_FRICTION);
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    const __m128 slow = _mm_set1_ps(0.5f);
+    const __m128 sliding = _mm_set1_ps(2.0f);
+
+    float *px = particles->x, *py = particles->y;
+    float *pvx = particles->vx, *pvy = particles->vy;
+    const int count = particles->count;
+    const int vectorized_count = count & ~3;
+    int despawned = 0;
+    int i = 0;
+
+    for (; i < vectorized_count; i += 4) {
+        __m128 vx = _mm_add_ps(_mm_loadu_ps(pvx + i), ax_dt);
+        __m128 vy = _mm_add_ps(_mm_loadu_ps(pvy + i), ay_dt);
+        __m128 x = _mm_add_ps(_mm_loadu_ps(px + i), _mm_mul_ps(vx, dt_vec));
+        __m128 y = _mm_add_ps(_mm_loadu_ps(py + i), _mm_mul_ps(vy, dt_vec));
+
+        for (int f = 0; f < params->num_fields; f++) {
+            if (params->fields[f].active) {
+                sse_apply_field(x, y, &vx, &vy, &params->fields[f], dt);
+            }
+        }
+
+        /* Side walls */
+        __m128 left = _mm_cmplt_ps(x, zero);
+        __m128 right = _mm_andnot_ps(left, _mm_cmpge_ps(x, max_x));
+        x = sse_select(left, zero, sse_select(right, max_x, x));
+        vx = sse_select(_mm_or_ps(left, right), _mm_mul_ps(_mm_xor_ps(vx, sign), damping), vx);
+
+        /* Ceiling and floor, with friction for particles sliding on the floor */
+        __m128 top = _mm_cmplt_ps(y, zero);
+        __m128 bottom = _mm_andnot_ps(top, _mm_cmpge_ps(y, max_y));
+        y = sse_select(top, zero, sse_select(bottom, max_y, y));
+        vy = sse_select(_mm_or_ps(top, bottom), _mm_mul_ps(_mm_xor_ps(vy, sign), damping), vy);
+        __m128 rubbing = _mm_and_ps(bottom, _mm_cmplt_ps(sse_abs(vy), sliding));
+        vx = sse_select(rubbing, _mm_mul_ps(vx, friction), vx);
+
+        _mm_storeu_ps(px + i, x);
+        _mm_storeu_ps(py + i, y);
+        _mm_storeu_ps(pvx + i, vx);
+        _mm_storeu_ps(pvy + i, vy);
+
+        __m128 rest = _mm_and_ps(_mm_cmpge_ps(y, rest_y),
+                                 _mm_and_ps(_mm_cmplt_ps(sse_abs(vx), slow),
+                                            _mm_cmplt_ps(sse_abs(vy), slow)));
+        int bits = _mm_movemask_ps(rest);
+        for (int lane = 0; lane < 4; lane++) {
+            despawn[i + lane] = (uint8_t)((bits >> lane) & 1);
+        }
+        despawned += __builtin_popcount((unsigned)bits);
+    }
+
+    for (; i < count; i++) {
+        despawn[i] = fused_step_one(&px[i], &py[i], &pvx[i], &pvy[i], params);
+        despawned += despawn[i];
+    }
+
+    return despawned;
+    #else
+    return physics_step_fused_scalar(particles, params, despawn);
+    #endif
+}
+
+#ifdef __aarch64__
+/* Apply one field to four particles: 1 / dist from a refined rsqrt
+ * estimate and the cutoffs as a lane mask */
+static inline void neon_apply_field(float32x4_t x, float32x4_t y, float32x4_t *vx, float32x4_t *vy,
+                                    const ForceField *field, float dt) {
+    if (field->type == FORCE_FIELD_DIRECTIONAL) {
+        *vx = vaddq_f32(*vx, vdupq_n_f32(field->direction_x * field->strength * dt));
+        *vy = vaddq_f32(*vy, vdupq_n_f32(field->direction_y * field->strength * dt));
+        return;
+    }
+
+    const FieldLanes lanes = field_lanes(field);
+    float32x4_t dx = vsubq_f32(x, vdupq_n_f32(lanes.fx));
+    float32x4_t dy = vsubq_f32(y, vdupq_n_f32(lanes.fy));
+    float32x4_t d2 = vaddq_f32(vmulq_f32(dx, dx), vmulq_f32(dy, dy));
+
+    /* Lanes inside the radius and clear of the singularity */
+    uint32x4_t mask = vmvnq_u32(vcltq_f32(d2, vdupq_n_f32(lanes.min_d2)));
+    mask = vbicq_u32(mask, vcgtq_f32(d2, vdupq_n_f32(lanes.max_d2)));
+    if (vmaxvq_u32(mask) == 0) {
+        return;
+    }
+
+    /* 1 / dist: the NEON estimate is coarser, so refine twice */
+    float32x4_t inv = vrsqrteq_f32(d2);
+    inv = vmulq_f32(inv, vrsqrtsq_f32(vmulq_f32(d2, inv), inv));
+    inv = vmulq_f32(inv, vrsqrtsq_f32(vmulq_f32(d2, inv), inv));
+
+    float32x4_t strength_dt = vdupq_n_f32(lanes.strength * dt);
+    float32x4_t scale = lanes.falloff > 0.0f ?
+        vdivq_f32(vmulq_f32(strength_dt, inv),
+                  vaddq_f32(vdupq_n_f32(1.0f), vmulq_f32(vdupq_n_f32(lanes.falloff), vmulq_f32(d2, inv)))) :
+        vmulq_f32(strength_dt, vmulq_f32(inv, vmulq_f32(inv, inv)));
+    scale = vreinterpretq_f32_u32(vandq_u32(mask, vreinterpretq_u32_f32(scale)));
+
+    float32x4_t inc_x = lanes.tangential ? vmulq_f32(vnegq_f32(dy), scale) : vmulq_f32(dx, scale);
+    float32x4_t inc_y = lanes.tangential ? vmulq_f32(dx, scale) : vmulq_f32(dy, scale);
+    *vx = vaddq_f32(*vx, inc_x);
+    *vy = vaddq_f32(*vy, inc_y);
+}
+#endif
+
+/* NEON fused kernel: four particles per iteration */
+int physics_step_fused_neon(ParticleSoA *particles, const PhysicsStepParams *params,
+                            uint8_t *despawn) {
+    #ifdef __aarch64__
+    if (!particles || !params || !despawn) return 0;
+
+    const float dt = params->dt;
+    const float32x4_t dt_vec = vdupq_n_f32(dt);
+    const float32x4_t ax_dt = vdupq_n_f32(params->windx * dt);
+    const float32x4_t ay_dt = vdupq_n_f32((params->gravity + params->windy) * dt);
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const float32x4_t max_x = vdupq_n_f32(params->width - 1);
+    const float32x4_t max_y = vdupq_n_f32(params->height - 1);
+    const float32x4_t rest_y = vdupq_n_f32(params->height - 2);
+    const float32x4_t damping = vdupq_n_f32(WALL_DAMPING);
+    const float32x4_t friction = vdupq_n_f32(GROUND_FRICTION);
+    const float32x4_t slow = vdupq_n_f32(0.5f);
+    const float32x4_t sliding = vdupq_n_f32(2.0f);
+
+    float *px = particles->x, *py = particles->y;
+    float *pvx = particles->vx, *pvy = particles->vy;
+    const int count = particles->count;
+    const int vectorized_count = count & ~3;
+    int despawned = 0;
+    int i = 0;
+
+    for (; i < vectorized_count; i += 4) {
+        float32x4_t vx = vaddq_f32(vld1q_f32(pvx + i), ax_dt);
+        float32x4_t vy = vaddq_f32(vld1q_f32(pvy + i), ay_dt);
+        float32x4_t x = vaddq_f32(vld1q_f32(px + i), vmulq_f32(vx, dt_vec));
+        float32x4_t y = vaddq_f32(vld1q_f32(py + i), vmulq_f32(vy, dt_vec));
+
+        for (int f = 0; f < params->num_fields; f++) {
+            if (params->fields[f].active) {
+                neon_apply_field(x, y, &vx, &vy, &params->fields[f], dt);
+            }
+        }
+
+        /* Side walls */
+        uint32x4_t left = vcltq_f32(x, zero);
+        uint32x4_t right = vbicq_u32(vcgeq_f32(x, max_x), left);
+        x = vbslq_f32(left, zero, vbslq_f32(right, max_x, x));
+        vx = vbslq_f32(vorrq_u32(left, right), vmulq_f32(vnegq_f32(vx), damping), vx);
+
+        /* Ceiling and floor, with friction for particles sliding on the floor */
+        uint32x4_t top = vcltq_f32(y, zero);
+        uint32x4_t bottom = vbicq_u32(vcgeq_f32(y, max_y), top);
+        y = vbslq_f32(top, zero, vbslq_f32(bottom, max_y, y));
+        vy = vbslq_f32(vorrq_u32(top, bottom), vmulq_f32(vnegq_f32(vy), damping), vy);
+        uint32x4_t rubbing = vandq_u32(bottom, vcltq_f32(vabsq_f32(vy), sliding));
+        vx = vbslq_f32(rubbing, vmulq_f32(vx, friction), vx);
+
+        vst1q_f32(px + i, x);
+        vst1q_f32(py + i, y);
+        vst1q_f32(pvx + i, vx);
+        vst1q_f32(pvy + i, vy);
+
+        uint32x4_t rest = vandq_u32(vcgeq_f32(y, rest_y),
+                                    vandq_u32(vcltq_f32(vabsq_f32(vx), slow),
+                                              vcltq_f32(vabsq_f32(vy), slow)));
+        uint32_t lanes[4];
+        vst1q_u32(lanes, rest);
+        for (int lane = 0; lane < 4; lane++) {
+            despawn[i + lane] = (uint8_t)(lanes[lane] & 1);
+            despawned += despawn[i + lane];
+        }
+    }
+
+    for (; i < count; i++) {
+        despawn[i] = fused_step_one(&px[i], &py[i], &pvx[i], &pvy[i], params);
+        despawned += despawn[i];
+    }
+
+    return despawned;
+    #else
+    return physics_step_fused_scalar(particles, params, despawn);
+    #endif
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+#define PHYSICS_TARGET_AVX2 __attribute__((target("avx2")))
+#define PHYSICS_TARGET_AVX512 __attribute__((target("avx512f")))
+
+/* Apply one field to eight particles: 1 / dist from a refined rsqrt
+ * estimate and the cutoffs as a lane mask */
+PHYSICS_TARGET_AVX2
+static inline void avx2_apply_field(__m256 x, __m256 y, __m256 *vx, __m256 *vy,
+                                    const ForceField *field, float dt) {
+    if (field->type == FORCE_FIELD_DIRECTIONAL) {
+        *vx = _mm256_add_ps(*vx, _mm256_set1_ps(field->direction_x * field->strength * dt));
+        *vy = _mm256_add_ps(*vy, _mm256_set1_ps(field->direction_y * field->strength * dt));
+        return;
+    }
+
+    const FieldLanes lanes = field_lanes(field);
+    __m256 dx = _mm256_sub_ps(x, _mm256_set1_ps(lanes.fx));
+    __m256 dy = _mm256_sub_ps(y, _mm256_set1_ps(lanes.fy));
+    __m256 d2 = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+
+    /* Lanes inside the radius and clear of the singularity */
+    __m256 mask = _mm256_and_ps(_mm256_cmp_ps(d2, _mm256_set1_ps(lanes.min_d2), _CMP_NLT_UQ),
+                                _mm256_cmp_ps(d2, _mm256_set1_ps(lanes.max_d2), _CMP_NGT_UQ));
+    if (_mm256_movemask_ps(mask) == 0) {
+        return;
+    }
+
+    /* 1 / dist: estimate plus one Newton-Raphson step */
+    __m256 inv = _mm256_rsqrt_ps(d2);
+    inv = _mm256_mul_ps(inv, _mm256_sub_ps(_mm256_set1_ps(1.5f),
+                                           _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), d2),
+                                                         _mm256_mul_ps(inv, inv))));
+
+    __m256 strength_dt = _mm256_set1_ps(lanes.strength * dt);
+    __m256 scale = lanes.falloff > 0.0f ?
+        _mm256_div_ps(_mm256_mul_ps(strength_dt, inv),
+                      _mm256_add_ps(_mm256_set1_ps(1.0f),
+                                    _mm256_mul_ps(_mm256_set1_ps(lanes.falloff), _mm256_mul_ps(d2, inv)))) :
+        _mm256_mul_ps(strength_dt, _mm256_mul_ps(inv, _mm256_mul_ps(inv, inv)));
+    scale = _mm256_and_ps(mask, scale);
+
+    __m256 inc_x = lanes.tangential ? _mm256_mul_ps(_mm256_xor_ps(dy, _mm256_set1_ps(-0.0f)), scale)
+                                    : _mm256_mul_ps(dx, scale);
+    __m256 inc_y = lanes.tangential ? _mm256_mul_ps(dx, scale) : _mm256_mul_ps(dy, scale);
+    *vx = _mm256_add_ps(*vx, inc_x);
+    *vy = _mm256_add_ps(*vy, inc_y);
+}
+
+/* Step eight particles held in registers; returns the despawn lane bits */
+PHYSICS_TARGET_AVX2
+static inline int avx2_step_block(__m256 *x_io, __m256 *y_io, __m256 *vx_io, __m256 *vy_io,
+                                  const PhysicsStepParams *params) {
+    const float dt = params->dt;
+    const __m256 dt_vec = _mm256_set1_ps(dt);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 max_x = _mm256_set1_ps(params->width - 1);
+    const __m256 max_y = _mm256_set1_ps(params->height - 1);
+    const __m256 damping = _mm256_set1_ps(WALL_DAMPING);
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+    const __m256 slow = _mm256_set1_ps(0.5f);
+
+    __m256 vx = _mm256_add_ps(*vx_io, _mm256_set1_ps(params->windx * dt));
+    __m256 vy = _mm256_add_ps(*vy_io, _mm256_set1_ps((params->gravity + params->windy) * dt));
+    __m256 x = _mm256_add_ps(*x_io, _mm256_mul_ps(vx, dt_vec));
+    __m256 y = _mm256_add_ps(*y_io, _mm256_mul_ps(vy, dt_vec));
+
+    for (int f = 0; f < params->num_fields; f++) {
+        if (params->fields[f].active) {
+            avx2_apply_field(x, y, &vx, &vy, &params->fields[f], dt);
+        }
+    }
+
+    /* Side walls */
+    __m256 left = _mm256_cmp_ps(x, zero, _CMP_LT_OQ);
+    __m256 right = _mm256_andnot_ps(left, _mm256_cmp_ps(x, max_x, _CMP_GE_OQ));
+    x = _mm256_blendv_ps(_mm256_blendv_ps(x, max_x, right), zero, left);
+    vx = _mm256_blendv_ps(vx, _mm256_mul_ps(_mm256_xor_ps(vx, sign), damping), _mm256_or_ps(left, right));
+
+    /* Ceiling and floor, with friction for particles sliding on the floor */
+    __m256 top = _mm256_cmp_ps(y, zero, _CMP_LT_OQ);
+    __m256 bottom = _mm256_andnot_ps(top, _mm256_cmp_ps(y, max_y, _CMP_GE_OQ));
+    y = _mm256_blendv_ps(_mm256_blendv_ps(y, max_y, bottom), zero, top);
+    vy = _mm256_blendv_ps(vy, _mm256_mul_ps(_mm256_xor_ps(vy, sign), damping), _mm256_or_ps(top, bottom));
+    __m256 rubbing = _mm256_and_ps(bottom, _mm256_cmp_ps(_mm256_andnot_ps(sign, vy),
+                                                         _mm256_set1_ps(2.0f), _CMP_LT_OQ));
+    vx = _mm256_blendv_ps(vx, _mm256_mul_ps(vx, _mm256_set1_ps(GROUND_FRICTION)), rubbing);
+
+    *x_io = x;
+    *y_io = y;
+    *vx_io = vx;
+    *vy_io = vy;
+
+    __m256 rest = _mm256_and_ps(_mm256_cmp_ps(y, _mm256_set1_ps(params->height - 2), _CMP_GE_OQ),
+                                _mm256_and_ps(_mm256_cmp_ps(_mm256_andnot_ps(sign, vx), slow, _CMP_LT_OQ),
+                                              _mm256_cmp_ps(_mm256_andnot_ps(sign, vy), slow, _CMP_LT_OQ)));
+    return _mm256_movemask_ps(rest);
+}
+
+PHYSICS_TARGET_AVX2
+static int avx2_step_fused(ParticleSoA *particles, const PhysicsStepParams *params,
+                           uint8_t *despawn) {
+    float *px = particles->x, *py = particles->y;
+    float *pvx = particles->vx, *pvy = particles->vy;
+    const int count = particles->count;
+    const int vectorized_count = count & ~7;
+    int despawned = 0;
+    int i = 0;
+
+    for (; i < vectorized_count; i += 8) {
+        __m256 x = _mm256_loadu_ps(px + i), y = _mm256_loadu_ps(py + i);
+        __m256 vx = _mm256_loadu_ps(pvx + i), vy = _mm256_loadu_ps(pvy + i);
+        int bits = avx2_step_block(&x, &y, &vx, &vy, params);
+        _mm256_storeu_ps(px + i, x);
+        _mm256_storeu_ps(py + i, y);
+        _mm256_storeu_ps(pvx + i, vx);
+        _mm256_storeu_ps(pvy + i, vy);
+
+        for (int lane = 0; lane < 8; lane++) {
+            despawn[i + lane] = (uint8_t)((bits >> lane) & 1);
+        }
+        despawned += __builtin_popcount((unsigned)bits);
+    }
+
+    /* Masked tail: lanes past the end are neither read nor written */
+    if (i < count) {
+        const int remaining = count - i;
+        const __m256i mask = _mm256_cmpgt_epi32(_mm256_set1_epi32(remaining),
+                                                _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+        __m256 x = _mm256_maskload_ps(px + i, mask), y = _mm256_maskload_ps(py + i, mask);
+        __m256 vx = _mm256_maskload_ps(pvx + i, mask), vy = _mm256_maskload_ps(pvy + i, mask);
+        int bits = avx2_step_block(&x, &y, &vx, &vy, params) & ((1 << remaining) - 1);
+        _mm256_maskstore_ps(px + i, mask, x);
+        _mm256_maskstore_ps(py + i, mask, y);
+        _mm256_maskstore_ps(pvx + i, mask, vx);
+        _mm256_maskstore_ps(pvy + i, mask, vy);
+
+        for (int lane = 0; lane < remaining; lane++) {
+            despawn[i + lane] = (uint8_t)((bits >> lane) & 1);
+        }
+        despawned += __builtin_popcount((unsigned)bits);
+    }
+
+    return despawned;
+}
+
+/* Apply one field to sixteen particles: 1 / dist from a refined rsqrt
+ * estimate and the cutoffs as a lane mask */
+PHYSICS_TARGET_AVX512
+static inline void avx512_apply_field(__m512 x, __m512 y, __m512 *vx, __m512 *vy,
+                                      const ForceField *field, float dt) {
+    if (field->type == FORCE_FIELD_DIRECTIONAL) {
+        *vx = _mm512_add_ps(*vx, _mm512_set1_ps(field->direction_x * field->strength * dt));
+        *vy = _mm512_add_ps(*vy, _mm512_set1_ps(field->direction_y * field->strength * dt));
+        return;
+    }
+
+    const FieldLanes lanes = field_lanes(field);
+    __m512 dx = _mm512_sub_ps(x, _mm512_set1_ps(lanes.fx));
+    __m512 dy = _mm512_sub_ps(y, _mm512_set1_ps(lanes.fy));
+    __m512 d2 = _mm512_add_ps(_mm512_mul_ps(dx, dx), _mm512_mul_ps(dy, dy));
+
+    /* Lanes inside the radius and clear of the singularity */
+    __mmask16 mask = _mm512_cmp_ps_mask(d2, _mm512_set1_ps(lanes.min_d2), _CMP_NLT_UQ) &
+                     _mm512_cmp_ps_mask(d2, _mm512_set1_ps(lanes.max_d2), _CMP_NGT_UQ);
+    if (mask == 0) {
+        return;
+    }
+
+    /* 1 / dist: estimate plus one Newton-Raphson step */
+    __m512 inv = _mm512_rsqrt14_ps(d2);
+    inv = _mm512_mul_ps(inv, _mm512_sub_ps(_mm512_set1_ps(1.5f),
+                                           _mm512_mul_ps(_mm512_mul_ps(_mm512_set1_ps(0.5f), d2),
+                                                         _mm512_mul_ps(inv, inv))));
+
+    __m512 strength_dt = _mm512_set1_ps(lanes.strength * dt);
+    __m512 scale = lanes.falloff > 0.0f ?
+        _mm512_div_ps(_mm512_mul_ps(strength_dt, inv),
+                      _mm512_add_ps(_mm512_set1_ps(1.0f),
+                                    _mm512_mul_ps(_mm512_set1_ps(lanes.falloff), _mm512_mul_ps(d2, inv)))) :
+        _mm512_mul_ps(strength_dt, _mm512_mul_ps(inv, _mm512_mul_ps(inv, inv)));
+
+    __m512 inc_x = lanes.tangential ?
+        _mm512_mul_ps(_mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(dy),
+                                                            _mm512_set1_epi32((int)0x80000000))), scale) :
+        _mm512_mul_ps(dx, scale);
+    __m512 inc_y = lanes.tangential ? _mm512_mul_ps(dx, scale) : _mm512_mul_ps(dy, scale);
+    *vx = _mm512_mask_add_ps(*vx, mask, *vx, inc_x);
+    *vy = _mm512_mask_add_ps(*vy, mask, *vy, inc_y);
+}
+
+PHYSICS_TARGET_AVX512
+static int avx512_step_fused(ParticleSoA *particles, const PhysicsStepParams *params,
+                             uint8_t *despawn) {
+    const float dt = params->dt;
+    const __m512 dt_vec = _mm512_set1_ps(dt);
+    const __m512 ax_dt = _mm512_set1_ps(params->windx * dt);
+    const __m512 ay_dt = _mm512_set1_ps((params->gravity + params->windy) * dt);
+    const __m512 zero = _mm512_setzero_ps();
+    const __m512 max_x = _mm512_set1_ps(params->width - 1);
+    const __m512 max_y = _mm512_set1_ps(params->height - 1);
+    const __m512 rest_y = _mm512_set1_ps(params->height - 2);
+    const __m512 damping = _mm512_set1_ps(WALL_DAMPING);
+    const __m512 friction = _mm512_set1_ps(GROUND_FRICTION);
+    const __m512i sign = _mm512_set1_epi32((int)0x80000000);
+    const __m512 slow = _mm512_set1_ps(0.5f);
+    const __m512 sliding = _mm512_set1_ps(2.0f);
+    const __m512i one_byte = _mm512_set1_epi32(1);
+
+    float *px = particles->x, *py = particles->y;
+    float *pvx = particles->vx, *pvy = particles->vy;
+    const int count = particles->count;
+    int despawned = 0;
+
+    for (int i = 0; i < count; i += 16) {
+        int remaining = count - i;
+        __mmask16 valid = remaining >= 16 ? (__mmask16)0xFFFF : (__mmask16)((1u << remaining) - 1);
+
+        __m512 vx = _mm512_add_ps(_mm512_maskz_loadu_ps(valid, pvx + i), ax_dt);
+        __m512 vy = _mm512_add_ps(_mm512_maskz_loadu_ps(valid, pvy + i), ay_dt);
+        __m512 x = _mm512_add_ps(_mm512_maskz_loadu_ps(valid, px + i), _mm512_mul_ps(vx, dt_vec));
+        __m512 y = _mm512_add_ps(_mm512_maskz_loadu_ps(valid, py + i), _mm512_mul_ps(vy, dt_vec));
+
+        for (int f = 0; f < params->num_fields; f++) {
+            if (params->fields[f].active) {
+                avx512_apply_field(x, y, &vx, &vy, &params->fields[f], dt);
+            }
+        }
+
+        /* Side walls */
+        __mmask16 left = _mm512_cmp_ps_mask(x, zero, _CMP_LT_OQ);
+        __mmask16 right = _mm512_cmp_ps_mask(x, max_x, _CMP_GE_OQ) & (__mmask16)~left;
+        x = _mm512_mask_blend_ps(left, _mm512_mask_blend_ps(right, x, max_x), zero);
+        __m512 bounced_vx = _mm512_mul_ps(_mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(vx), sign)), damping);
+        vx = _mm512_mask_blend_ps(left | right, vx, bounced_vx);
+
+        /* Ceiling and floor, with friction for particles sliding on the floor */
+        __mmask16 top = _mm512_cmp_ps_mask(y, zero, _CMP_LT_OQ);
+        __mmask16 bottom = _mm512_cmp_ps_mask(y, max_y, _CMP_GE_OQ) & (__mmask16)~top;
+        y = _mm512_mask_blend_ps(top, _mm512_mask_blend_ps(bottom, y, max_y), zero);
+        __m512 bounced_vy = _mm512_mul_ps(_mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(vy), sign)), damping);
+        vy = _mm512_mask_blend_ps(top | bottom, vy, bounced_vy);
+        __mmask16 rubbing = bottom & _mm512_cmp_ps_mask(_mm512_abs_ps(vy), sliding, _CMP_LT_OQ);
+        vx = _mm512_mask_mul_ps(vx, rubbing, vx, friction);
+
+        _mm512_mask_storeu_ps(px + i, valid, x);
+        _mm512_mask_storeu_ps(py + i, valid, y);
+        _mm512_mask_storeu_ps(pvx + i, valid, vx);
+        _mm512_mask_storeu_ps(pvy + i, valid, vy);
+
+        __mmask16 rest = valid &
+                         _mm512_cmp_ps_mask(y, rest_y, _CMP_GE_OQ) &
+                         _mm512_cmp_ps_mask(_mm512_abs_ps(vx), slow, _CMP_LT_OQ) &
+                         _mm512_cmp_ps_mask(_mm512_abs_ps(vy), slow, _CMP_LT_OQ);
+        _mm512_mask_cvtepi32_storeu_epi8(despawn + i, valid, _mm512_maskz_mov_epi32(rest, one_byte));
+        despawned += __builtin_popcount((unsigned)rest);
+    }
+
+    return despawned;
+}
+#endif
+
+/* AVX2 fused kernel: eight particles per iteration, masked remainder */
+int physics_step_fused_avx2(ParticleSoA *particles, const PhysicsStepParams *params,
+                            uint8_t *despawn) {
+    #if defined(__x86_64__) || defined(__i386__)
+    if (!particles || !params || !despawn) return 0;
+    return avx2_step_fused(particles, params, despawn);
+    #else
+    return physics_step_fused_scalar(particles, params, despawn);
+    #endif
+}
+
+/* AVX-512 fused kernel: sixteen particles per iteration, masked remainder
+ * (no scalar epilogue) */
+int physics_step_fused_avx512(ParticleSoA *particles, const PhysicsStepParams *params,
+                              uint8_t *despawn) {
+    #if defined(__x86_64__) || defined(__i386__)
+    if (!particles || !params || !despawn) return 0;
+    return avx512_step_fused(particles, params, despawn);
+    #else
+    return physics_step_fused_scalar(particles, params, despawn);
+    #endif
+}
+
+/* Pick the best fused kernel for this CPU */
+physics_step_func_t physics_select_step_function(void) {
+    if (simd_is_supported(SIMD_AVX512F)) {
+        return physics_step_fused_avx512;
+    }
+    if (simd_is_supported(SIMD_AVX2)) {
+        return physics_step_fused_avx2;
+    }
+    if (simd_is_supported(SIMD_NEON)) {
+        return physics_step_fused_neon;
+    }
+    if (simd_is_supported(SIMD_SSE2)) {
+        return physics_step_fused_sse;
+    }
+    return physics_step_fused_scalar;
+}
+
+const char *physics_get_step_function_name(physics_step_func_t func) {
+    if (func == physics_step_fused_avx512) return "AVX-512 (fused)";
+    if (func == physics_step_fused_avx2) return "AVX2 (fused)";
+    if (func == physics_step_fused_neon) return "NEON (fused)";
+    if (func == physics_step_fused_sse) return "SSE2 (fused)";
+    if (func == physics_step_fused_scalar) return "Scalar (fused)";
+    return "Unknown";
+}
+
+/* Pick the best fused kernel with error handling */
+Error physics_select_step_function_with_error(physics_step_func_t *func_out) {
+    ERROR_CHECK_NULL(func_out, "Step function output pointer");
+
+    *func_out = physics_select_step_function();
+    return (Error){SUCCESS, NULL, NULL, 0, NULL};
+}
+
+/* ===== FIELD-MAJOR FORCE-FIELD KERNELS ===== */
+
+#if defined(__SSE2__)
+/* One point field over all particles, four at a time */
+static void sse_field_pass(ParticleSoA *particles, const ForceField *field, float dt) {
+    const FieldLanes lanes = field_lanes(field);
+    const __m128 fx = _mm_set1_ps(lanes.fx);
+    const __m128 fy = _mm_set1_ps(lanes.fy);
+    const __m128 min_d2 = _mm_set1_ps(lanes.min_d2);
+    const __m128 max_d2 = _mm_set1_ps(lanes.max_d2);
+    const __m128 strength_dt = _mm_set1_ps(lanes.strength * dt);
+    const __m128 falloff = _mm_set1_ps(lanes.falloff);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 three_halves = _mm_set1_ps(1.5f);
+
+    float *px = particles->x, *py = particles->y;
+    float *pvx = particles->vx, *pvy = particles->vy;
+    const int vectorized_count = particles->count & ~3;
+    int i = 0;
+
+    for (; i < vectorized_count; i += 4) {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(px + i), fx);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(py + i), fy);
+        __m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+
+        /* Same cutoffs as scalar: d2 computed identically, so lanes agree */
+        __m128 mask = _mm_and_ps(_mm_cmpnlt_ps(d2, min_d2), _mm_cmpngt_ps(d2, max_d2));
+        if (_mm_movemask_ps(mask) == 0) continue;
+
+        /* 1 / dist: estimate plus one Newton-Raphson step */
+        __m128 inv = _mm_rsqrt_ps(d2);
+        inv = _mm_mul_ps(inv, _mm_sub_ps(three_halves, _mm_mul_ps(_mm_mul_ps(half, d2), _mm_mul_ps(inv, inv))));
+
+        __m128 scale = lanes.falloff > 0.0f ?
+            _mm_div_ps(_mm_mul_ps(strength_dt, inv),
+                       _mm_add_ps(one, _mm_mul_ps(falloff, _mm_mul_ps(d2, inv)))) :
+            _mm_mul_ps(strength_dt, _mm_mul_ps(inv, _mm_mul_ps(inv, inv)));
+        scale = _mm_and_ps(mask, scale);
+
+        __m128 inc_x = lanes.tangential ? _mm_mul_ps(_mm_xor_ps(dy, _mm_set1_ps(-0.0f)), scale)
+                                        : _mm_mul_ps(dx, scale);
+        __m128 inc_y = lanes.tangential ? _mm_mul_ps(dx, scale) : _mm_mul_ps(dy, scale);
+        _mm_storeu_ps(pvx + i, _mm_add_ps(_mm_loadu_ps(pvx + i), inc_x));
+        _mm_storeu_ps(pvy + i, _mm_add_ps(_mm_loadu_ps(pvy + i), inc_y));
+    }
+
+    for (; i < particles->count; i++) {
+        apply_field(px[i], py[i], &pvx[i], &pvy[i], field, dt);
+    }
+}
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+/* One point field over all particles, eight at a time */
+PHYSICS_TARGET_AVX2
+static void avx2_field_pass(ParticleSoA *particles, const ForceField *field, float dt) {
+    const FieldLanes lanes = field_lanes(field);
+    const __m256 fx = _mm256_set1_ps(lanes.fx);
+    const __m256 fy = _mm256_set1_ps(lanes.fy);
+    const __m256 min_d2 = _mm256_set1_ps(lanes.min_d2);
+    const __m256 max_d2 = _mm256_set1_ps(lanes.max_d2);
+    const __m256 strength_dt = _mm256_set1_ps(lanes.strength * dt);
+    const __m256 falloff = _mm256_set1_ps(lanes.falloff);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 three_halves = _mm256_set1_ps(1.5f);
+
+    float *px = particles->x, *py = particles->y;
+    float *pvx = particles->vx, *pvy = particles->vy;
+    const int vectorized_count = particles->count & ~7;
+    int i = 0;
+
+    for (; i < vectorized_count; i += 8) {
+        __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(px + i), fx);
+        __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(py + i), fy);
+        __m256 d2 = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+
+        __m256 mask = _mm256_and_ps(_mm256_cmp_ps(d2, min_d2, _CMP_NLT_UQ),
+                                    _mm256_cmp_ps(d2, max_d2, _CMP_NGT_UQ));
+        if (_mm256_movemask_ps(mask) == 0) continue;
+
+        __m256 inv = _mm256_rsqrt_ps(d2);
+        inv = _mm256_mul_ps(inv, _mm256_sub_ps(three_halves,
+                                               _mm256_mul_ps(_mm256_mul_ps(half, d2), _mm256_mul_ps(inv, inv))));
+
+        __m256 scale = lanes.falloff > 0.0f ?
+            _mm256_div_ps(_mm256_mul_ps(strength_dt, inv),
+                          _mm256_add_ps(one, _mm256_mul_ps(falloff, _mm256_mul_ps(d2, inv)))) :
+            _mm256_mul_ps(strength_dt, _mm256_mul_ps(inv, _mm256_mul_ps(inv, inv)));
+        scale = _mm256_and_ps(mask, scale);
+
+        __m256 inc_x = lanes.tangential ? _mm256_mul_ps(_mm256_xor_ps(dy, _mm256_set1_ps(-0.0f)), scale)
+                                        : _mm256_mul_ps(dx, scale);
+        __m256 inc_y = lanes.tangential ? _mm256_mul_ps(dx, scale) : _mm256_mul_ps(dy, scale);
+        _mm256_storeu_ps(pvx + i, _mm256_add_ps(_mm256_loadu_ps(pvx + i), inc_x));
+        _mm256_storeu_ps(pvy + i, _mm256_add_ps(_mm256_loadu_ps(pvy + i), inc_y));
+    }
+
+    for (; i < particles->count; i++) {
+        apply_field(px[i], py[i], &pvx[i], &pvy[i], field, dt);
+    }
+}
+
+/* One point field over all particles, sixteen at a time with a masked tail */
+PHYSICS_TARGET_AVX512
+static void avx512_field_pass(ParticleSoA *particles, const ForceField *field, float dt) {
+    const FieldLanes lanes = field_lanes(field);
+    const __m512 fx = _mm512_set1_ps(lanes.fx);
+    const __m512 fy = _mm512_set1_ps(lanes.fy);
+    const __m512 min_d2 = _mm512_set1_ps(lanes.min_d2);
+    const __m512 max_d2 = _mm512_set1_ps(lanes.max_d2);
+    const __m512 strength_dt = _mm512_set1_ps(lanes.strength * dt);
+    const __m512 falloff = _mm512_set1_ps(lanes.falloff);
+    const __m512 one = _mm512_set1_ps(1.0f);
+    const __m512 half = _mm512_set1_ps(0.5f);
+    const __m512 three_halves = _mm512_set1_ps(1.5f);
+    const __m512i sign = _mm512_set1_epi32((int)0x80000000);
+
+    float *px = particles->x, *py = particles->y;
+    float *pvx = particles->vx, *pvy = particles->vy;
+    const int count = particles->count;
+
+    for (int i = 0; i < count; i += 16) {
+        int remaining = count - i;
+        __mmask16 valid = remaining >= 16 ? (__mmask16)0xFFFF : (__mmask16)((1u << remaining) - 1);
+
+        __m512 dx = _mm512_sub_ps(_mm512_maskz_loadu_ps(valid, px + i), fx);
+        __m512 dy = _mm512_sub_ps(_mm512_maskz_loadu_ps(valid, py + i), fy);
+        __m512 d2 = _mm512_add_ps(_mm512_mul_ps(dx, dx), _mm512_mul_ps(dy, dy));
+
+        __mmask16 mask = valid &
+                         _mm512_cmp_ps_mask(d2, min_d2, _CMP_NLT_UQ) &
+                         _mm512_cmp_ps_mask(d2, max_d2, _CMP_NGT_UQ);
+        if (mask == 0) continue;
+
+        __m512 inv = _mm512_rsqrt14_ps(d2);
+        inv = _mm512_mul_ps(inv, _mm512_sub_ps(three_halves,
+                                               _mm512_mul_ps(_mm512_mul_ps(half, d2), _mm512_mul_ps(inv, inv))));
+
+        __m512 scale = lanes.falloff > 0.0f ?
+            _mm512_div_ps(_mm512_mul_ps(strength_dt, inv),
+                          _mm512_add_ps(one, _mm512_mul_ps(falloff, _mm512_mul_ps(d2, inv)))) :
+            _mm512_mul_ps(strength_dt, _mm512_mul_ps(inv, _mm512_mul_ps(inv, inv)));
+
+        __m512 inc_x = lanes.tangential ?
+            _mm512_mul_ps(_mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(dy), sign)), scale) :
+            _mm512_mul_ps(dx, scale);
+        __m512 inc_y = lanes.tangential ? _mm512_mul_ps(dx, scale) : _mm512_mul_ps(dy, scale);
+        __m512 vx = _mm512_maskz_loadu_ps(mask, pvx + i);
+        __m512 vy = _mm512_maskz_loadu_ps(mask, pvy + i);
+        _mm512_mask_storeu_ps(pvx + i, mask, _mm512_add_ps(vx, inc_x));
+        _mm512_mask_storeu_ps(pvy + i, mask, _mm512_add_ps(vy, inc_y));
+    }
+}
+#endif
+
+/* SSE2 field-major pass */
+void physics_apply_force_fields_sse(ParticleSoA *particles,
+                                    ForceField *fields, int num_fields, float dt) {
+    #if defined(__SSE2__)
+    if (!particles || !fields) return;
+
+    for (int j = 0; j < num_fields; j++) {
+        if (!fields[j].active) continue;
+        if (fields[j].type == FORCE_FIELD_DIRECTIONAL) {
+            apply_directional_pass(particles, &fields[j], dt);
+        } else {
+            sse_field_pass(particles, &fields[j], dt);
+        }
+    }
+    #else
+    physics_apply_force_fields(particles, fields, num_fields, dt);
+    #endif
+}
+
+/* AVX2 field-major pass */
+void physics_apply_force_fields_avx2(ParticleSoA *particles,
+                                     ForceField *fields, int num_fields, float dt) {
+    #if defined(__x86_64__) || defined(__i386__)
+    if (!particles || !fields) return;
+
+    for (int j = 0; j < num_fields; j++) {
+        if (!fields[j].active) continue;
+        if (fields[j].type == FORCE_FIELD_DIRECTIONAL) {
+            apply_directional_pass(particles, &fields[j], dt);
+        } else {
+            avx2_field_pass(particles, &fields[j], dt);
+        }
+    }
+    #else
+    physics_apply_force_fields(particles, fields, num_fields, dt);
+    #endif
+}
+
+/* AVX-512 field-major pass */
+void physics_apply_force_fields_avx512(ParticleSoA *particles,
+                                       ForceField *fields, int num_fields, float dt) {
+    #if defined(__x86_64__) || defined(__i386__)
+    if (!particles || !fields) return;
 
-        for (int j = 0; j < num_fields; j++) {
-            physics_apply_force_field(particles[i], &fields[j], dt);
+    for (int j = 0; j < num_fields; j++) {
+        if (!fields[j].active) continue;
+        if (fields[j].type == FORCE_FIELD_DIRECTIONAL) {
+            apply_directional_pass(particles, &fields[j], dt);
+        } else {
+            avx512_field_pass(particles, &fields[j], dt);
         }
     }
+    #else
+    physics_apply_force_fields(particles, fields, num_fields, dt);
+    #endif
 }
 
 /* Create radial force field */
@@ -3,14 +3,19 @@
 
 #include "particle.h"
 #include "spatial_grid.h"
+#include "arena.h"
+#include "thread_pool.h"
+#include "neighbor_list.h"
+#include "spatial_hash.h"
 #include "error.h"
 #include <stdbool.h>
+#include <stdint.h>
 
 /**
  * Advanced Physics System
  *
  * Collision Detection:
- * - Particle-particle collisions using spatial grid
+ * - Particle-particle collisions using spatial grid or sparse spatial hash
  * - Elastic collision response with momentum conservation
  * - Configurable collision radius and restitution
  *
@@ -51,16 +56,60 @@ typedef struct {
 /**
  * Detect and resolve collisions between particles
  *
- * Uses spatial grid for O(n) performance instead of O(n²)
+ * Walks the grid with a half stencil: every cell is tested against itself
+ * and four forward neighbours (east, south-west, south, south-east), so
+ * each neighbouring pair is tested exactly once with no per-particle
+ * neighbour copies and no cap on cell density. Cells are visited in the
+ * colour order of physics_resolve_collisions_parallel().
  *
- * @param grid Spatial grid containing particles
- * @param particles Array of all particles
- * @param num_particles Number of particles
+ * @param grid Spatial grid containing particle indices
+ * @param particles Particle columns the grid indices refer to
  * @param settings Collision settings
- * @return Number of collisions resolved
+ * @param arena Frame arena for scratch memory (may be NULL)
+ * @return Number of colliding pairs resolved
  */
-int physics_resolve_collisions(SpatialGrid *grid, Particle **particles,
-                               int num_particles, CollisionSettings *settings);
+int physics_resolve_collisions(SpatialGrid *grid, ParticleSoA *particles,
+                               CollisionSettings *settings, FrameArena *arena);
+
+/**
+ * Detect and resolve collisions on a worker pool
+ *
+ * Cells are coloured by (row mod 2, col mod 3); same-coloured half
+ * stencils never share a particle, so each colour is split across the
+ * pool with no locking. Every thread count visits pairs in the same
+ * order, so results match the single-threaded pass exactly.
+ *
+ * @param pool Worker pool (NULL = calling thread only)
+ * @param arena Frame arena for per-worker counts (NULL = calling thread only)
+ * @return Number of colliding pairs resolved
+ */
+int physics_resolve_collisions_parallel(SpatialGrid *grid, ParticleSoA *particles,
+                                        CollisionSettings *settings, FrameArena *arena,
+                                        ThreadPool *pool);
+
+/**
+ * Resolve collisions from a Verlet neighbor list instead of the grid
+ *
+ * @param list Neighbor list built for particles (see neighbor_list_update)
+ * @param particles Particle columns the list indices refer to
+ * @param settings Collision settings
+ * @return Number of colliding pairs resolved
+ */
+int physics_resolve_collisions_verlet(const NeighborList *list, ParticleSoA *particles,
+                                      CollisionSettings *settings);
+
+/**
+ * Detect and resolve collisions on a sparse spatial hash, walking only
+ * occupied cells with the same half stencil as the grid pass
+ *
+ * @param hash Spatial hash holding every particle, with cells at least
+ *             2 * collision_radius wide
+ * @param particles Particle columns the hash indices refer to
+ * @param settings Collision settings
+ * @return Number of colliding pairs resolved
+ */
+int physics_resolve_collisions_hash(SpatialHash *hash, ParticleSoA *particles,
+                                    CollisionSettings *settings);
 
 /**
  * Apply force field to particle
@@ -74,15 +123,146 @@ void physics_apply_force_field(Particle *particle, ForceField *field, float dt);
 /**
  * Apply multiple force fields to all particles
  *
- * @param particles Array of particles
- * @param num_particles Number of particles
+ * @param particles Particle columns
  * @param fields Array of force fields
  * @param num_fields Number of force fields
  * @param dt Time delta
  */
-void physics_apply_force_fields(Particle **particles, int num_particles,
+void physics_apply_force_fields(ParticleSoA *particles,
                                 ForceField *fields, int num_fields, float dt);
 
+/* Largest relative difference between one field's velocity change from a
+ * vector pass and from the scalar pass (rsqrt plus one Newton step) */
+#define PHYSICS_FIELD_SIMD_TOLERANCE 1e-5f
+
+/**
+ * Field-major vector passes: one sweep per active field over the particle
+ * columns, with 1 / dist from a refined rsqrt estimate and the radius and
+ * singularity cutoffs as lane masks. Cutoffs pick the same particles as
+ * the scalar pass; each field's contribution agrees with it within
+ * PHYSICS_FIELD_SIMD_TOLERANCE. Directional fields are exact. (Fall back
+ * to the scalar pass when built for another architecture.)
+ */
+void physics_apply_force_fields_sse(ParticleSoA *particles,
+                                    ForceField *fields, int num_fields, float dt);
+void physics_apply_force_fields_avx2(ParticleSoA *particles,
+                                     ForceField *fields, int num_fields, float dt);
+void physics_apply_force_fields_avx512(ParticleSoA *particles,
+                                       ForceField *fields, int num_fields, float dt);
+
+/* Culled fields whose box holds more than this share of the binned
+ * particles are left to the full pass, whose vector kernels outrun a
+ * scalar walk over most of the population */
+#define PHYSICS_FIELD_CULL_MAX_FRACTION 0.125f
+
+/**
+ * Check whether a field only reaches a bounded area: an active radial,
+ * vortex or attractor field with a finite center and radius > 0
+ */
+bool physics_force_field_is_local(const ForceField *field);
+
+/**
+ * Apply force fields, visiting only the grid cells a local field's
+ * bounding box overlaps
+ *
+ * Each local field walks the row runs of the cells covering
+ * [x - radius, x + radius] x [y - radius, y + radius], so its cost follows
+ * the particles near it rather than the population. The grid must bin the
+ * current positions of particles.
+ *
+ * With rest_out NULL every field is applied here, in array order, with
+ * the same results as physics_apply_force_fields(). Otherwise fields that
+ * are not local, or whose box holds more than
+ * PHYSICS_FIELD_CULL_MAX_FRACTION of the particles, are copied to rest_out
+ * (num_fields entries) for the caller's full pass instead. Both groups
+ * keep their array order, but a particle sees the fields applied here
+ * before those handed back, so a mixed set is not summed in array order.
+ *
+ * @param grid Spatial grid binning particles
+ * @param particles Particle columns
+ * @param fields Array of force fields
+ * @param num_fields Number of force fields
+ * @param dt Time delta
+ * @param rest_out Fields left for a full pass (NULL = apply them here)
+ * @return Number of fields copied to rest_out
+ */
+int physics_apply_force_fields_culled(SpatialGrid *grid, ParticleSoA *particles,
+                                      ForceField *fields, int num_fields, float dt,
+                                      ForceField *rest_out);
+
+/* Local fields whose box holds fewer binned particles than this stay on
+ * the calling thread when culled across a pool */
+#define PHYSICS_FIELD_CULL_PARALLEL_MIN 2048
+
+/**
+ * Parallel physics_apply_force_fields_culled(): fields are applied one
+ * after another, and the rows of each busy field's box are split across
+ * the pool. Rows hold disjoint particles, so results match the serial
+ * walk exactly.
+ *
+ * @param pool Worker pool (NULL = serial)
+ * @return Number of fields copied to rest_out
+ */
+int physics_apply_force_fields_culled_parallel(SpatialGrid *grid, ParticleSoA *particles,
+                                               ForceField *fields, int num_fields, float dt,
+                                               ForceField *rest_out, ThreadPool *pool);
+
+/**
+ * Split active fields into the ones worth culling and the rest, with the
+ * same test as physics_apply_force_fields_culled() against the grid's
+ * current binning. Nothing is applied; inactive fields are dropped.
+ *
+ * @param grid Spatial grid binning particles
+ * @param fields Array of force fields
+ * @param num_fields Number of force fields
+ * @param local_out Fields to cull (num_fields entries)
+ * @param num_local_out Receives the number of fields in local_out
+ * @param rest_out Fields left for a full pass (num_fields entries)
+ * @return Number of fields copied to rest_out
+ */
+int physics_partition_force_fields(SpatialGrid *grid, const ForceField *fields, int num_fields,
+                                   ForceField *local_out, int *num_local_out, ForceField *rest_out);
+
+/* Per-step parameters for the fused step kernels */
+typedef struct {
+    float dt;                /* Time delta */
+    float gravity;           /* Downward acceleration */
+    float windx, windy;      /* Wind acceleration */
+    float width, height;     /* World size; walls sit at 0 and size - 1 */
+    const ForceField *fields; /* Force fields (inactive ones are skipped) */
+    int num_fields;
+} PhysicsStepParams;
+
+/**
+ * Fused step kernel: integrate, apply force fields, reflect off walls
+ * with ground friction and test for despawn in one pass, so each particle
+ * is loaded and stored once per step.
+ *
+ * Particles are updated in place and never removed; despawn[i] is set to
+ * 1 for particles that came to rest on the floor and 0 otherwise.
+ *
+ * @return Number of particles marked for despawn
+ */
+typedef int (*physics_step_func_t)(ParticleSoA *particles, const PhysicsStepParams *params,
+                                   uint8_t *despawn);
+
+/* Fused step kernel implementations (vector kernels fall back to scalar
+ * when built for another architecture). The vector kernels evaluate point
+ * fields as the field-major passes do, with a refined rsqrt and lane-mask
+ * cutoffs: each field's velocity change agrees with scalar within
+ * PHYSICS_FIELD_SIMD_TOLERANCE. Integration, walls and despawn use no
+ * FMA and match scalar exactly. */
+int physics_step_fused_scalar(ParticleSoA *particles, const PhysicsStepParams *params, uint8_t *despawn);
+int physics_step_fused_sse(ParticleSoA *particles, const PhysicsStepParams *params, uint8_t *despawn);
+int physics_step_fused_avx2(ParticleSoA *particles, const PhysicsStepParams *params, uint8_t *despawn);
+int physics_step_fused_avx512(ParticleSoA *particles, const PhysicsStepParams *params, uint8_t *despawn);
+int physics_step_fused_neon(ParticleSoA *particles, const PhysicsStepParams *params, uint8_t *despawn);
+
+/* Fused kernel selection */
+physics_step_func_t physics_select_step_function(void);
+const char *physics_get_step_function_name(physics_step_func_t func);
+Error physics_select_step_function_with_error(physics_step_func_t *func_out);
+
 /**
  * Create radial force field (push/pull from center)
  *
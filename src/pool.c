@@ -411,3 +411,240 @@ Error pool_iterator_create_with_error(ParticlePool *pool, PoolIterator *iter_out
     *iter_out = iter;
     return (Error){SUCCESS, NULL, NULL, 0, NULL};
 }
+
+/* ===== STRUCTURE-OF-ARRAYS POOL ===== */
+
+/* Allocate the four particle columns as one aligned block */
+static int pool_soa_alloc_columns(ParticlePoolSoA *pool, int capacity) {
+    int padded = (capacity + POOL_SOA_LANES - 1) / POOL_SOA_LANES * POOL_SOA_LANES;
+    void *block = NULL;
+    if (posix_memalign(&block, POOL_SOA_ALIGNMENT, 4 * (size_t)padded * sizeof(float)) != 0) {
+        return 0;
+    }
+    memset(block, 0, 4 * (size_t)padded * sizeof(float));
+
+    pool->x = (float *)block;
+    pool->y = pool->x + padded;
+    pool->vx = pool->y + padded;
+    pool->vy = pool->vx + padded;
+    pool->total_capacity = capacity;
+    pool->padded_capacity = padded;
+    pool->active_count = 0;
+    memset(&pool->stats, 0, sizeof(PoolStats));
+    return 1;
+}
+
+/* Fold a timing sample into a running average */
+static double pool_running_average(double avg, uint64_t samples, double duration) {
+    if (samples == 1) {
+        return duration;
+    }
+    return (avg * (samples - 1) + duration) / samples;
+}
+
+/* Create a new structure-of-arrays pool with specified capacity */
+ParticlePoolSoA *pool_soa_create(int capacity) {
+    if (capacity <= 0) {
+        return NULL;
+    }
+
+    ParticlePoolSoA *pool = malloc(sizeof(ParticlePoolSoA));
+    if (!pool) {
+        return NULL;
+    }
+
+    if (!pool_soa_alloc_columns(pool, capacity)) {
+        free(pool);
+        return NULL;
+    }
+
+    return pool;
+}
+
+/* Destroy structure-of-arrays pool and free all memory */
+void pool_soa_destroy(ParticlePoolSoA *pool) {
+    if (pool) {
+        free(pool->x); /* Columns share one block starting at x */
+        free(pool);
+    }
+}
+
+/* Allocate the next dense slot, zero-initialized */
+int pool_soa_allocate(ParticlePoolSoA *pool) {
+    if (!pool || pool->active_count >= pool->total_capacity) {
+        if (pool) {
+            pool->stats.allocation_failures++;
+        }
+        return -1;
+    }
+
+    double start_time = get_time_us();
+
+    int index = pool->active_count++;
+    pool->x[index] = 0.0f;
+    pool->y[index] = 0.0f;
+    pool->vx[index] = 0.0f;
+    pool->vy[index] = 0.0f;
+
+    pool->stats.allocations++;
+    pool->stats.avg_allocation_time = pool_running_average(pool->stats.avg_allocation_time,
+                                                           pool->stats.allocations,
+                                                           get_time_us() - start_time);
+    return index;
+}
+
+/* Free a slot by moving the last active particle into it */
+void pool_soa_free(ParticlePoolSoA *pool, int index) {
+    if (!pool || index < 0 || index >= pool->active_count) {
+        return;
+    }
+
+    double start_time = get_time_us();
+
+    int last = --pool->active_count;
+    if (index != last) {
+        pool->x[index] = pool->x[last];
+        pool->y[index] = pool->y[last];
+        pool->vx[index] = pool->vx[last];
+        pool->vy[index] = pool->vy[last];
+    }
+
+    pool->stats.deallocations++;
+    pool->stats.avg_deallocation_time = pool_running_average(pool->stats.avg_deallocation_time,
+                                                             pool->stats.deallocations,
+                                                             get_time_us() - start_time);
+}
+
+/* Permute active particles into a new slot order, one column at a time */
+void pool_soa_reorder(ParticlePoolSoA *pool, const int *order, float *scratch, int *remap_out) {
+    if (!pool || !order || !scratch) {
+        return;
+    }
+
+    int count = pool->active_count;
+    float *columns[4] = { pool->x, pool->y, pool->vx, pool->vy };
+
+    for (int c = 0; c < 4; c++) {
+        float *column = columns[c];
+        for (int k = 0; k < count; k++) {
+            scratch[k] = column[order[k]];
+        }
+        memcpy(column, scratch, sizeof(float) * (size_t)count);
+    }
+
+    if (remap_out) {
+        for (int k = 0; k < count; k++) {
+            remap_out[order[k]] = k;
+        }
+    }
+}
+
+/* Release every active particle at once */
+void pool_soa_clear(ParticlePoolSoA *pool) {
+    if (pool) {
+        pool->stats.deallocations += (uint64_t)pool->active_count;
+        pool->active_count = 0;
+    }
+}
+
+/* Get number of free slots */
+int pool_soa_get_free_count(const ParticlePoolSoA *pool) {
+    return pool ? pool->total_capacity - pool->active_count : 0;
+}
+
+/* Get number of active particles */
+int pool_soa_get_active_count(const ParticlePoolSoA *pool) {
+    return pool ? pool->active_count : 0;
+}
+
+/* Get total pool capacity */
+int pool_soa_get_capacity(const ParticlePoolSoA *pool) {
+    return pool ? pool->total_capacity : 0;
+}
+
+/* Get pool utilization percentage */
+float pool_soa_get_utilization(const ParticlePoolSoA *pool) {
+    if (!pool || pool->total_capacity == 0) {
+        return 0.0f;
+    }
+    return (float)pool->active_count / (float)pool->total_capacity * 100.0f;
+}
+
+/* Get a column view over the active particles */
+ParticleSoA pool_soa_get_view(const ParticlePoolSoA *pool) {
+    ParticleSoA view = {0};
+    if (pool) {
+        view.x = pool->x;
+        view.y = pool->y;
+        view.vx = pool->vx;
+        view.vy = pool->vy;
+        view.count = pool->active_count;
+    }
+    return view;
+}
+
+/* Get pool statistics */
+PoolStats pool_soa_get_stats(const ParticlePoolSoA *pool) {
+    PoolStats stats = {0};
+    if (pool) {
+        stats = pool->stats;
+    }
+    return stats;
+}
+
+/* Debug function to print structure-of-arrays pool status */
+void pool_soa_print_status(const ParticlePoolSoA *pool) {
+    if (!pool) {
+        printf("Pool: NULL\n");
+        return;
+    }
+
+    printf("Pool Status (SoA):\n");
+    printf("  Capacity: %d (padded to %d)\n", pool->total_capacity, pool->padded_capacity);
+    printf("  Active: %d\n", pool->active_count);
+    printf("  Free: %d\n", pool_soa_get_free_count(pool));
+    printf("  Utilization: %.1f%%\n", pool_soa_get_utilization(pool));
+    printf("  Allocations: %lu\n", (unsigned long)pool->stats.allocations);
+    printf("  Deallocations: %lu\n", (unsigned long)pool->stats.deallocations);
+    printf("  Failures: %lu\n", (unsigned long)pool->stats.allocation_failures);
+    printf("  Avg Allocation Time: %.2f μs\n", pool->stats.avg_allocation_time);
+    printf("  Avg Deallocation Time: %.2f μs\n", pool->stats.avg_deallocation_time);
+}
+
+/* Create a new structure-of-arrays pool with error handling */
+Error pool_soa_create_with_error(int capacity, ParticlePoolSoA **pool_out) {
+    ERROR_CHECK_CONDITION(capacity > 0, ERROR_INVALID_PARAMETER, "Pool capacity must be positive");
+    ERROR_CHECK_NULL(pool_out, "Pool output pointer");
+
+    ParticlePoolSoA *pool = error_malloc(sizeof(ParticlePoolSoA));
+    if (pool == NULL) {
+        return ERROR_CREATE(ERROR_MEMORY_ALLOCATION, "Failed to allocate pool structure");
+    }
+
+    if (!pool_soa_alloc_columns(pool, capacity)) {
+        error_free(pool);
+        return ERROR_CREATE(ERROR_MEMORY_ALLOCATION, "Failed to allocate particle columns");
+    }
+
+    *pool_out = pool;
+    return (Error){SUCCESS, NULL, NULL, 0, NULL};
+}
+
+/* Allocate a slot with error handling */
+Error pool_soa_allocate_with_error(ParticlePoolSoA *pool, int *index_out) {
+    ERROR_CHECK_NULL(pool, "Pool");
+    ERROR_CHECK_NULL(index_out, "Index output pointer");
+    ERROR_CHECK_CONDITION(pool->active_count < pool->total_capacity, ERROR_OUT_OF_RANGE, "No free particles available in pool");
+
+    *index_out = pool_soa_allocate(pool);
+    return (Error){SUCCESS, NULL, NULL, 0, NULL};
+}
+
+/* Free a slot with error handling */
+Error pool_soa_free_with_error(ParticlePoolSoA *pool, int index) {
+    ERROR_CHECK_NULL(pool, "Pool");
+    ERROR_CHECK_CONDITION(index >= 0 && index < pool->active_count, ERROR_INVALID_PARAMETER, "Invalid particle index");
+
+    pool_soa_free(pool, index);
+    return (Error){SUCCESS, NULL, NULL, 0, NULL};
+}
@@ -25,6 +25,23 @@ typedef struct {
     PoolStats stats;          /* Performance statistics */
 } ParticlePool;
 
+/* Column alignment and padding for the structure-of-arrays pool (one AVX-512 vector) */
+#define POOL_SOA_ALIGNMENT 64
+#define POOL_SOA_LANES (POOL_SOA_ALIGNMENT / (int)sizeof(float))
+
+/* Structure-of-arrays particle pool.
+ * Active particles are packed densely in slots [0, active_count) of aligned
+ * columns so SIMD kernels can stream them in place. Freeing a slot moves the
+ * last active particle into it, so indices are only stable between frees. */
+typedef struct {
+    float *x, *y;             /* Position columns */
+    float *vx, *vy;           /* Velocity columns */
+    int total_capacity;       /* Total capacity of the pool */
+    int padded_capacity;      /* Column length rounded up to POOL_SOA_LANES */
+    int active_count;         /* Number of currently active particles */
+    PoolStats stats;          /* Performance statistics */
+} ParticlePoolSoA;
+
 /* Pool iteration for active particles */
 typedef struct {
     ParticlePool *pool;
@@ -63,4 +80,29 @@ void pool_reset_stats(ParticlePool *pool);
 /* Debug function */
 void pool_print_status(const ParticlePool *pool);
 
+/* Structure-of-arrays pool management */
+ParticlePoolSoA *pool_soa_create(int capacity);
+void pool_soa_destroy(ParticlePoolSoA *pool);
+int pool_soa_allocate(ParticlePoolSoA *pool);             /* Returns slot index or -1 */
+void pool_soa_free(ParticlePoolSoA *pool, int index);     /* Swap-removes slot index */
+void pool_soa_clear(ParticlePoolSoA *pool);
+
+int pool_soa_get_free_count(const ParticlePoolSoA *pool);
+int pool_soa_get_active_count(const ParticlePoolSoA *pool);
+int pool_soa_get_capacity(const ParticlePoolSoA *pool);
+float pool_soa_get_utilization(const ParticlePoolSoA *pool);
+ParticleSoA pool_soa_get_view(const ParticlePoolSoA *pool);
+
+/* Permute active particles so slot k holds the particle from slot order[k].
+ * scratch must hold active_count floats; remap_out (optional, active_count
+ * entries) receives the new slot of each old slot for fixing up handles. */
+void pool_soa_reorder(ParticlePoolSoA *pool, const int *order, float *scratch, int *remap_out);
+PoolStats pool_soa_get_stats(const ParticlePoolSoA *pool);
+void pool_soa_print_status(const ParticlePoolSoA *pool);
+
+/* Error-aware structure-of-arrays pool functions */
+Error pool_soa_create_with_error(int capacity, ParticlePoolSoA **pool_out);
+Error pool_soa_allocate_with_error(ParticlePoolSoA *pool, int *index_out);
+Error pool_soa_free_with_error(ParticlePoolSoA *pool, int index);
+
 #endif /* POOL_H */
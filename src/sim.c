@@ -4,6 +4,8 @@
 #include "error.h"
 #include "spatial_grid.h"
 #include "physics.h"
+#include "thread_pool.h"
+#include "dispatch.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -30,29 +32,250 @@ static float rand_range(uint32_t *state, float min, float max) {
     return min + (max - min) * rand_float(state);
 }
 
-/* Ensure the simulation has a SIMD buffer with at least required_count slots */
-static Particle *sim_acquire_simd_buffer(Simulation *sim, int required_count) {
-    if (!sim || required_count <= 0) {
-        return NULL;
+/* Gather the per-step kernel parameters */
+static PhysicsStepParams sim_step_params(const Simulation *sim, float dt, bool apply_fields) {
+    PhysicsStepParams params = {
+        .dt = dt,
+        .gravity = sim->gravity,
+        .windx = sim->windx,
+        .windy = sim->windy,
+        .width = (float)sim->width,
+        .height = (float)sim->height,
+        .fields = NULL,
+        .num_fields = 0
+    };
+    if (apply_fields && sim->force_fields && sim->num_force_fields > 0) {
+        params.fields = sim->force_fields;
+        params.num_fields = sim->num_force_fields;
     }
+    return params;
+}
+
+/* Start a new frame: release last frame's scratch memory */
+static void sim_begin_frame(Simulation *sim) {
+    arena_reset(sim->frame_arena);
+}
 
-    if (sim->simd_buffer && sim->simd_buffer_capacity >= required_count) {
-        return sim->simd_buffer;
+/* Remove particles the step kernel marked for despawn. Walks from the back
+ * so every slot refilled by swap-remove has already been visited and kept. */
+static void sim_compact_despawned(Simulation *sim, const uint8_t *despawn, int count) {
+    for (int i = count - 1; i >= 0; i--) {
+        if (despawn[i]) {
+            pool_soa_free(sim->pool, i);
+        }
     }
+    /* Swap-remove renumbered particles */
+    neighbor_list_invalidate(sim->neighbor_list);
+}
 
-    size_t alignment = simd_get_preferred_alignment();
-    Particle *new_buffer = (Particle *)simd_aligned_alloc((size_t)required_count * sizeof(Particle), alignment);
-    if (!new_buffer) {
-        return NULL;
+/* Reorder particle storage on the configured interval */
+static void sim_maybe_reorder(Simulation *sim) {
+    if (sim->reorder_interval <= 0 || --sim->reorder_countdown > 0) {
+        return;
     }
+    sim->reorder_countdown = sim->reorder_interval;
+    sim_reorder_particles(sim, NULL);
+}
 
-    if (sim->simd_buffer) {
-        simd_aligned_free(sim->simd_buffer);
+/* Shared state for one parallel step */
+typedef struct {
+    ParticlePoolSoA *pool;
+    uint8_t *despawn_flags;
+    physics_step_func_t func;
+    const PhysicsStepParams *params;
+    const FieldLattice *lattice;   /* Baked fields to sample first (NULL = none) */
+    int despawned;
+} SimStepJob;
+
+/* Run the fused kernel on one chunk; despawns are only marked */
+static void sim_step_chunk(void *ctx, int begin, int end, int worker_id) {
+    SimStepJob *job = (SimStepJob *)ctx;
+    ParticlePoolSoA *pool = job->pool;
+    (void)worker_id;
+
+    ParticleSoA chunk = {
+        pool->x + begin, pool->y + begin, pool->vx + begin, pool->vy + begin, end - begin
+    };
+    if (job->lattice) {
+        dispatch_get()->lattice_sample(job->lattice, &chunk, job->params->dt);
     }
+    int despawned = job->func(&chunk, job->params, job->despawn_flags + begin);
+    if (despawned > 0) {
+        __atomic_fetch_add(&job->despawned, despawned, __ATOMIC_RELAXED);
+    }
+}
 
-    sim->simd_buffer = new_buffer;
-    sim->simd_buffer_capacity = required_count;
-    return sim->simd_buffer;
+/* Chunk size for parallel steps: a few chunks per worker so stealing can
+ * rebalance, rounded to whole vectors so every chunk stays aligned */
+static int sim_parallel_grain(const Simulation *sim, int count) {
+    int workers = thread_pool_get_thread_count(sim->workers);
+    int grain = count / (workers * 4);
+    if (grain < SIM_PARALLEL_MIN_GRAIN) {
+        grain = SIM_PARALLEL_MIN_GRAIN;
+    }
+    return (grain + POOL_SOA_LANES - 1) / POOL_SOA_LANES * POOL_SOA_LANES;
+}
+
+/* Integrate all particles, apply force fields and walls, and despawn,
+ * in a single fused pass (split across the worker pool if enabled).
+ * Returns false if the frame arena could not supply despawn marks. */
+static bool sim_integrate(Simulation *sim, physics_step_func_t func, float dt, bool apply_fields) {
+    ParticlePoolSoA *pool = sim->pool;
+    int count = pool->active_count;
+    int despawned;
+
+    /* Baked fields replace the per-field evaluation in the step kernel */
+    const FieldLattice *lattice = NULL;
+    if (apply_fields && sim->field_lattice && sim->num_force_fields > 0) {
+        if (sim->fields_dirty) {
+            field_lattice_bake(sim->field_lattice, sim->force_fields, sim->num_force_fields);
+            sim->fields_dirty = false;
+        }
+        lattice = sim->field_lattice;
+        apply_fields = false;
+    }
+    PhysicsStepParams params = sim_step_params(sim, dt, apply_fields);
+
+    /* Culled fields: local fields are split off against the grid as last
+     * binned and visit their cells after the step; only the rest go to
+     * the step kernel */
+    ForceField *culled = NULL;
+    int num_culled = 0;
+    if (params.num_fields > 0 && sim->cull_fields && sim->spatial_grid) {
+        size_t bytes = (size_t)params.num_fields * sizeof(ForceField);
+        culled = arena_alloc(sim->frame_arena, bytes);
+        ForceField *rest = arena_alloc(sim->frame_arena, bytes);
+        if (culled && rest) {
+            params.num_fields = physics_partition_force_fields(sim->spatial_grid, sim->force_fields,
+                                                               sim->num_force_fields, culled,
+                                                               &num_culled, rest);
+            params.fields = params.num_fields > 0 ? rest : NULL;
+        }
+    }
+
+    uint8_t *despawn = arena_alloc(sim->frame_arena, (size_t)count);
+    if (!despawn) {
+        return false;
+    }
+
+    if (sim->workers && count >= SIM_PARALLEL_MIN_PARTICLES) {
+        SimStepJob job = { pool, despawn, func, &params, lattice, 0 };
+        thread_pool_parallel_for(sim->workers, count, sim_parallel_grain(sim, count),
+                                 sim_step_chunk, &job);
+        despawned = job.despawned;
+    } else {
+        ParticleSoA view = pool_soa_get_view(pool);
+        if (lattice) {
+            dispatch_get()->lattice_sample(lattice, &view, dt);
+        }
+        despawned = func(&view, &params, despawn);
+    }
+
+    /* Fluid settles on the floor rather than draining away, unless asked to */
+    if (despawned > 0 && (!sim->sph || sim->sph->settings.despawn_resting)) {
+        sim_compact_despawned(sim, despawn, count);
+    }
+
+    /* Local fields act on the moved particles; the grid is brought up to
+     * date here, so the collision pass finds little left to rebin */
+    if (num_culled > 0) {
+        ParticleSoA view = pool_soa_get_view(pool);
+        ThreadPool *workers = view.count >= SIM_PARALLEL_MIN_COLLIDERS ? sim->workers : NULL;
+        if (spatial_grid_update_parallel(sim->spatial_grid, &view, workers,
+                                         sim->frame_arena).code == SUCCESS) {
+            physics_apply_force_fields_culled_parallel(sim->spatial_grid, &view, culled, num_culled,
+                                                       dt, NULL, workers);
+        } else {
+            dispatch_get()->fields(&view, culled, num_culled, dt);
+        }
+    }
+    return true;
+}
+
+/* Recreate the grid when its cells no longer suit the radius or density.
+ * Occupancy is read from the grid as last binned; the new grid is filled
+ * by the next update. */
+static void sim_tune_grid(Simulation *sim) {
+    if (!sim->auto_tune_grid || --sim->grid_tune_countdown > 0) {
+        return;
+    }
+    sim->grid_tune_countdown = SIM_GRID_TUNE_INTERVAL;
+
+    float radius = sim->collision_settings.collision_radius;
+    float size = spatial_grid_tune_cell_size(sim->spatial_grid, radius, sim->grid_target_occupancy);
+    if (!spatial_grid_needs_retune(sim->spatial_grid, size, radius)) {
+        return;
+    }
+
+    SpatialGrid *grid = spatial_grid_create_with_capacity(sim->width, sim->height, size, sim->capacity);
+    if (!grid) {
+        return;  /* Keep the old grid */
+    }
+    spatial_grid_destroy(sim->spatial_grid);
+    sim->spatial_grid = grid;
+}
+
+/* Kick velocities with Barnes-Hut gravity when N-body mode is on */
+static void sim_apply_nbody(Simulation *sim, float dt) {
+    if (!sim->nbody_tree) {
+        return;
+    }
+    ParticleSoA view = pool_soa_get_view(sim->pool);
+    nbody_apply_gravity(sim->nbody_tree, &view, &sim->nbody_settings, dt, sim->workers);
+}
+
+/* Kick velocities with SPH pressure and viscosity when the fluid mode is on */
+static void sim_apply_sph(Simulation *sim, float dt) {
+    if (!sim->sph) {
+        return;
+    }
+    ParticleSoA view = pool_soa_get_view(sim->pool);
+    sph_step(sim->sph, &view, dt, sim->workers, sim->frame_arena);
+}
+
+/* Update the spatial grid (or hash) and resolve particle-particle collisions */
+static void sim_resolve_collisions(Simulation *sim) {
+    bool has_cells = sim->spatial_hash || (sim->use_spatial_grid && sim->spatial_grid);
+    if (!(has_cells && sim->collision_settings.enabled) || sim->sph) {
+        return;
+    }
+
+    ParticleSoA view = pool_soa_get_view(sim->pool);
+
+    /* Hash mode: only occupied cells are binned and visited */
+    if (sim->spatial_hash) {
+        if (spatial_hash_rebuild(sim->spatial_hash, &view).code == SUCCESS) {
+            physics_resolve_collisions_hash(sim->spatial_hash, &view, &sim->collision_settings);
+        }
+        return;
+    }
+
+    sim_tune_grid(sim);
+
+    /* Verlet mode: the grid is only rebuilt when the lists go stale */
+    if (sim->neighbor_list) {
+        neighbor_list_update(sim->neighbor_list, sim->spatial_grid, &view,
+                             sim->collision_settings.collision_radius);
+        physics_resolve_collisions_verlet(sim->neighbor_list, &view, &sim->collision_settings);
+        return;
+    }
+
+    /* Only particles that crossed a cell border since last frame move;
+     * full rebuilds are split across the workers */
+    ThreadPool *workers = view.count >= SIM_PARALLEL_MIN_COLLIDERS ? sim->workers : NULL;
+    if (spatial_grid_update_parallel(sim->spatial_grid, &view, workers,
+                                     sim->frame_arena).code != SUCCESS) {
+        return;
+    }
+
+    dispatch_get()->collide(sim->spatial_grid, &view, &sim->collision_settings,
+                            sim->frame_arena, workers);
+}
+
+/* Initial frame arena size: despawn marks for a full pool, plus headroom.
+ * Grows to the high-water mark. */
+static size_t sim_arena_capacity(int capacity) {
+    return (size_t)capacity * sizeof(uint8_t) + ARENA_DEFAULT_CAPACITY;
 }
 
 /* Create a new simulation with specified capacity and dimensions */
@@ -63,7 +286,7 @@ Simulation *sim_create(int capacity, int width, int height) {
     }
     
     /* Create particle pool */
-    sim->pool = pool_create(capacity);
+    sim->pool = pool_soa_create(capacity);
     if (!sim->pool) {
         free(sim);
         return NULL;
@@ -73,8 +296,6 @@ Simulation *sim_create(int capacity, int width, int height) {
     sim->count = 0;
     sim->width = width;
     sim->height = height;
-    sim->simd_buffer = NULL;
-    sim->simd_buffer_capacity = 0;
     
     /* Initialize physics parameters */
     sim->gravity = 30.0f;  /* pixels per second squared */
@@ -88,13 +309,36 @@ Simulation *sim_create(int capacity, int width, int height) {
     }
 
     /* Initialize enhanced physics (Week 2) */
-    sim->spatial_grid = spatial_grid_create(width, height, 10.0f);  /* 10-pixel cells */
+    sim->spatial_grid = spatial_grid_create_with_capacity(width, height, 10.0f, capacity);  /* 10-pixel cells */
     sim->collision_settings = physics_default_collision_settings();
     sim->collision_settings.enabled = false;  /* Disabled by default */
     sim->force_fields = NULL;
     sim->num_force_fields = 0;
     sim->force_fields_capacity = 0;
     sim->use_spatial_grid = false;  /* Disabled by default for backward compatibility */
+    sim->neighbor_list = NULL;
+    sim->spatial_hash = NULL;   /* Collisions use the bounded grid unless hashed */
+    sim->auto_tune_grid = false;
+    sim->grid_target_occupancy = GRID_TARGET_OCCUPANCY;
+    sim->grid_tune_countdown = 0;
+    sim->reorder_interval = 0;  /* Indices stay put unless asked */
+    sim->reorder_countdown = 0;
+    sim->field_lattice = NULL;  /* Fields evaluated per particle unless baked */
+    sim->fields_dirty = true;
+    sim->cull_fields = false;   /* Local fields sweep every particle unless culled */
+    sim->nbody_tree = NULL;     /* No particle-particle gravity unless enabled */
+    sim->nbody_settings = nbody_default_settings();
+    sim->sph = NULL;            /* Plain particles unless the fluid mode is on */
+
+    /* Single-threaded until sim_set_thread_count() is called */
+    sim->workers = NULL;
+
+    /* Per-frame scratch memory */
+    sim->frame_arena = arena_create(sim_arena_capacity(capacity));
+    if (!sim->frame_arena) {
+        sim_destroy(sim);
+        return NULL;
+    }
 
     return sim;
 }
@@ -102,16 +346,22 @@ Simulation *sim_create(int capacity, int width, int height) {
 /* Destroy simulation and free all memory */
 void sim_destroy(Simulation *sim) {
     if (sim) {
-        if (sim->simd_buffer) {
-            simd_aligned_free(sim->simd_buffer);
+        if (sim->workers) {
+            thread_pool_destroy(sim->workers);
         }
+        arena_destroy(sim->frame_arena);
         if (sim->spatial_grid) {
             spatial_grid_destroy(sim->spatial_grid);
         }
+        neighbor_list_destroy(sim->neighbor_list);
+        spatial_hash_destroy(sim->spatial_hash);
+        field_lattice_destroy(sim->field_lattice);
+        nbody_tree_destroy(sim->nbody_tree);
+        sph_destroy(sim->sph);
         if (sim->force_fields) {
             free(sim->force_fields);
         }
-        pool_destroy(sim->pool);
+        pool_soa_destroy(sim->pool);
         free(sim);
     }
 }
@@ -120,19 +370,15 @@ void sim_destroy(Simulation *sim) {
 void sim_clear(Simulation *sim) {
     if (sim && sim->pool) {
         /* Free all active particles back to pool */
-        PoolIterator iter = pool_iterator_create(sim->pool);
-        Particle *particle;
-        while ((particle = pool_iterator_next(&iter)) != NULL) {
-            pool_free_particle(sim->pool, particle);
-        }
+        pool_soa_clear(sim->pool);
         sim->count = 0;
-        pool_iterator_destroy(&iter);
+        neighbor_list_invalidate(sim->neighbor_list);
     }
 }
 
 /* Get current particle count */
 int sim_get_particle_count(const Simulation *sim) {
-    return sim && sim->pool ? pool_get_active_count(sim->pool) : 0;
+    return sim && sim->pool ? pool_soa_get_active_count(sim->pool) : 0;
 }
 
 /* Set gravity value */
@@ -206,28 +452,29 @@ void sim_spawn_burst(Simulation *sim, float x, float y, int count, float spread)
     }
     
     int spawn_count = count;
-    int available = pool_get_free_count(sim->pool);
+    int available = pool_soa_get_free_count(sim->pool);
     if (spawn_count > available) {
         spawn_count = available;
     }
     
+    ParticlePoolSoA *pool = sim->pool;
     for (int i = 0; i < spawn_count; i++) {
-        Particle *p = pool_allocate_particle(sim->pool);
-        if (!p) {
+        int idx = pool_soa_allocate(pool);
+        if (idx < 0) {
             break; /* Pool is full */
         }
         
         /* Set position */
-        p->x = x;
-        p->y = y;
+        pool->x[idx] = x;
+        pool->y[idx] = y;
         
         /* Random direction within spread angle */
         float angle = rand_range(&sim->rng_state, -spread, spread);
         float speed = rand_range(&sim->rng_state, 5.0f, 20.0f);
         
         /* Set velocity */
-        p->vx = speed * cosf(angle);
-        p->vy = speed * sinf(angle);
+        pool->vx[idx] = speed * cosf(angle);
+        pool->vy[idx] = speed * sinf(angle);
         
         sim->count++;
     }
@@ -237,200 +484,85 @@ void sim_spawn_burst(Simulation *sim, float x, float y, int count, float spread)
 void sim_step(Simulation *sim, float dt) {
     if (!sim || !sim->pool) return;
 
-    const float damping = 0.6f;  /* Velocity damping on wall collisions */
-    const float friction = 0.98f; /* Ground friction */
+    /* Fused step kernel resolved once at load time */
+    physics_step_func_t step_func = dispatch_get()->fused_step;
 
-    /* Get the best available SIMD function */
-    simd_step_func_t simd_func = simd_select_step_function();
+    sim_begin_frame(sim);
 
-    int active_count = pool_get_active_count(sim->pool);
-    if (active_count == 0) {
+    if (pool_soa_get_active_count(sim->pool) == 0) {
         return;
     }
 
-    Particle *simd_buffer = sim_acquire_simd_buffer(sim, active_count);
-    if (!simd_buffer) {
-        /* Fallback to scalar processing if allocation fails */
-        sim_step_scalar(sim, dt);
-        return;
-    }
-
-    /* Copy particles to aligned buffer */
-    PoolIterator iter = pool_iterator_create(sim->pool);
-    Particle *p;
-    int i = 0;
-    while ((p = pool_iterator_next(&iter)) != NULL) {
-        simd_buffer[i++] = *p;
-    }
-
-    /* Apply SIMD physics calculations */
-    simd_func(simd_buffer, active_count, dt, sim->gravity, sim->windx, sim->windy);
-
-    /* Apply force fields if any */
-    if (sim->num_force_fields > 0 && sim->force_fields) {
-        /* Create particle pointer array for force field application */
-        Particle **particle_ptrs = (Particle**)malloc(sizeof(Particle*) * active_count);
-        if (particle_ptrs) {
-            for (int idx = 0; idx < active_count; idx++) {
-                particle_ptrs[idx] = &simd_buffer[idx];
-            }
-            physics_apply_force_fields(particle_ptrs, active_count,
-                                      sim->force_fields, sim->num_force_fields, dt);
-            free(particle_ptrs);
-        }
-    }
+    /* Particle-particle gravity and fluid forces kick velocities before
+     * the fused step */
+    sim_apply_nbody(sim, dt);
+    sim_apply_sph(sim, dt);
 
-    /* Copy back and handle collisions/cleanup */
-    pool_iterator_reset(&iter);
-    i = 0;
-    while ((p = pool_iterator_next(&iter)) != NULL) {
-        Particle *updated = &simd_buffer[i++];
-
-        /* Copy updated physics data */
-        p->x = updated->x;
-        p->y = updated->y;
-        p->vx = updated->vx;
-        p->vy = updated->vy;
-
-        /* Wall collision detection and response */
-        if (p->x < 0) {
-            p->x = 0;
-            p->vx = -p->vx * damping;
-        } else if (p->x >= sim->width - 1) {
-            p->x = sim->width - 1;
-            p->vx = -p->vx * damping;
-        }
-
-        if (p->y < 0) {
-            p->y = 0;
-            p->vy = -p->vy * damping;
-        } else if (p->y >= sim->height - 1) {
-            p->y = sim->height - 1;
-            p->vy = -p->vy * damping;
-
-            /* Apply ground friction when near bottom */
-            if (fabsf(p->vy) < 2.0f) {
-                p->vx *= friction;
-            }
-        }
-
-        /* Remove particles that are too slow and near bottom */
-        if (p->y >= sim->height - 2 && fabsf(p->vx) < 0.5f && fabsf(p->vy) < 0.5f) {
-            pool_free_particle(sim->pool, p);
-            sim->count--;
-        }
+    /* Integrate, apply force fields and handle walls (parallel if enabled) */
+    if (!sim_integrate(sim, step_func, dt, true)) {
+        return;
     }
 
-    pool_iterator_destroy(&iter);
+    /* Keep storage order close to spatial order */
+    sim_maybe_reorder(sim);
 
     /* Handle particle-particle collisions if enabled */
-    if (sim->use_spatial_grid && sim->collision_settings.enabled && sim->spatial_grid) {
-        /* Build spatial grid */
-        spatial_grid_clear(sim->spatial_grid);
-
-        /* Create particle pointer array for spatial grid */
-        Particle **particle_ptrs = (Particle**)malloc(sizeof(Particle*) * active_count);
-        if (particle_ptrs) {
-            iter = pool_iterator_create(sim->pool);
-            i = 0;
-            while ((p = pool_iterator_next(&iter)) != NULL) {
-                particle_ptrs[i] = p;
-                spatial_grid_insert(sim->spatial_grid, p);
-                i++;
-            }
-            pool_iterator_destroy(&iter);
-
-            /* Resolve collisions using spatial grid */
-            physics_resolve_collisions(sim->spatial_grid, particle_ptrs,
-                                      active_count, &sim->collision_settings);
-
-            free(particle_ptrs);
-        }
-    }
+    sim_resolve_collisions(sim);
 
     /* Synchronize cached count with pool */
-    sim->count = pool_get_active_count(sim->pool);
+    sim->count = pool_soa_get_active_count(sim->pool);
 }
 
 /* Scalar fallback implementation */
 void sim_step_scalar(Simulation *sim, float dt) {
     if (!sim || !sim->pool) return;
-    
-    const float damping = 0.6f;  /* Velocity damping on wall collisions */
-    const float friction = 0.98f; /* Ground friction */
-    
-    /* Use iterator to process only active particles */
-    PoolIterator iter = pool_iterator_create(sim->pool);
-    Particle *p;
-    
-    while ((p = pool_iterator_next(&iter)) != NULL) {
-        /* Apply forces */
-        p->vx += sim->windx * dt;
-        p->vy += (sim->gravity + sim->windy) * dt;
-        
-        /* Update position */
-        p->x += p->vx * dt;
-        p->y += p->vy * dt;
-        
-        /* Wall collision detection and response */
-        if (p->x < 0) {
-            p->x = 0;
-            p->vx = -p->vx * damping;
-        } else if (p->x >= sim->width - 1) {
-            p->x = sim->width - 1;
-            p->vx = -p->vx * damping;
-        }
-        
-        if (p->y < 0) {
-            p->y = 0;
-            p->vy = -p->vy * damping;
-        } else if (p->y >= sim->height - 1) {
-            p->y = sim->height - 1;
-            p->vy = -p->vy * damping;
-            
-            /* Apply ground friction when near bottom */
-            if (fabsf(p->vy) < 2.0f) {
-                p->vx *= friction;
-            }
-        }
-        
-        /* Remove particles that are too slow and near bottom */
-        if (p->y >= sim->height - 2 && fabsf(p->vx) < 0.5f && fabsf(p->vy) < 0.5f) {
-            pool_free_particle(sim->pool, p);
-            sim->count--;
-        }
+
+    sim_begin_frame(sim);
+
+    ParticleSoA view = pool_soa_get_view(sim->pool);
+    PhysicsStepParams params = sim_step_params(sim, dt, false);
+    uint8_t *despawn = arena_alloc(sim->frame_arena, (size_t)view.count);
+    if (!despawn) return;
+
+    if (physics_step_fused_scalar(&view, &params, despawn) > 0) {
+        sim_compact_despawned(sim, despawn, view.count);
     }
-    
-    /* Clean up iterator */
-    pool_iterator_destroy(&iter);
 
     /* Synchronize cached count with pool */
-    sim->count = pool_get_active_count(sim->pool);
+    sim->count = pool_soa_get_active_count(sim->pool);
 }
 
 /* Get particle at index (for rendering) */
-const Particle *sim_get_particle(const Simulation *sim, int index) {
-    if (!sim || !sim->pool || index < 0) {
-        return NULL;
+bool sim_get_particle(const Simulation *sim, int index, Particle *out) {
+    if (!sim || !sim->pool || !out || index < 0 || index >= sim->pool->active_count) {
+        return false;
     }
     
-    /* Use iterator to find particle at specific index */
-    PoolIterator iter = pool_iterator_create(sim->pool);
-    Particle *p;
-    int current_index = 0;
-    
-    while ((p = pool_iterator_next(&iter)) != NULL) {
-        if (current_index == index) {
-            pool_iterator_destroy(&iter);
-            return p;
-        }
-        current_index++;
+    out->x = sim->pool->x[index];
+    out->y = sim->pool->y[index];
+    out->vx = sim->pool->vx[index];
+    out->vy = sim->pool->vy[index];
+    return true;
+}
+
+/* Get a read-only view of all active particles */
+ParticleSoA sim_get_particle_view(const Simulation *sim) {
+    if (!sim || !sim->pool) {
+        return (ParticleSoA){NULL, NULL, NULL, NULL, 0};
     }
-    
-    /* Clean up iterator */
-    pool_iterator_destroy(&iter);
-    
-    return NULL; /* Index out of bounds */
+    return pool_soa_get_view(sim->pool);
+}
+
+/* Call visitor once per active particle; returns the number visited */
+int sim_foreach_particle(const Simulation *sim, sim_particle_visitor_t visitor, void *user_data) {
+    if (!visitor) return 0;
+
+    ParticleSoA view = sim_get_particle_view(sim);
+    for (int i = 0; i < view.count; i++) {
+        Particle p = { view.x[i], view.y[i], view.vx[i], view.vy[i] };
+        visitor(&p, i, user_data);
+    }
+    return view.count;
 }
 
 /* Add a single particle at specified position and velocity */
@@ -439,27 +571,27 @@ void sim_add_particle(Simulation *sim, float x, float y, float vx, float vy) {
         return;
     }
     
-    Particle *p = pool_allocate_particle(sim->pool);
-    if (!p) {
+    int idx = pool_soa_allocate(sim->pool);
+    if (idx < 0) {
         return; /* Pool is full */
     }
     
-    p->x = x;
-    p->y = y;
-    p->vx = vx;
-    p->vy = vy;
+    sim->pool->x[idx] = x;
+    sim->pool->y[idx] = y;
+    sim->pool->vx[idx] = vx;
+    sim->pool->vy[idx] = vy;
     sim->count++;
 }
 
 /* Get the particle pool */
-ParticlePool *sim_get_pool(const Simulation *sim) {
+ParticlePoolSoA *sim_get_pool(const Simulation *sim) {
     return sim ? sim->pool : NULL;
 }
 
 /* Print pool statistics */
 void sim_print_pool_stats(const Simulation *sim) {
     if (sim && sim->pool) {
-        pool_print_status(sim->pool);
+        pool_soa_print_status(sim->pool);
     }
 }
 
@@ -478,7 +610,7 @@ Error sim_create_with_error(int capacity, int width, int height, Simulation **si
     }
     
     /* Create particle pool with error handling */
-    Error err = pool_create_with_error(capacity, &sim->pool);
+    Error err = pool_soa_create_with_error(capacity, &sim->pool);
     if (err.code != SUCCESS) {
         error_free(sim);
         return err;
@@ -488,8 +620,6 @@ Error sim_create_with_error(int capacity, int width, int height, Simulation **si
     sim->count = 0;
     sim->width = width;
     sim->height = height;
-    sim->simd_buffer = NULL;
-    sim->simd_buffer_capacity = 0;
 
     /* Initialize physics parameters */
     sim->gravity = 30.0f;  /* pixels per second squared */
@@ -503,13 +633,37 @@ Error sim_create_with_error(int capacity, int width, int height, Simulation **si
     }
 
     /* Initialize enhanced physics (Week 2) */
-    sim->spatial_grid = spatial_grid_create(width, height, 10.0f);  /* 10-pixel cells */
+    sim->spatial_grid = spatial_grid_create_with_capacity(width, height, 10.0f, capacity);  /* 10-pixel cells */
     sim->collision_settings = physics_default_collision_settings();
     sim->collision_settings.enabled = false;  /* Disabled by default */
     sim->force_fields = NULL;
     sim->num_force_fields = 0;
     sim->force_fields_capacity = 0;
     sim->use_spatial_grid = false;  /* Disabled by default for backward compatibility */
+    sim->neighbor_list = NULL;
+    sim->spatial_hash = NULL;   /* Collisions use the bounded grid unless hashed */
+    sim->auto_tune_grid = false;
+    sim->grid_target_occupancy = GRID_TARGET_OCCUPANCY;
+    sim->grid_tune_countdown = 0;
+    sim->reorder_interval = 0;  /* Indices stay put unless asked */
+    sim->reorder_countdown = 0;
+    sim->field_lattice = NULL;  /* Fields evaluated per particle unless baked */
+    sim->fields_dirty = true;
+    sim->cull_fields = false;   /* Local fields sweep every particle unless culled */
+    sim->nbody_tree = NULL;     /* No particle-particle gravity unless enabled */
+    sim->nbody_settings = nbody_default_settings();
+    sim->sph = NULL;            /* Plain particles unless the fluid mode is on */
+
+    /* Single-threaded until sim_set_thread_count() is called */
+    sim->workers = NULL;
+
+    /* Per-frame scratch memory */
+    err = arena_create_with_error(sim_arena_capacity(capacity), &sim->frame_arena);
+    if (err.code != SUCCESS) {
+        sim->frame_arena = NULL;
+        sim_destroy(sim);
+        return err;
+    }
 
     *sim_out = sim;
     return (Error){SUCCESS};
@@ -522,16 +676,16 @@ Error sim_add_particle_with_error(Simulation *sim, float x, float y, float vx, f
     ERROR_CHECK(x >= 0.0f && x < sim->width, ERROR_OUT_OF_RANGE, "X position out of bounds");
     ERROR_CHECK(y >= 0.0f && y < sim->height, ERROR_OUT_OF_RANGE, "Y position out of bounds");
     
-    Particle *particle = NULL;
-    Error err = pool_allocate_particle_with_error(sim->pool, &particle);
+    int idx = -1;
+    Error err = pool_soa_allocate_with_error(sim->pool, &idx);
     if (err.code != SUCCESS) {
         return err;
     }
     
-    particle->x = x;
-    particle->y = y;
-    particle->vx = vx;
-    particle->vy = vy;
+    sim->pool->x[idx] = x;
+    sim->pool->y[idx] = y;
+    sim->pool->vx[idx] = vx;
+    sim->pool->vy[idx] = vy;
     sim->count++;
     
     return (Error){SUCCESS};
@@ -547,30 +701,31 @@ Error sim_spawn_burst_with_error(Simulation *sim, float x, float y, int count, f
     ERROR_CHECK(spread >= 0.0f && spread <= 2.0f * M_PI, ERROR_OUT_OF_RANGE, "Spread angle out of range");
     
     int spawn_count = count;
-    int available = pool_get_free_count(sim->pool);
+    int available = pool_soa_get_free_count(sim->pool);
     if (spawn_count > available) {
         spawn_count = available;
     }
     
+    ParticlePoolSoA *pool = sim->pool;
     int spawned = 0;
     for (int i = 0; i < spawn_count; i++) {
-        Particle *particle = NULL;
-        Error err = pool_allocate_particle_with_error(sim->pool, &particle);
+        int idx = -1;
+        Error err = pool_soa_allocate_with_error(pool, &idx);
         if (err.code != SUCCESS) {
             break; /* Pool is full */
         }
         
         /* Set position */
-        particle->x = x;
-        particle->y = y;
+        pool->x[idx] = x;
+        pool->y[idx] = y;
         
         /* Random direction within spread angle */
         float angle = rand_range(&sim->rng_state, -spread, spread);
         float speed = rand_range(&sim->rng_state, 5.0f, 20.0f);
         
         /* Set velocity */
-        particle->vx = speed * cosf(angle);
-        particle->vy = speed * sinf(angle);
+        pool->vx[idx] = speed * cosf(angle);
+        pool->vy[idx] = speed * sinf(angle);
         
         sim->count++;
         spawned++;
@@ -589,74 +744,19 @@ Error sim_step_with_error(Simulation *sim, float dt) {
     ERROR_CHECK(sim->pool != NULL, ERROR_NULL_POINTER, "Particle pool cannot be NULL");
     ERROR_CHECK(dt > 0.0f, ERROR_INVALID_PARAMETER, "Time step must be positive");
 
-    const float damping = 0.6f;  /* Velocity damping on wall collisions */
-    const float friction = 0.98f; /* Ground friction */
+    /* Fused step kernel resolved once at load time */
+    physics_step_func_t step_func = dispatch_get()->fused_step;
 
-    /* Get the best available SIMD function with error handling */
-    simd_step_func_t simd_func;
-    Error err = simd_select_step_function_with_error(&simd_func);
-    if (err.code != SUCCESS) {
-        return err;
-    }
-
-    int active_count = pool_get_active_count(sim->pool);
-    if (active_count == 0) {
-        return (Error){SUCCESS};
-    }
+    sim_begin_frame(sim);
 
-    Particle *simd_buffer = sim_acquire_simd_buffer(sim, active_count);
-    if (!simd_buffer) {
-        /* Fallback gracefully to scalar path if allocation fails */
-        sim_step_scalar(sim, dt);
+    if (pool_soa_get_active_count(sim->pool) == 0) {
         return (Error){SUCCESS};
     }
 
-    PoolIterator iter = pool_iterator_create(sim->pool);
-    Particle *p;
-    int idx = 0;
-    while ((p = pool_iterator_next(&iter)) != NULL) {
-        simd_buffer[idx++] = *p;
-    }
-
-    simd_func(simd_buffer, active_count, dt, sim->gravity, sim->windx, sim->windy);
-
-    pool_iterator_reset(&iter);
-    idx = 0;
-    while ((p = pool_iterator_next(&iter)) != NULL) {
-        Particle *updated = &simd_buffer[idx++];
-        p->x = updated->x;
-        p->y = updated->y;
-        p->vx = updated->vx;
-        p->vy = updated->vy;
-
-        if (p->x < 0) {
-            p->x = 0;
-            p->vx = -p->vx * damping;
-        } else if (p->x >= sim->width - 1) {
-            p->x = sim->width - 1;
-            p->vx = -p->vx * damping;
-        }
-
-        if (p->y < 0) {
-            p->y = 0;
-            p->vy = -p->vy * damping;
-        } else if (p->y >= sim->height - 1) {
-            p->y = sim->height - 1;
-            p->vy = -p->vy * damping;
-
-            if (fabsf(p->vy) < 2.0f) {
-                p->vx *= friction;
-            }
-        }
-
-        if (p->y >= sim->height - 2 && fabsf(p->vx) < 0.5f && fabsf(p->vy) < 0.5f) {
-            pool_free_particle_with_error(sim->pool, p);
-            sim->count--;
-        }
+    if (!sim_integrate(sim, step_func, dt, false)) {
+        return ERROR_CREATE(ERROR_MEMORY_ALLOCATION, "Frame arena exhausted");
     }
-
-    pool_iterator_destroy(&iter);
-    sim->count = pool_get_active_count(sim->pool);
+    sim->count = pool_soa_get_active_count(sim->pool);
 
     return (Error){SUCCESS};
 }
@@ -703,6 +803,7 @@ int sim_add_force_field(Simulation *sim, ForceField field) {
 
     /* Add field */
     sim->force_fields[sim->num_force_fields] = field;
+    sim->fields_dirty = true;
     return sim->num_force_fields++;
 }
 
@@ -716,18 +817,21 @@ void sim_remove_force_field(Simulation *sim, int index) {
     }
 
     sim->num_force_fields--;
+    sim->fields_dirty = true;
 }
 
 /* Clear all force fields */
 void sim_clear_force_fields(Simulation *sim) {
     if (sim) {
         sim->num_force_fields = 0;
+        sim->fields_dirty = true;
     }
 }
 
-/* Get force field by index */
+/* Get force field by index (the caller may change it, so re-bake) */
 ForceField* sim_get_force_field(Simulation *sim, int index) {
     if (!sim || index < 0 || index >= sim->num_force_fields) return NULL;
+    sim->fields_dirty = true;
     return &sim->force_fields[index];
 }
 
@@ -736,6 +840,80 @@ int sim_get_force_field_count(const Simulation *sim) {
     return sim ? sim->num_force_fields : 0;
 }
 
+/* Enable/disable baked force fields */
+bool sim_enable_baked_fields(Simulation *sim, bool enable, float spacing) {
+    if (!sim) return false;
+
+    field_lattice_destroy(sim->field_lattice);
+    sim->field_lattice = NULL;
+    sim->fields_dirty = true;
+
+    if (enable) {
+        sim->field_lattice = field_lattice_create(sim->width, sim->height, spacing);
+    }
+    return !enable || sim->field_lattice != NULL;
+}
+
+/* Get the baked field lattice (NULL when fields are not baked) */
+const FieldLattice *sim_get_field_lattice(const Simulation *sim) {
+    return sim ? sim->field_lattice : NULL;
+}
+
+/* Enable/disable grid-culled force fields */
+void sim_enable_field_culling(Simulation *sim, bool enable) {
+    if (sim) {
+        sim->cull_fields = enable;
+    }
+}
+
+/* Enable/disable N-body gravity */
+bool sim_enable_nbody(Simulation *sim, bool enable, const NBodySettings *settings) {
+    if (!sim) return false;
+
+    if (!enable) {
+        nbody_tree_destroy(sim->nbody_tree);
+        sim->nbody_tree = NULL;
+        return true;
+    }
+
+    NBodySettings chosen = settings ? *settings : nbody_default_settings();
+    if (!(chosen.theta >= 0.0f) || !(chosen.softening >= 0.0f)) {
+        return false;
+    }
+    if (!sim->nbody_tree) {
+        sim->nbody_tree = nbody_tree_create(sim->capacity);
+        if (!sim->nbody_tree) {
+            return false;
+        }
+    }
+    sim->nbody_settings = chosen;
+    return true;
+}
+
+/* Get the N-body tree (NULL when N-body gravity is off) */
+const NBodyTree *sim_get_nbody_tree(const Simulation *sim) {
+    return sim ? sim->nbody_tree : NULL;
+}
+
+/* Enable/disable SPH fluid mode */
+bool sim_enable_sph(Simulation *sim, bool enable, const SPHSettings *settings) {
+    if (!sim) return false;
+
+    sph_destroy(sim->sph);
+    sim->sph = NULL;
+    if (!enable) {
+        return true;
+    }
+
+    sim->sph = sph_create(sim->width, sim->height, settings, sim->capacity);
+    return sim->sph != NULL;
+}
+
+/* Get the SPH solver (NULL when the fluid mode is off) */
+const SPHSolver *sim_get_sph(const Simulation *sim) {
+    return sim ? sim->sph : NULL;
+}
+
 /* Enable/disable spatial grid */
 void sim_enable_spatial_grid(Simulation *sim, bool enable) {
     if (sim) {
@@ -743,11 +921,142 @@ void sim_enable_spatial_grid(Simulation *sim, bool enable) {
     }
 }
 
-/* Get grid statistics */
+/* Get grid statistics (the hash's while hashed collisions are on) */
 GridStats sim_get_grid_stats(const Simulation *sim) {
     GridStats stats = {0};
-    if (sim && sim->spatial_grid) {
+    if (sim && sim->spatial_hash) {
+        spatial_hash_get_stats(sim->spatial_hash, &stats);
+    } else if (sim && sim->spatial_grid) {
         spatial_grid_get_stats(sim->spatial_grid, &stats);
     }
     return stats;
 }
+
+/* Enable/disable collisions on a sparse spatial hash */
+bool sim_enable_spatial_hash(Simulation *sim, bool enable, float cell_size) {
+    if (!sim) return false;
+
+    spatial_hash_destroy(sim->spatial_hash);
+    sim->spatial_hash = NULL;
+
+    if (enable) {
+        if (cell_size <= 0.0f) {
+            cell_size = sim_get_grid_cell_size(sim);
+        }
+        sim->spatial_hash = spatial_hash_create(cell_size, sim->capacity);
+    }
+    return !enable || sim->spatial_hash != NULL;
+}
+
+/* Enable/disable adaptive grid cell sizing */
+void sim_enable_grid_auto_tune(Simulation *sim, bool enable, float target_occupancy) {
+    if (sim) {
+        sim->auto_tune_grid = enable;
+        sim->grid_target_occupancy = target_occupancy > 0.0f ? target_occupancy : GRID_TARGET_OCCUPANCY;
+        sim->grid_tune_countdown = 0;  /* Check on the next collision pass */
+    }
+}
+
+/* Get the current grid cell size */
+float sim_get_grid_cell_size(const Simulation *sim) {
+    if (!sim || !sim->spatial_grid) {
+        return 0.0f;
+    }
+    return fmaxf(sim->spatial_grid->cell_width, sim->spatial_grid->cell_height);
+}
+
+/* Set how often sim_step reorders particle storage */
+void sim_set_reorder_interval(Simulation *sim, int steps) {
+    if (sim) {
+        sim->reorder_interval = steps > 0 ? steps : 0;
+        sim->reorder_countdown = sim->reorder_interval;
+    }
+}
+
+/* Sort particle storage along the Morton curve of the grid cells */
+Error sim_reorder_particles(Simulation *sim, int *remap_out) {
+    ERROR_CHECK_NULL(sim, "Simulation");
+    ERROR_CHECK_NULL(sim->spatial_grid, "Spatial grid");
+
+    ParticleSoA view = pool_soa_get_view(sim->pool);
+    if (view.count < 2) {
+        if (remap_out && view.count == 1) remap_out[0] = 0;
+        return (Error){SUCCESS};
+    }
+
+    int *order = arena_alloc(sim->frame_arena, sizeof(int) * (size_t)view.count);
+    float *scratch = arena_alloc(sim->frame_arena, sizeof(float) * (size_t)view.count);
+    if (!order || !scratch) {
+        return ERROR_CREATE(ERROR_MEMORY_ALLOCATION, "Failed to allocate reorder scratch");
+    }
+
+    Error err = spatial_grid_morton_order(sim->spatial_grid, &view, sim->frame_arena, order);
+    if (err.code != SUCCESS) {
+        return err;
+    }
+    pool_soa_reorder(sim->pool, order, scratch, remap_out);
+
+    /* Grid entries and neighbor lists are keyed by the old indices */
+    spatial_grid_clear(sim->spatial_grid);
+    neighbor_list_invalidate(sim->neighbor_list);
+    return (Error){SUCCESS};
+}
+
+/* Enable/disable Verlet neighbor lists for collisions */
+bool sim_enable_verlet_lists(Simulation *sim, bool enable, float skin) {
+    if (!sim) return false;
+
+    neighbor_list_destroy(sim->neighbor_list);
+    sim->neighbor_list = NULL;
+
+    if (enable) {
+        sim->neighbor_list = neighbor_list_create(sim->capacity,
+                                                  skin > 0.0f ? skin : NEIGHBOR_LIST_DEFAULT_SKIN);
+    }
+    return !enable || sim->neighbor_list != NULL;
+}
+
+/* Get Verlet list statistics */
+NeighborListStats sim_get_neighbor_list_stats(const Simulation *sim) {
+    if (!sim) {
+        return (NeighborListStats){0};
+    }
+    return neighbor_list_get_stats(sim->neighbor_list);
+}
+
+/* ===== PARALLEL STEPPING ===== */
+
+/* Set number of worker threads used by sim_step (<= 0 = one per CPU) */
+int sim_set_thread_count(Simulation *sim, int num_threads) {
+    if (!sim) return 0;
+
+    if (num_threads <= 0) {
+        num_threads = thread_pool_get_hardware_concurrency();
+    }
+    if (num_threads == sim_get_thread_count(sim)) {
+        return num_threads;
+    }
+
+    if (sim->workers) {
+        thread_pool_destroy(sim->workers);
+        sim->workers = NULL;
+    }
+    if (num_threads == 1) {
+        return 1;
+    }
+
+    sim->workers = thread_pool_create(num_threads);
+    return sim_get_thread_count(sim);
+}
+
+/* Get number of threads sim_step runs on */
+int sim_get_thread_count(const Simulation *sim) {
+    return sim ? thread_pool_get_thread_count(sim->workers) : 1;
+}
+
+/* ===== FRAME ARENA ===== */
+
+/* Get per-frame scratch memory statistics */
+ArenaStats sim_get_arena_stats(const Simulation *sim) {
+    return sim ? arena_get_stats(sim->frame_arena) : (ArenaStats){0};
+}
@@ -7,17 +7,29 @@
 #include "pool.h"
 #include "error.h"
 #include "spatial_grid.h"
+#include "spatial_hash.h"
 #include "physics.h"
+#include "thread_pool.h"
+#include "arena.h"
+#include "field_lattice.h"
+#include "nbody.h"
+#include "sph.h"
+
+/* Parallel stepping thresholds (particles) */
+#define SIM_PARALLEL_MIN_PARTICLES 8192  /* Below this, threading costs more than it saves */
+#define SIM_PARALLEL_MIN_GRAIN 2048      /* Smallest chunk handed to a worker */
+#define SIM_PARALLEL_MIN_COLLIDERS 2048  /* Collisions cost more per particle, so split sooner */
+
+/* Steps between cell-size checks when the grid auto-tunes */
+#define SIM_GRID_TUNE_INTERVAL 30
 
 /* Simulation structure */
 typedef struct {
-    ParticlePool *pool;       /* Object pool for particles */
+    ParticlePoolSoA *pool;    /* Structure-of-arrays particle storage */
     int count, capacity;
     float gravity, windx, windy;
     int width, height;
     uint32_t rng_state;
-    Particle *simd_buffer;    /* Cached SIMD working buffer */
-    int simd_buffer_capacity; /* Number of particles the buffer can hold */
 
     /* Enhanced physics (Week 2) */
     SpatialGrid *spatial_grid;    /* Spatial partitioning for collision detection */
@@ -26,6 +38,25 @@ typedef struct {
     int num_force_fields;
     int force_fields_capacity;
     bool use_spatial_grid;        /* Enable/disable spatial grid optimization */
+    NeighborList *neighbor_list;  /* Verlet lists (NULL = rebuild the grid every step) */
+    SpatialHash *spatial_hash;    /* Sparse collision cells (NULL = collide on spatial_grid) */
+    bool auto_tune_grid;          /* Resize cells from collision radius and occupancy */
+    float grid_target_occupancy;  /* Particles per occupied cell when auto-tuning */
+    int grid_tune_countdown;      /* Steps until the next cell-size check */
+    int reorder_interval;         /* Steps between Morton reorders (0 = never) */
+    int reorder_countdown;        /* Steps until the next reorder */
+    FieldLattice *field_lattice;  /* Baked field sum (NULL = evaluate every field per particle) */
+    bool fields_dirty;            /* Fields may have changed since the last bake */
+    bool cull_fields;             /* Apply local fields to the grid cells they overlap */
+    NBodyTree *nbody_tree;        /* Particle-particle gravity (NULL = off) */
+    NBodySettings nbody_settings; /* G, opening angle and softening */
+    SPHSolver *sph;               /* Fluid pipeline (NULL = particles and collisions) */
+
+    /* Parallel stepping */
+    ThreadPool *workers;          /* Persistent worker pool (NULL = single-threaded) */
+
+    /* Per-frame scratch memory, reset at the start of every step */
+    FrameArena *frame_arena;      /* Despawn marks and per-step scratch */
 } Simulation;
 
 /* Core simulation functions */
@@ -47,12 +78,20 @@ void sim_get_wind(const Simulation *sim, float *x, float *y);
 float sim_get_particle_speed(const Particle *p);
 uint32_t sim_speed_to_color(float speed);
 
-/* Particle access functions */
-const Particle *sim_get_particle(const Simulation *sim, int index);
+/* Particle access functions (indices are dense in [0, count)) */
+bool sim_get_particle(const Simulation *sim, int index, Particle *out);
 void sim_add_particle(Simulation *sim, float x, float y, float vx, float vy);
 
+/* Bulk read access for renderers.
+ * The view aliases the simulation's columns: it is valid until the next
+ * step, add, clear or destroy, and must not be written through. */
+typedef void (*sim_particle_visitor_t)(const Particle *particle, int index, void *user_data);
+
+ParticleSoA sim_get_particle_view(const Simulation *sim);
+int sim_foreach_particle(const Simulation *sim, sim_particle_visitor_t visitor, void *user_data);
+
 /* Pool integration functions */
-ParticlePool *sim_get_pool(const Simulation *sim);
+ParticlePoolSoA *sim_get_pool(const Simulation *sim);
 void sim_print_pool_stats(const Simulation *sim);
 
 /* Error-aware simulation functions */
@@ -72,7 +111,90 @@ void sim_clear_force_fields(Simulation *sim);
 ForceField* sim_get_force_field(Simulation *sim, int index);
 int sim_get_force_field_count(const Simulation *sim);
 
+/* Baked force fields: the summed acceleration of all fields is rasterized
+ * onto a lattice with nodes `spacing` apart (<= 0 =
+ * FIELD_LATTICE_DEFAULT_SPACING) and sampled bilinearly, so a step costs
+ * the same however many fields exist. The lattice is re-baked on the next
+ * step after a field is added, removed or cleared, or taken for writing
+ * with sim_get_force_field(). Particles sample it at the start of the
+ * step rather than after moving. Returns false if the lattice could not
+ * be allocated. */
+bool sim_enable_baked_fields(Simulation *sim, bool enable, float spacing);
+const FieldLattice *sim_get_field_lattice(const Simulation *sim);
+
+/* Grid-culled force fields: fields with a finite radius touch only the
+ * particles in the grid cells their bounding box overlaps. Which fields
+ * qualify is decided against the grid as last binned: unbounded fields,
+ * and local ones covering more than PHYSICS_FIELD_CULL_MAX_FRACTION of the
+ * particles, stay in the step kernel. Culled fields run after the step
+ * kernel on the moved positions, once the grid is brought up to date, so
+ * they act after walls and despawn and after every kernel field; their
+ * cells are split across the worker pool when one is set. Ignored while
+ * fields are baked. Off by default. */
+void sim_enable_field_culling(Simulation *sim, bool enable);
+
+/* N-body gravity: every step, before the step kernel, a Barnes-Hut tree
+ * over all particles (unit mass) is rebuilt and its accelerations kick
+ * the velocities, split across the worker pool when one is set. The tree
+ * keeps its memory between steps. settings NULL = nbody_default_settings().
+ * Returns false if the tree could not be allocated or settings are invalid. */
+bool sim_enable_nbody(Simulation *sim, bool enable, const NBodySettings *settings);
+const NBodyTree *sim_get_nbody_tree(const Simulation *sim);
+
+/* SPH fluid mode: every step, before the step kernel, densities and
+ * pressure and viscosity forces are computed over the solver's own grid
+ * (split across the worker pool when one is set). The fluid replaces the
+ * particle collision pass. Slow particles near the floor, which other
+ * modes despawn, stay in the pool so the fluid can settle, unless
+ * settings->despawn_resting is set. settings NULL =
+ * sph_default_settings(). Returns false if the solver could not be
+ * created or settings are invalid. */
+bool sim_enable_sph(Simulation *sim, bool enable, const SPHSettings *settings);
+const SPHSolver *sim_get_sph(const Simulation *sim);
+
 void sim_enable_spatial_grid(Simulation *sim, bool enable);
 GridStats sim_get_grid_stats(const Simulation *sim);
 
+/* Hashed collisions: the collision pass bins particles into a sparse
+ * spatial hash with square cells `cell_size` wide (<= 0 = the grid's
+ * current cell size; keep it at least twice the collision radius) instead
+ * of the bounded grid. Rebinning costs follow the particles rather than
+ * the world area, so very large, sparsely filled worlds stay cheap. It
+ * replaces the grid for collisions whether or not the grid is enabled,
+ * takes precedence over Verlet lists and auto-tuning, and
+ * sim_get_grid_stats() then reports the hash. Returns false if the hash
+ * could not be allocated. */
+bool sim_enable_spatial_hash(Simulation *sim, bool enable, float cell_size);
+
+/* Adaptive grid: every SIM_GRID_TUNE_INTERVAL steps the cell size is
+ * re-derived from the collision radius and the observed occupancy, and the
+ * grid is recreated when it has drifted (target_occupancy <= 0 =
+ * GRID_TARGET_OCCUPANCY). Off by default; the grid keeps 10-unit cells. */
+void sim_enable_grid_auto_tune(Simulation *sim, bool enable, float target_occupancy);
+float sim_get_grid_cell_size(const Simulation *sim);
+
+/* Spatial reordering: particle storage is sorted along the Morton curve of
+ * the grid cells so particles that interact sit close in memory. With an
+ * interval, sim_step reorders every `steps` steps (0 = never, the
+ * default); particle indices change when it runs. sim_reorder_particles()
+ * reorders now and reports each old index's new index in remap_out
+ * (optional, one entry per particle) for callers holding indices. */
+void sim_set_reorder_interval(Simulation *sim, int steps);
+Error sim_reorder_particles(Simulation *sim, int *remap_out);
+
+/* Verlet neighbor lists: collisions reuse per-particle neighbor lists
+ * until some particle moves skin / 2, instead of rebuilding the grid
+ * every step (skin <= 0 = NEIGHBOR_LIST_DEFAULT_SKIN). Returns false if
+ * the lists could not be allocated. */
+bool sim_enable_verlet_lists(Simulation *sim, bool enable, float skin);
+NeighborListStats sim_get_neighbor_list_stats(const Simulation *sim);
+
+/* Parallel stepping: integration, force fields and walls run in chunks on a
+ * work-stealing worker pool; grid collisions are split by cell colour */
+int sim_set_thread_count(Simulation *sim, int num_threads);
+int sim_get_thread_count(const Simulation *sim);
+
+/* Frame arena statistics (high-water mark, overflows) */
+ArenaStats sim_get_arena_stats(const Simulation *sim);
+
 #endif /* SIM_H */ 
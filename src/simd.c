@@ -11,9 +11,15 @@
 #include <arm_neon.h>
 #endif
 
-/* x86 CPUID intrinsics */
+/* x86 CPUID and vector intrinsics.
+ * Kernels are compiled per function with target attributes so the base
+ * build stays generic and the dispatcher picks them at runtime. */
 #if defined(__x86_64__) || defined(__i386__)
 #include <cpuid.h>
+#include <immintrin.h>
+#define SIMD_TARGET_SSE4 __attribute__((target("sse4.1")))
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define SIMD_TARGET_AVX512 __attribute__((target("avx512f,fma")))
 #endif
 
 /* Performance measurement helper */
@@ -28,6 +34,10 @@ static SIMDCapabilities g_simd_capabilities = {0};
 static int g_simd_initialized = 0;
 static SIMDStats g_simd_stats = {0};
 
+/* Kernels may run on several worker threads at once, so counters are
+ * bumped atomically */
+#define SIMD_STATS_ADD(field, n) __atomic_fetch_add(&g_simd_stats.field, (size_t)(n), __ATOMIC_RELAXED)
+
 /* CPUID function for x86 platforms */
 #if defined(__x86_64__) || defined(__i386__)
 static void get_cpuid(unsigned int leaf, unsigned int subleaf, unsigned int *eax, unsigned int *ebx, unsigned int *ecx, unsigned int *edx) {
@@ -43,6 +53,17 @@ static void get_cpuid(unsigned int leaf, unsigned int subleaf, unsigned int *eax
     #endif
 }
 
+/* XCR0 bits: SSE + AVX state, and additionally opmask + zmm state */
+#define XCR0_YMM_STATE 0x06u
+#define XCR0_ZMM_STATE 0xE6u
+
+/* Read XCR0 (only valid when CPUID reports OSXSAVE) */
+static uint64_t read_xcr0(void) {
+    uint32_t lo, hi;
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return ((uint64_t)hi << 32) | lo;
+}
+
 static uint32_t detect_x86_capabilities(void) {
     unsigned int eax, ebx, ecx, edx;
     uint32_t features = SIMD_NONE;
@@ -62,12 +83,24 @@ static uint32_t detect_x86_capabilities(void) {
     if (ecx & (1 << 28)) features |= SIMD_AVX;      /* AVX */
     if (ecx & (1 << 12)) features |= SIMD_FMA;      /* FMA */
     
+    /* Register state the OS saves on context switch (OSXSAVE + XCR0) */
+    uint64_t xcr0 = (ecx & (1 << 27)) ? read_xcr0() : 0;
+    
     /* Get extended CPU info for AVX2 and AVX-512 */
     get_cpuid(7, 0, &eax, &ebx, &ecx, &edx);
     
     if (ebx & (1 << 5))  features |= SIMD_AVX2;     /* AVX2 */
     if (ebx & (1 << 16)) features |= SIMD_AVX512F;  /* AVX-512 Foundation */
     
+    /* The CPU bits alone are not enough: without OS support for the
+     * wider registers their upper halves are lost on context switch */
+    if ((xcr0 & XCR0_YMM_STATE) != XCR0_YMM_STATE) {
+        features &= ~(SIMD_AVX | SIMD_AVX2 | SIMD_FMA | SIMD_AVX512F);
+    }
+    if ((xcr0 & XCR0_ZMM_STATE) != XCR0_ZMM_STATE) {
+        features &= ~SIMD_AVX512F;
+    }
+    
     return features;
 }
 #else
@@ -241,9 +274,11 @@ simd_step_func_t simd_select_step_function(void) {
     }
     
     /* Select best available implementation */
-    if (simd_is_supported(SIMD_AVX)) {
+    if (simd_is_supported(SIMD_AVX512F)) {
+        return simd_step_avx512;
+    } else if (simd_is_supported(SIMD_AVX2) && simd_is_supported(SIMD_FMA)) {
         return simd_step_avx;
-    } else if (simd_is_supported(SIMD_SSE)) {
+    } else if (simd_is_supported(SIMD_SSE4_1)) {
         return simd_step_sse;
     } else if (simd_is_supported(SIMD_NEON)) {
         return simd_step_neon_optimized; /* Use optimized NEON implementation */
@@ -253,14 +288,45 @@ simd_step_func_t simd_select_step_function(void) {
 }
 
 const char *simd_get_function_name(simd_step_func_t func) {
-    if (func == simd_step_avx) return "AVX";
-    if (func == simd_step_sse) return "SSE";
+    if (func == simd_step_avx512) return "AVX-512";
+    if (func == simd_step_avx) return "AVX2+FMA";
+    if (func == simd_step_sse) return "SSE4.1";
     if (func == simd_step_neon) return "NEON";
     if (func == simd_step_neon_optimized) return "NEON (Optimized)";
     if (func == simd_step_scalar) return "Scalar";
     return "Unknown";
 }
 
+/* Structure-of-arrays function selection */
+simd_soa_step_func_t simd_select_soa_step_function(void) {
+    if (!g_simd_initialized) {
+        simd_detect_capabilities();
+    }
+
+    if (simd_is_supported(SIMD_AVX512F)) {
+        return simd_step_soa_avx512;
+    }
+    if (simd_is_supported(SIMD_AVX2) && simd_is_supported(SIMD_FMA)) {
+        return simd_step_soa_avx2;
+    }
+    if (simd_is_supported(SIMD_SSE4_1)) {
+        return simd_step_soa_sse;
+    }
+    if (simd_is_supported(SIMD_NEON)) {
+        return simd_step_soa_neon;
+    }
+    return simd_step_soa_scalar;
+}
+
+const char *simd_get_soa_function_name(simd_soa_step_func_t func) {
+    if (func == simd_step_soa_avx512) return "AVX-512 (SoA)";
+    if (func == simd_step_soa_avx2) return "AVX2+FMA (SoA)";
+    if (func == simd_step_soa_sse) return "SSE4.1 (SoA)";
+    if (func == simd_step_soa_neon) return "NEON (SoA)";
+    if (func == simd_step_soa_scalar) return "Scalar (SoA)";
+    return "Unknown";
+}
+
 /* Performance monitoring */
 SIMDStats simd_get_stats(void) {
     return g_simd_stats;
@@ -341,11 +407,11 @@ int simd_validate_alignment(const void *ptr, size_t size, size_t alignment) {
     return 1;
 }
 
-/* Placeholder implementations for SIMD step functions */
+/* Scalar reference implementation */
 void simd_step_scalar(void *particles, int count, float dt, float gravity, float windx, float windy) {
     Particle *p = (Particle *)particles;
     
-    g_simd_stats.scalar_operations += count;
+    SIMD_STATS_ADD(scalar_operations, count);
     
     for (int i = 0; i < count; i++) {
         /* Apply forces */
@@ -358,16 +424,156 @@ void simd_step_scalar(void *particles, int count, float dt, float gravity, float
     }
 }
 
+#if defined(__x86_64__) || defined(__i386__)
+/* Step one AoS particle held as [x, y, vx, vy]: add [0, 0, ax*dt, ay*dt],
+ * then move the new velocity into the position lanes and integrate */
+SIMD_TARGET_SSE4
+static inline __m128 sse_step_particle(__m128 p, __m128 accel_dt, __m128 dt_vec) {
+    __m128 v = _mm_add_ps(p, accel_dt);
+    __m128 vel = _mm_movehl_ps(v, v);
+    __m128 pos = _mm_add_ps(v, _mm_mul_ps(vel, dt_vec));
+    return _mm_blend_ps(v, pos, 0x3);
+}
+
+SIMD_TARGET_SSE4
+static void sse_step_aos(Particle *p, int count, float dt, float gravity, float windx, float windy) {
+    const __m128 accel_dt = _mm_setr_ps(0.0f, 0.0f, windx * dt, (gravity + windy) * dt);
+    const __m128 dt_vec = _mm_set1_ps(dt);
+    float *data = (float *)p;
+    int i = 0;
+
+    if (((uintptr_t)data & 15) == 0) {
+        for (; i + 4 <= count; i += 4) {
+            float *q = data + i * 4;
+            __m128 p0 = sse_step_particle(_mm_load_ps(q), accel_dt, dt_vec);
+            __m128 p1 = sse_step_particle(_mm_load_ps(q + 4), accel_dt, dt_vec);
+            __m128 p2 = sse_step_particle(_mm_load_ps(q + 8), accel_dt, dt_vec);
+            __m128 p3 = sse_step_particle(_mm_load_ps(q + 12), accel_dt, dt_vec);
+            _mm_store_ps(q, p0);
+            _mm_store_ps(q + 4, p1);
+            _mm_store_ps(q + 8, p2);
+            _mm_store_ps(q + 12, p3);
+        }
+        for (; i < count; i++) {
+            _mm_store_ps(data + i * 4, sse_step_particle(_mm_load_ps(data + i * 4), accel_dt, dt_vec));
+        }
+    } else {
+        for (; i < count; i++) {
+            _mm_storeu_ps(data + i * 4, sse_step_particle(_mm_loadu_ps(data + i * 4), accel_dt, dt_vec));
+        }
+    }
+}
+
+/* FMA variant of sse_step_particle for the AVX2 kernel's odd particles */
+SIMD_TARGET_AVX2
+static inline __m128 fma_step_particle(__m128 p, __m128 accel_dt, __m128 dt_vec) {
+    __m128 v = _mm_add_ps(p, accel_dt);
+    __m128 vel = _mm_movehl_ps(v, v);
+    return _mm_blend_ps(v, _mm_fmadd_ps(vel, dt_vec, v), 0x3);
+}
+
+/* Step two AoS particles held as [x0, y0, vx0, vy0, x1, y1, vx1, vy1] */
+SIMD_TARGET_AVX2
+static inline __m256 avx2_step_pair(__m256 p, __m256 accel_dt, __m256 dt_vec) {
+    __m256 v = _mm256_add_ps(p, accel_dt);
+    __m256 vel = _mm256_permute_ps(v, _MM_SHUFFLE(3, 2, 3, 2));
+    return _mm256_blend_ps(v, _mm256_fmadd_ps(vel, dt_vec, v), 0x33);
+}
+
+SIMD_TARGET_AVX2
+static void avx2_step_aos(Particle *p, int count, float dt, float gravity, float windx, float windy) {
+    const __m128 accel_dt4 = _mm_setr_ps(0.0f, 0.0f, windx * dt, (gravity + windy) * dt);
+    const __m128 dt_vec4 = _mm_set1_ps(dt);
+    const __m256 accel_dt = _mm256_set_m128(accel_dt4, accel_dt4);
+    const __m256 dt_vec = _mm256_set1_ps(dt);
+    float *data = (float *)p;
+    int i = 0;
+
+    /* Peel one particle to reach a 32-byte boundary */
+    if (count > 0 && ((uintptr_t)data & 31) == 16) {
+        _mm_store_ps(data, fma_step_particle(_mm_load_ps(data), accel_dt4, dt_vec4));
+        i = 1;
+    }
+
+    if (((uintptr_t)(data + i * 4) & 31) == 0) {
+        for (; i + 8 <= count; i += 8) {
+            float *q = data + i * 4;
+            __m256 p0 = avx2_step_pair(_mm256_load_ps(q), accel_dt, dt_vec);
+            __m256 p1 = avx2_step_pair(_mm256_load_ps(q + 8), accel_dt, dt_vec);
+            __m256 p2 = avx2_step_pair(_mm256_load_ps(q + 16), accel_dt, dt_vec);
+            __m256 p3 = avx2_step_pair(_mm256_load_ps(q + 24), accel_dt, dt_vec);
+            _mm256_store_ps(q, p0);
+            _mm256_store_ps(q + 8, p1);
+            _mm256_store_ps(q + 16, p2);
+            _mm256_store_ps(q + 24, p3);
+        }
+    }
+    for (; i + 2 <= count; i += 2) {
+        float *q = data + i * 4;
+        _mm256_storeu_ps(q, avx2_step_pair(_mm256_loadu_ps(q), accel_dt, dt_vec));
+    }
+    if (i < count) {
+        float *q = data + i * 4;
+        _mm_storeu_ps(q, fma_step_particle(_mm_loadu_ps(q), accel_dt4, dt_vec4));
+    }
+}
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+/* Four AoS particles per zmm; remainder particles use a lane mask */
+SIMD_TARGET_AVX512
+static void avx512_step_aos(Particle *p, int count, float dt, float gravity, float windx, float windy) {
+    const float ax_dt = windx * dt;
+    const float ay_dt = (gravity + windy) * dt;
+    const __m512 accel_dt = _mm512_setr_ps(0, 0, ax_dt, ay_dt, 0, 0, ax_dt, ay_dt,
+                                           0, 0, ax_dt, ay_dt, 0, 0, ax_dt, ay_dt);
+    const __m512 dt_vec = _mm512_set1_ps(dt);
+    const __mmask16 position_lanes = 0x3333;
+    float *data = (float *)p;
+
+    for (int i = 0; i < count; i += 4) {
+        int remaining = count - i;
+        __mmask16 valid = remaining >= 4 ? (__mmask16)0xFFFF : (__mmask16)((1u << (remaining * 4)) - 1);
+        float *q = data + i * 4;
+
+        __m512 v = _mm512_add_ps(_mm512_maskz_loadu_ps(valid, q), accel_dt);
+        __m512 vel = _mm512_permute_ps(v, _MM_SHUFFLE(3, 2, 3, 2));
+        __m512 out = _mm512_mask_blend_ps(position_lanes, v, _mm512_fmadd_ps(vel, dt_vec, v));
+        _mm512_mask_storeu_ps(q, valid, out);
+    }
+}
+#endif
+
+/* AVX-512 kernel: four particles per register, masked remainder.
+ * Positions may differ from scalar by one ulp (fused multiply-add). */
+void simd_step_avx512(void *particles, int count, float dt, float gravity, float windx, float windy) {
+    #if defined(__x86_64__) || defined(__i386__)
+    avx512_step_aos((Particle *)particles, count, dt, gravity, windx, windy);
+    SIMD_STATS_ADD(simd_operations, count);
+    #else
+    simd_step_scalar(particles, count, dt, gravity, windx, windy);
+    #endif
+}
+
+/* SSE4.1 kernel: one particle per register, bit-identical to scalar */
 void simd_step_sse(void *particles, int count, float dt, float gravity, float windx, float windy) {
-    /* SSE implementation will be added in the next task */
+    #if defined(__x86_64__) || defined(__i386__)
+    sse_step_aos((Particle *)particles, count, dt, gravity, windx, windy);
+    SIMD_STATS_ADD(simd_operations, count);
+    #else
     simd_step_scalar(particles, count, dt, gravity, windx, windy);
-    g_simd_stats.simd_operations += count;
+    #endif
 }
 
+/* AVX2+FMA kernel: two particles per register. The fused multiply-add
+ * rounds once, so positions may differ from scalar by one ulp. */
 void simd_step_avx(void *particles, int count, float dt, float gravity, float windx, float windy) {
-    /* AVX implementation will be added in the next task */
+    #if defined(__x86_64__) || defined(__i386__)
+    avx2_step_aos((Particle *)particles, count, dt, gravity, windx, windy);
+    SIMD_STATS_ADD(simd_operations, count);
+    #else
     simd_step_scalar(particles, count, dt, gravity, windx, windy);
-    g_simd_stats.simd_operations += count;
+    #endif
 }
 
 void simd_step_neon(void *particles, int count, float dt, float gravity, float windx, float windy) {
@@ -436,12 +642,12 @@ void simd_step_neon(void *particles, int count, float dt, float gravity, float w
         p[i].y += p[i].vy * dt;
     }
     
-    g_simd_stats.simd_operations += vectorized_count;
-    g_simd_stats.scalar_operations += (count - vectorized_count);
+    SIMD_STATS_ADD(simd_operations, vectorized_count);
+    SIMD_STATS_ADD(scalar_operations, (count - vectorized_count));
     #else
     /* Fallback to scalar implementation on non-ARM platforms */
     simd_step_scalar(particles, count, dt, gravity, windx, windy);
-    g_simd_stats.scalar_operations += count;
+    SIMD_STATS_ADD(scalar_operations, count);
     #endif
 }
 
@@ -565,12 +771,205 @@ void simd_step_neon_optimized(void *particles, int count, float dt, float gravit
         p[i].y += p[i].vy * dt;
     }
     
-    g_simd_stats.simd_operations += vectorized_count;
-    g_simd_stats.scalar_operations += (count - vectorized_count);
+    SIMD_STATS_ADD(simd_operations, vectorized_count);
+    SIMD_STATS_ADD(scalar_operations, (count - vectorized_count));
     #else
     /* Fallback to scalar implementation on non-ARM platforms */
     simd_step_scalar(particles, count, dt, gravity, windx, windy);
-    g_simd_stats.scalar_operations += count;
+    SIMD_STATS_ADD(scalar_operations, count);
+    #endif
+}
+
+/* Structure-of-arrays scalar reference: same arithmetic as simd_step_scalar */
+void simd_step_soa_scalar(float *x, float *y, float *vx, float *vy, int count,
+                          float dt, float gravity, float windx, float windy) {
+    SIMD_STATS_ADD(scalar_operations, count);
+
+    for (int i = 0; i < count; i++) {
+        /* Apply forces */
+        vx[i] += windx * dt;
+        vy[i] += (gravity + windy) * dt;
+
+        /* Update position */
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+    }
+}
+
+/* Structure-of-arrays NEON kernel: columns load straight into registers */
+void simd_step_soa_neon(float *x, float *y, float *vx, float *vy, int count,
+                        float dt, float gravity, float windx, float windy) {
+    #ifdef __aarch64__
+    const float windx_dt = windx * dt;
+    const float gravity_windy_dt = (gravity + windy) * dt;
+    const float32x4_t windx_dt_vec = vdupq_n_f32(windx_dt);
+    const float32x4_t gravity_windy_dt_vec = vdupq_n_f32(gravity_windy_dt);
+    const float32x4_t dt_vec = vdupq_n_f32(dt);
+
+    int i = 0;
+    int vectorized_count = count & ~3;
+
+    for (; i < vectorized_count; i += 4) {
+        float32x4_t vvx = vaddq_f32(vld1q_f32(vx + i), windx_dt_vec);
+        float32x4_t vvy = vaddq_f32(vld1q_f32(vy + i), gravity_windy_dt_vec);
+        vst1q_f32(vx + i, vvx);
+        vst1q_f32(vy + i, vvy);
+        vst1q_f32(x + i, vaddq_f32(vld1q_f32(x + i), vmulq_f32(vvx, dt_vec)));
+        vst1q_f32(y + i, vaddq_f32(vld1q_f32(y + i), vmulq_f32(vvy, dt_vec)));
+    }
+
+    for (; i < count; i++) {
+        vx[i] += windx_dt;
+        vy[i] += gravity_windy_dt;
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+    }
+
+    SIMD_STATS_ADD(simd_operations, vectorized_count);
+    SIMD_STATS_ADD(scalar_operations, (count - vectorized_count));
+    #else
+    /* Fallback to scalar implementation on non-ARM platforms */
+    simd_step_soa_scalar(x, y, vx, vy, count, dt, gravity, windx, windy);
+    #endif
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+SIMD_TARGET_SSE4
+static int sse_step_soa(float *x, float *y, float *vx, float *vy, int count,
+                        float dt, float gravity, float windx, float windy) {
+    const __m128 windx_dt = _mm_set1_ps(windx * dt);
+    const __m128 gravity_windy_dt = _mm_set1_ps((gravity + windy) * dt);
+    const __m128 dt_vec = _mm_set1_ps(dt);
+    const int vectorized_count = count & ~3;
+    int i = 0;
+
+    if ((((uintptr_t)x | (uintptr_t)y | (uintptr_t)vx | (uintptr_t)vy) & 15) == 0) {
+        for (; i < vectorized_count; i += 4) {
+            __m128 vvx = _mm_add_ps(_mm_load_ps(vx + i), windx_dt);
+            __m128 vvy = _mm_add_ps(_mm_load_ps(vy + i), gravity_windy_dt);
+            _mm_store_ps(vx + i, vvx);
+            _mm_store_ps(vy + i, vvy);
+            _mm_store_ps(x + i, _mm_add_ps(_mm_load_ps(x + i), _mm_mul_ps(vvx, dt_vec)));
+            _mm_store_ps(y + i, _mm_add_ps(_mm_load_ps(y + i), _mm_mul_ps(vvy, dt_vec)));
+        }
+    } else {
+        for (; i < vectorized_count; i += 4) {
+            __m128 vvx = _mm_add_ps(_mm_loadu_ps(vx + i), windx_dt);
+            __m128 vvy = _mm_add_ps(_mm_loadu_ps(vy + i), gravity_windy_dt);
+            _mm_storeu_ps(vx + i, vvx);
+            _mm_storeu_ps(vy + i, vvy);
+            _mm_storeu_ps(x + i, _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(vvx, dt_vec)));
+            _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(vvy, dt_vec)));
+        }
+    }
+
+    /* Peeled tail */
+    for (; i < count; i++) {
+        vx[i] += windx * dt;
+        vy[i] += (gravity + windy) * dt;
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+    }
+    return vectorized_count;
+}
+
+SIMD_TARGET_AVX2
+static void avx2_step_soa(float *x, float *y, float *vx, float *vy, int count,
+                          float dt, float gravity, float windx, float windy) {
+    const __m256 windx_dt = _mm256_set1_ps(windx * dt);
+    const __m256 gravity_windy_dt = _mm256_set1_ps((gravity + windy) * dt);
+    const __m256 dt_vec = _mm256_set1_ps(dt);
+    const int vectorized_count = count & ~7;
+    int i = 0;
+
+    if ((((uintptr_t)x | (uintptr_t)y | (uintptr_t)vx | (uintptr_t)vy) & 31) == 0) {
+        for (; i < vectorized_count; i += 8) {
+            __m256 vvx = _mm256_add_ps(_mm256_load_ps(vx + i), windx_dt);
+            __m256 vvy = _mm256_add_ps(_mm256_load_ps(vy + i), gravity_windy_dt);
+            _mm256_store_ps(vx + i, vvx);
+            _mm256_store_ps(vy + i, vvy);
+            _mm256_store_ps(x + i, _mm256_fmadd_ps(vvx, dt_vec, _mm256_load_ps(x + i)));
+            _mm256_store_ps(y + i, _mm256_fmadd_ps(vvy, dt_vec, _mm256_load_ps(y + i)));
+        }
+    } else {
+        for (; i < vectorized_count; i += 8) {
+            __m256 vvx = _mm256_add_ps(_mm256_loadu_ps(vx + i), windx_dt);
+            __m256 vvy = _mm256_add_ps(_mm256_loadu_ps(vy + i), gravity_windy_dt);
+            _mm256_storeu_ps(vx + i, vvx);
+            _mm256_storeu_ps(vy + i, vvy);
+            _mm256_storeu_ps(x + i, _mm256_fmadd_ps(vvx, dt_vec, _mm256_loadu_ps(x + i)));
+            _mm256_storeu_ps(y + i, _mm256_fmadd_ps(vvy, dt_vec, _mm256_loadu_ps(y + i)));
+        }
+    }
+
+    /* Masked tail: lanes past the end are neither read nor written */
+    if (i < count) {
+        const __m256i mask = _mm256_cmpgt_epi32(_mm256_set1_epi32(count - i),
+                                                _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+        __m256 vvx = _mm256_add_ps(_mm256_maskload_ps(vx + i, mask), windx_dt);
+        __m256 vvy = _mm256_add_ps(_mm256_maskload_ps(vy + i, mask), gravity_windy_dt);
+        _mm256_maskstore_ps(vx + i, mask, vvx);
+        _mm256_maskstore_ps(vy + i, mask, vvy);
+        _mm256_maskstore_ps(x + i, mask, _mm256_fmadd_ps(vvx, dt_vec, _mm256_maskload_ps(x + i, mask)));
+        _mm256_maskstore_ps(y + i, mask, _mm256_fmadd_ps(vvy, dt_vec, _mm256_maskload_ps(y + i, mask)));
+    }
+}
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+/* Sixteen SoA lanes per iteration; the last iteration is masked */
+SIMD_TARGET_AVX512
+static void avx512_step_soa(float *x, float *y, float *vx, float *vy, int count,
+                            float dt, float gravity, float windx, float windy) {
+    const __m512 windx_dt = _mm512_set1_ps(windx * dt);
+    const __m512 gravity_windy_dt = _mm512_set1_ps((gravity + windy) * dt);
+    const __m512 dt_vec = _mm512_set1_ps(dt);
+
+    for (int i = 0; i < count; i += 16) {
+        int remaining = count - i;
+        __mmask16 valid = remaining >= 16 ? (__mmask16)0xFFFF : (__mmask16)((1u << remaining) - 1);
+
+        __m512 vvx = _mm512_add_ps(_mm512_maskz_loadu_ps(valid, vx + i), windx_dt);
+        __m512 vvy = _mm512_add_ps(_mm512_maskz_loadu_ps(valid, vy + i), gravity_windy_dt);
+        _mm512_mask_storeu_ps(vx + i, valid, vvx);
+        _mm512_mask_storeu_ps(vy + i, valid, vvy);
+        _mm512_mask_storeu_ps(x + i, valid, _mm512_fmadd_ps(vvx, dt_vec, _mm512_maskz_loadu_ps(valid, x + i)));
+        _mm512_mask_storeu_ps(y + i, valid, _mm512_fmadd_ps(vvy, dt_vec, _mm512_maskz_loadu_ps(valid, y + i)));
+    }
+}
+#endif
+
+/* Structure-of-arrays AVX-512 kernel (positions within one ulp of scalar) */
+void simd_step_soa_avx512(float *x, float *y, float *vx, float *vy, int count,
+                          float dt, float gravity, float windx, float windy) {
+    #if defined(__x86_64__) || defined(__i386__)
+    avx512_step_soa(x, y, vx, vy, count, dt, gravity, windx, windy);
+    SIMD_STATS_ADD(simd_operations, count);
+    #else
+    simd_step_soa_scalar(x, y, vx, vy, count, dt, gravity, windx, windy);
+    #endif
+}
+
+/* Structure-of-arrays SSE4.1 kernel: bit-identical to scalar */
+void simd_step_soa_sse(float *x, float *y, float *vx, float *vy, int count,
+                       float dt, float gravity, float windx, float windy) {
+    #if defined(__x86_64__) || defined(__i386__)
+    int vectorized_count = sse_step_soa(x, y, vx, vy, count, dt, gravity, windx, windy);
+    SIMD_STATS_ADD(simd_operations, vectorized_count);
+    SIMD_STATS_ADD(scalar_operations, (count - vectorized_count));
+    #else
+    simd_step_soa_scalar(x, y, vx, vy, count, dt, gravity, windx, windy);
+    #endif
+}
+
+/* Structure-of-arrays AVX2+FMA kernel (positions within one ulp of scalar) */
+void simd_step_soa_avx2(float *x, float *y, float *vx, float *vy, int count,
+                        float dt, float gravity, float windx, float windy) {
+    #if defined(__x86_64__) || defined(__i386__)
+    avx2_step_soa(x, y, vx, vy, count, dt, gravity, windx, windy);
+    SIMD_STATS_ADD(simd_operations, count);
+    #else
+    simd_step_soa_scalar(x, y, vx, vy, count, dt, gravity, windx, windy);
     #endif
 }
 
@@ -718,20 +1117,26 @@ Error simd_select_step_function_with_error(simd_step_func_t *func_out) {
         }
     }
     
-    /* Select best available implementation */
-    if (simd_is_supported(SIMD_AVX)) {
-        *func_out = simd_step_avx;
-    } else if (simd_is_supported(SIMD_SSE)) {
-        *func_out = simd_step_sse;
-    } else if (simd_is_supported(SIMD_NEON)) {
-        *func_out = simd_step_neon_optimized;
-    } else {
-        *func_out = simd_step_scalar;
-    }
+    *func_out = simd_select_step_function();
     
     return (Error){SUCCESS, NULL, NULL, 0, NULL};
 }
 
+/* Structure-of-arrays function selection with error handling */
+Error simd_select_soa_step_function_with_error(simd_soa_step_func_t *func_out) {
+    ERROR_CHECK_NULL(func_out, "Function output pointer");
+
+    if (!g_simd_initialized) {
+        Error err = simd_detect_capabilities_with_error(&g_simd_capabilities);
+        if (err.code != SUCCESS) {
+            return err;
+        }
+    }
+
+    *func_out = simd_select_soa_step_function();
+    return (Error){SUCCESS, NULL, NULL, 0, NULL};
+}
+
 /* SIMD step function execution with error handling */
 Error simd_step_with_error(Particle *particles, int count, float dt, float gravity, float windx, float windy) {
     ERROR_CHECK_NULL(particles, "Particles array");
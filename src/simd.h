@@ -42,6 +42,10 @@ typedef struct {
 /* SIMD step function type */
 typedef void (*simd_step_func_t)(void *particles, int count, float dt, float gravity, float windx, float windy);
 
+/* SIMD step function type for structure-of-arrays columns (updated in place) */
+typedef void (*simd_soa_step_func_t)(float *x, float *y, float *vx, float *vy, int count,
+                                     float dt, float gravity, float windx, float windy);
+
 /* Core SIMD functions */
 SIMDCapabilities simd_detect_capabilities(void);
 uint32_t simd_get_supported_features(void);
@@ -58,6 +62,8 @@ size_t simd_align_size(size_t size, size_t alignment);
 /* Function selection */
 simd_step_func_t simd_select_step_function(void);
 const char *simd_get_function_name(simd_step_func_t func);
+simd_soa_step_func_t simd_select_soa_step_function(void);
+const char *simd_get_soa_function_name(simd_soa_step_func_t func);
 
 /* Performance monitoring */
 SIMDStats simd_get_stats(void);
@@ -78,13 +84,27 @@ void simd_benchmark_functions(void);
 void simd_step_scalar(void *particles, int count, float dt, float gravity, float windx, float windy);
 void simd_step_sse(void *particles, int count, float dt, float gravity, float windx, float windy);
 void simd_step_avx(void *particles, int count, float dt, float gravity, float windx, float windy);
+void simd_step_avx512(void *particles, int count, float dt, float gravity, float windx, float windy);
 void simd_step_neon(void *particles, int count, float dt, float gravity, float windx, float windy);
 void simd_step_neon_optimized(void *particles, int count, float dt, float gravity, float windx, float windy);
 
+/* Structure-of-arrays step function implementations */
+void simd_step_soa_scalar(float *x, float *y, float *vx, float *vy, int count,
+                          float dt, float gravity, float windx, float windy);
+void simd_step_soa_sse(float *x, float *y, float *vx, float *vy, int count,
+                       float dt, float gravity, float windx, float windy);
+void simd_step_soa_avx2(float *x, float *y, float *vx, float *vy, int count,
+                        float dt, float gravity, float windx, float windy);
+void simd_step_soa_avx512(float *x, float *y, float *vx, float *vy, int count,
+                          float dt, float gravity, float windx, float windy);
+void simd_step_soa_neon(float *x, float *y, float *vx, float *vy, int count,
+                        float dt, float gravity, float windx, float windy);
+
 /* Error-aware SIMD functions */
 Error simd_aligned_alloc_with_error(size_t size, size_t alignment, void **ptr_out);
 Error simd_detect_capabilities_with_error(SIMDCapabilities *capabilities_out);
 Error simd_select_step_function_with_error(simd_step_func_t *func_out);
+Error simd_select_soa_step_function_with_error(simd_soa_step_func_t *func_out);
 Error simd_step_with_error(Particle *particles, int count, float dt, float gravity, float windx, float windy);
 
 #endif /* SIMD_H */
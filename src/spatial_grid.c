@@ -1,77 +1,236 @@
 #include "spatial_grid.h"
+#include "dispatch.h"
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
 
-/* Helper: Get cell at row, col */
-static inline GridCell* get_cell(SpatialGrid *grid, int row, int col) {
-    if (row < 0 || row >= grid->rows || col < 0 || col >= grid->cols) {
-        return NULL;
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define GRID_TARGET_SSE __attribute__((target("sse2")))
+#define GRID_TARGET_AVX2 __attribute__((target("avx2")))
+#define GRID_TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+
+/* Helper: Cell id for a world position, clamped into the grid */
+static inline int grid_cell_id(const SpatialGrid *grid, float x, float y) {
+    int col = (int)(x / grid->cell_width);
+    int row = (int)(y / grid->cell_height);
+
+    if (col < 0) col = 0;
+    if (col >= grid->cols) col = grid->cols - 1;
+    if (row < 0) row = 0;
+    if (row >= grid->rows) row = grid->rows - 1;
+
+    return row * grid->cols + col;
+}
+
+/* Per-particle int arrays: indices, entry_index, entry_cell, slot, movers */
+#define GRID_ENTRY_ARRAYS 5
+
+/* Ints in a particle block: the per-particle arrays plus the occupancy
+ * histogram (no cell can hold more than capacity particles) */
+#define GRID_BLOCK_INTS(capacity) ((GRID_ENTRY_ARRAYS + 1) * (size_t)(capacity) + 1)
+
+/* Helper: Point the per-particle arrays and histogram at a particle block */
+static void grid_bind_entries(SpatialGrid *grid, int *block, int capacity) {
+    grid->indices = block;
+    grid->entry_index = block + capacity;
+    grid->entry_cell = block + 2 * (size_t)capacity;
+    grid->slot = block + 3 * (size_t)capacity;
+    grid->movers = block + 4 * (size_t)capacity;
+    grid->occupancy = block + GRID_ENTRY_ARRAYS * (size_t)capacity;
+    grid->capacity = capacity;
+}
+
+/* Helper: Add one particle to a cell's count, keeping the histogram current */
+static inline void grid_count_add(SpatialGrid *grid, int cell) {
+    int n = grid->cell_count[cell]++;
+    grid->occupancy[n]--;
+    grid->occupancy[n + 1]++;
+    if (n + 1 > grid->max_occupancy) {
+        grid->max_occupancy = n + 1;
     }
-    return &grid->cells[row * grid->cols + col];
 }
 
-/* Helper: Initialize a grid cell */
-static Error grid_cell_init(GridCell *cell) {
-    cell->capacity = GRID_MAX_PARTICLES_PER_CELL;
-    cell->particles = malloc(sizeof(Particle*) * cell->capacity);
-    if (!cell->particles) {
-        return ERROR_CREATE(ERROR_MEMORY_ALLOCATION, "Failed to allocate grid cell");
+/* Helper: Remove one particle from a cell's count, keeping the histogram current */
+static inline void grid_count_remove(SpatialGrid *grid, int cell) {
+    int n = grid->cell_count[cell]--;
+    grid->occupancy[n]--;
+    grid->occupancy[n - 1]++;
+
+    /* The cell itself now holds n - 1, so the maximum drops at most one level */
+    if (n == grid->max_occupancy && grid->occupancy[n] == 0) {
+        grid->max_occupancy = n - 1;
     }
-    cell->count = 0;
-    return (Error){SUCCESS};
 }
 
-/* Helper: Free a grid cell */
-static void grid_cell_free(GridCell *cell) {
-    if (cell->particles) {
-        free(cell->particles);
-        cell->particles = NULL;
+/* Helper: Recompute the histogram from cell_count after a bulk rebuild */
+static void grid_recount_occupancy(SpatialGrid *grid) {
+    int total_cells = grid->rows * grid->cols;
+
+    memset(grid->occupancy, 0, sizeof(int) * ((size_t)grid->max_occupancy + 1));
+    grid->max_occupancy = 0;
+    for (int c = 0; c < total_cells; c++) {
+        int n = grid->cell_count[c];
+        grid->occupancy[n]++;
+        if (n > grid->max_occupancy) {
+            grid->max_occupancy = n;
+        }
     }
-    cell->count = 0;
-    cell->capacity = 0;
 }
 
-/* Helper: Clear a grid cell */
-static void grid_cell_clear(GridCell *cell) {
-    cell->count = 0;
+/* Helper: Make room for at least needed particles (keeps inserted entries) */
+static Error grid_reserve(SpatialGrid *grid, int needed) {
+    if (needed <= grid->capacity) {
+        return (Error){SUCCESS};
+    }
+
+    int new_capacity = grid->capacity > 0 ? grid->capacity : GRID_DEFAULT_CAPACITY;
+    while (new_capacity < needed) {
+        new_capacity *= 2;
+    }
+
+    int *block = malloc(sizeof(int) * GRID_BLOCK_INTS(new_capacity));
+    if (!block) {
+        return ERROR_CREATE(ERROR_MEMORY_ALLOCATION, "Failed to expand spatial grid");
+    }
+    memcpy(block + new_capacity, grid->entry_index, sizeof(int) * grid->total_particles);
+    memcpy(block + 2 * (size_t)new_capacity, grid->entry_cell, sizeof(int) * grid->total_particles);
+
+    /* Histogram levels above the current maximum are all zero */
+    int *occupancy = block + GRID_ENTRY_ARRAYS * (size_t)new_capacity;
+    int levels = grid->max_occupancy + 1;
+    memcpy(occupancy, grid->occupancy, sizeof(int) * levels);
+    memset(occupancy + levels, 0, sizeof(int) * ((size_t)new_capacity + 1 - levels));
+
+    free(grid->entry_block);
+    grid->entry_block = block;
+    grid_bind_entries(grid, block, new_capacity);
+    grid->dirty = true;
+    grid->tracking = false;
+    return (Error){SUCCESS};
 }
 
-/* Helper: Add particle to cell */
-static Error grid_cell_add(GridCell *cell, Particle *particle) {
-    if (cell->count >= cell->capacity) {
-        /* Expand capacity */
-        int new_capacity = cell->capacity * 2;
-        Particle **new_particles = realloc(cell->particles,
-                                           sizeof(Particle*) * new_capacity);
-        if (!new_particles) {
-            return ERROR_CREATE(ERROR_MEMORY_ALLOCATION,
-                              "Failed to expand grid cell");
+/* Helper: Counting sort of the inserted entries into cell_start/indices */
+static void grid_sort(SpatialGrid *grid) {
+    int total_cells = grid->rows * grid->cols;
+
+    /* Inclusive prefix sum: cell_start[c] = end of cell c */
+    int running = 0;
+    for (int c = 0; c < total_cells; c++) {
+        running += grid->cell_count[c];
+        grid->cell_start[c] = running;
+    }
+    grid->cell_start[total_cells] = running;
+
+    /* Scatter back to front so each cell keeps insertion order and its
+     * end offset is walked down to its start */
+    for (int e = grid->total_particles - 1; e >= 0; e--) {
+        int pos = --grid->cell_start[grid->entry_cell[e]];
+        grid->indices[pos] = grid->entry_index[e];
+        if (grid->tracking) {
+            grid->slot[e] = pos;
         }
-        cell->particles = new_particles;
-        cell->capacity = new_capacity;
     }
 
-    cell->particles[cell->count++] = particle;
-    return (Error){SUCCESS};
+    grid->dirty = false;
+}
+
+/* Helper: Move tracked particle i from cell `from` to cell `to`.
+ * Cell runs between the two each slide one slot towards `from`: moving one
+ * element from one end of the run to the other keeps every run contiguous,
+ * so a move costs one step per cell boundary crossed. */
+static void grid_move(SpatialGrid *grid, int i, int from, int to) {
+    int *start = grid->cell_start;
+    int *count = grid->cell_count;
+    int *indices = grid->indices;
+    int *slot = grid->slot;
+    int hole;
+
+    if (from < to) {
+        /* Swap i to the back of its run and drop it */
+        hole = start[from] + count[from] - 1;
+        int other = indices[hole];
+        indices[slot[i]] = other;
+        slot[other] = slot[i];
+        grid_count_remove(grid, from);
+
+        /* Each cell in between hands its last element to the hole at its front */
+        for (int c = from + 1; c < to; c++) {
+            start[c]--;
+            if (count[c] > 0) {
+                int tail = hole + count[c];
+                indices[hole] = indices[tail];
+                slot[indices[hole]] = hole;
+                hole = tail;
+            }
+        }
+        start[to]--;
+    } else {
+        /* Swap i to the front of its run and drop it */
+        hole = start[from];
+        int other = indices[hole];
+        indices[slot[i]] = other;
+        slot[other] = slot[i];
+        grid_count_remove(grid, from);
+        start[from]++;
+
+        /* Each cell in between hands its first element to the hole at its back */
+        for (int c = from - 1; c > to; c--) {
+            if (count[c] > 0) {
+                int head = start[c];
+                indices[hole] = indices[head];
+                slot[indices[hole]] = hole;
+                hole = head;
+            }
+            start[c]++;
+        }
+    }
+
+    indices[hole] = i;
+    slot[i] = hole;
+    grid_count_add(grid, to);
+    grid->entry_cell[i] = to;
+}
+
+/* Helper: Sort pending inserts before reading cells */
+static inline void grid_ensure_sorted(SpatialGrid *grid) {
+    if (grid->dirty) {
+        grid_sort(grid);
+    }
 }
 
 /* Create spatial grid */
 SpatialGrid* spatial_grid_create(int world_width, int world_height, float cell_size) {
-    if (world_width <= 0 || world_height <= 0 || cell_size <= 0) {
+    return spatial_grid_create_with_capacity(world_width, world_height, cell_size,
+                                             GRID_DEFAULT_CAPACITY);
+}
+
+/* Create spatial grid: struct, cell offsets and particle arrays in one block */
+SpatialGrid* spatial_grid_create_with_capacity(int world_width, int world_height,
+                                               float cell_size, int max_particles) {
+    if (world_width <= 0 || world_height <= 0 || cell_size <= 0 || max_particles < 0) {
         return NULL;
     }
 
-    SpatialGrid *grid = malloc(sizeof(SpatialGrid));
-    if (!grid) return NULL;
-
     /* Calculate grid dimensions */
-    grid->cols = (int)ceilf(world_width / cell_size);
-    grid->rows = (int)ceilf(world_height / cell_size);
+    int cols = (int)ceilf(world_width / cell_size);
+    int rows = (int)ceilf(world_height / cell_size);
 
     /* Ensure minimum grid size */
-    if (grid->cols < 2) grid->cols = 2;
-    if (grid->rows < 2) grid->rows = 2;
+    if (cols < 2) cols = 2;
+    if (rows < 2) rows = 2;
+
+    size_t total_cells = (size_t)rows * cols;
+    size_t size = sizeof(SpatialGrid) +
+                  sizeof(int) * ((total_cells + 1) + total_cells +
+                                 GRID_BLOCK_INTS(max_particles));
+
+    SpatialGrid *grid = calloc(1, size);
+    if (!grid) return NULL;
+
+    grid->cols = cols;
+    grid->rows = rows;
 
     /* Calculate actual cell size */
     grid->cell_width = (float)world_width / grid->cols;
@@ -80,55 +239,275 @@ SpatialGrid* spatial_grid_create(int world_width, int world_height, float cell_s
     grid->world_height = world_height;
     grid->total_particles = 0;
 
-    /* Allocate cells */
+    int *block = (int *)(grid + 1);
+    grid->cell_start = block;
+    grid->cell_count = block + total_cells + 1;
+    grid_bind_entries(grid, grid->cell_count + total_cells, max_particles);
+    grid->entry_block = NULL;
+    grid->dirty = false;
+    grid->tracking = false;
+    grid->last_moved = -1;
+    grid->occupancy[0] = (int)total_cells;
+    grid->max_occupancy = 0;
+
+    return grid;
+}
+
+/* Destroy spatial grid */
+void spatial_grid_destroy(SpatialGrid *grid) {
+    if (!grid) return;
+
+    free(grid->entry_block);
+    free(grid);
+}
+
+/* Clear all particles */
+void spatial_grid_clear(SpatialGrid *grid) {
+    if (!grid) return;
+
     int total_cells = grid->rows * grid->cols;
-    grid->cells = calloc(total_cells, sizeof(GridCell));
-    if (!grid->cells) {
-        free(grid);
-        return NULL;
+    memset(grid->cell_count, 0, sizeof(int) * total_cells);
+    memset(grid->cell_start, 0, sizeof(int) * (total_cells + 1));
+    memset(grid->occupancy + 1, 0, sizeof(int) * (size_t)grid->max_occupancy);
+    grid->occupancy[0] = total_cells;
+    grid->max_occupancy = 0;
+    grid->total_particles = 0;
+    grid->dirty = false;
+    grid->tracking = false;
+}
+
+/* Bin every particle with one counting-sort pass */
+Error spatial_grid_rebuild(SpatialGrid *grid, const ParticleSoA *particles) {
+    ERROR_CHECK_NULL(grid, "Spatial grid");
+    ERROR_CHECK_NULL(particles, "Particle columns");
+
+    spatial_grid_clear(grid);
+
+    Error err = grid_reserve(grid, particles->count);
+    if (err.code != SUCCESS) {
+        return err;
+    }
+
+    for (int i = 0; i < particles->count; i++) {
+        int cell = grid_cell_id(grid, particles->x[i], particles->y[i]);
+        grid->entry_index[i] = i;
+        grid->entry_cell[i] = cell;
+        grid_count_add(grid, cell);
     }
+    grid->total_particles = particles->count;
 
-    /* Initialize each cell */
-    for (int i = 0; i < total_cells; i++) {
-        Error err = grid_cell_init(&grid->cells[i]);
-        if (err.code != SUCCESS) {
-            /* Cleanup on error */
-            for (int j = 0; j < i; j++) {
-                grid_cell_free(&grid->cells[j]);
+    grid->tracking = true;
+    grid_sort(grid);
+    grid->last_moved = -1;
+    return (Error){SUCCESS};
+}
+
+/* Helper: Incremental update, falling back to a (parallel) rebuild */
+static Error grid_update(SpatialGrid *grid, const ParticleSoA *particles,
+                         ThreadPool *pool, FrameArena *arena) {
+    if (!grid->tracking || grid->dirty || grid->total_particles != particles->count) {
+        return spatial_grid_rebuild_parallel(grid, particles, pool, arena);
+    }
+
+    /* Collect the movers first and price the moves: one step per cell
+     * boundary crossed, against one pass over the population to re-sort */
+    int moved = 0;
+    long work = 0;
+    for (int i = 0; i < particles->count; i++) {
+        int cell = grid_cell_id(grid, particles->x[i], particles->y[i]);
+        if (cell != grid->entry_cell[i]) {
+            work += labs((long)cell - grid->entry_cell[i]);
+            if (work > particles->count) {
+                return spatial_grid_rebuild_parallel(grid, particles, pool, arena);
             }
-            free(grid->cells);
-            free(grid);
-            return NULL;
+            grid->movers[moved++] = i;
         }
     }
 
-    return grid;
+    for (int k = 0; k < moved; k++) {
+        int i = grid->movers[k];
+        grid_move(grid, i, grid->entry_cell[i],
+                  grid_cell_id(grid, particles->x[i], particles->y[i]));
+    }
+
+    grid->last_moved = moved;
+    return (Error){SUCCESS};
 }
 
-/* Destroy spatial grid */
-void spatial_grid_destroy(SpatialGrid *grid) {
-    if (!grid) return;
+/* Parallel counting sort: one histogram row per block of particles */
+typedef struct {
+    SpatialGrid *grid;
+    const ParticleSoA *particles;
+    int *histograms;           /* blocks x cells: counts, then scatter offsets */
+    int *range_totals;         /* Particles in each range of cells, then its offset */
+    int blocks;                /* Particle blocks (one histogram row each) */
+    int block_size;            /* Particles per block */
+    int range_size;            /* Cells per prefix-sum range */
+} GridBuildJob;
+
+/* Bin one block of particles into its own histogram row */
+static void grid_build_histogram(void *ctx, int begin, int end, int worker_id) {
+    GridBuildJob *job = (GridBuildJob *)ctx;
+    SpatialGrid *grid = job->grid;
+    int total_cells = grid->rows * grid->cols;
+    (void)worker_id;
+
+    for (int b = begin; b < end; b++) {
+        int *histogram = job->histograms + (size_t)b * total_cells;
+        int first = b * job->block_size;
+        int last = first + job->block_size < job->particles->count ?
+                   first + job->block_size : job->particles->count;
 
-    if (grid->cells) {
-        int total_cells = grid->rows * grid->cols;
-        for (int i = 0; i < total_cells; i++) {
-            grid_cell_free(&grid->cells[i]);
+        memset(histogram, 0, sizeof(int) * (size_t)total_cells);
+        for (int i = first; i < last; i++) {
+            int cell = grid_cell_id(grid, job->particles->x[i], job->particles->y[i]);
+            grid->entry_index[i] = i;
+            grid->entry_cell[i] = cell;
+            histogram[cell]++;
         }
-        free(grid->cells);
     }
+}
 
-    free(grid);
+/* Sum every block's count for one range of cells */
+static void grid_build_range_totals(void *ctx, int begin, int end, int worker_id) {
+    GridBuildJob *job = (GridBuildJob *)ctx;
+    SpatialGrid *grid = job->grid;
+    int total_cells = grid->rows * grid->cols;
+    (void)worker_id;
+
+    for (int r = begin; r < end; r++) {
+        int first = r * job->range_size;
+        int last = first + job->range_size < total_cells ? first + job->range_size : total_cells;
+        int total = 0;
+
+        for (int c = first; c < last; c++) {
+            int count = 0;
+            for (int b = 0; b < job->blocks; b++) {
+                count += job->histograms[(size_t)b * total_cells + c];
+            }
+            grid->cell_count[c] = count;
+            total += count;
+        }
+        job->range_totals[r] = total;
+    }
 }
 
-/* Clear all particles */
-void spatial_grid_clear(SpatialGrid *grid) {
-    if (!grid) return;
+/* Turn one range of counts into cell starts and per-block scatter offsets */
+static void grid_build_offsets(void *ctx, int begin, int end, int worker_id) {
+    GridBuildJob *job = (GridBuildJob *)ctx;
+    SpatialGrid *grid = job->grid;
+    int total_cells = grid->rows * grid->cols;
+    (void)worker_id;
+
+    for (int r = begin; r < end; r++) {
+        int first = r * job->range_size;
+        int last = first + job->range_size < total_cells ? first + job->range_size : total_cells;
+        int running = job->range_totals[r];
 
+        for (int c = first; c < last; c++) {
+            grid->cell_start[c] = running;
+            for (int b = 0; b < job->blocks; b++) {
+                int *offset = &job->histograms[(size_t)b * total_cells + c];
+                int count = *offset;
+                *offset = running;
+                running += count;
+            }
+        }
+    }
+}
+
+/* Scatter one block; blocks are in index order, so cells stay in index order */
+static void grid_build_scatter(void *ctx, int begin, int end, int worker_id) {
+    GridBuildJob *job = (GridBuildJob *)ctx;
+    SpatialGrid *grid = job->grid;
     int total_cells = grid->rows * grid->cols;
-    for (int i = 0; i < total_cells; i++) {
-        grid_cell_clear(&grid->cells[i]);
+    (void)worker_id;
+
+    for (int b = begin; b < end; b++) {
+        int *offsets = job->histograms + (size_t)b * total_cells;
+        int first = b * job->block_size;
+        int last = first + job->block_size < job->particles->count ?
+                   first + job->block_size : job->particles->count;
+
+        for (int i = first; i < last; i++) {
+            int pos = offsets[grid->entry_cell[i]]++;
+            grid->indices[pos] = i;
+            grid->slot[i] = pos;
+        }
     }
-    grid->total_particles = 0;
+}
+
+/* Bin every particle with a counting sort split across a worker pool */
+Error spatial_grid_rebuild_parallel(SpatialGrid *grid, const ParticleSoA *particles,
+                                    ThreadPool *pool, FrameArena *arena) {
+    ERROR_CHECK_NULL(grid, "Spatial grid");
+    ERROR_CHECK_NULL(particles, "Particle columns");
+
+    int workers = pool ? thread_pool_get_thread_count(pool) : 1;
+    int total_cells = grid->rows * grid->cols;
+    int count = particles->count;
+
+    /* Too small to split, or no scratch for the histograms */
+    if (workers < 2 || !arena || count < GRID_PARALLEL_MIN_PARTICLES) {
+        return spatial_grid_rebuild(grid, particles);
+    }
+
+    Error err = grid_reserve(grid, count);
+    if (err.code != SUCCESS) {
+        return err;
+    }
+
+    GridBuildJob job;
+    job.grid = grid;
+    job.particles = particles;
+    job.blocks = workers;
+    job.block_size = (count + workers - 1) / workers;
+    job.range_size = (total_cells + workers - 1) / workers;
+    job.histograms = arena_alloc(arena, sizeof(int) * (size_t)workers * total_cells);
+    job.range_totals = arena_alloc(arena, sizeof(int) * (size_t)workers);
+    if (!job.histograms || !job.range_totals) {
+        return spatial_grid_rebuild(grid, particles);
+    }
+    int ranges = (total_cells + job.range_size - 1) / job.range_size;
+
+    thread_pool_parallel_for(pool, job.blocks, 1, grid_build_histogram, &job);
+    thread_pool_parallel_for(pool, ranges, 1, grid_build_range_totals, &job);
+
+    /* Exclusive scan over the few range totals */
+    int running = 0;
+    for (int r = 0; r < ranges; r++) {
+        int total = job.range_totals[r];
+        job.range_totals[r] = running;
+        running += total;
+    }
+
+    thread_pool_parallel_for(pool, ranges, 1, grid_build_offsets, &job);
+    thread_pool_parallel_for(pool, job.blocks, 1, grid_build_scatter, &job);
+
+    grid->cell_start[total_cells] = count;
+    grid->total_particles = count;
+    grid_recount_occupancy(grid);
+    grid->dirty = false;
+    grid->tracking = true;
+    grid->last_moved = -1;
+    return (Error){SUCCESS};
+}
+
+/* Migrate only the particles whose cell changed since the last rebuild or update */
+Error spatial_grid_update(SpatialGrid *grid, const ParticleSoA *particles) {
+    ERROR_CHECK_NULL(grid, "Spatial grid");
+    ERROR_CHECK_NULL(particles, "Particle columns");
+
+    return grid_update(grid, particles, NULL, NULL);
+}
+
+/* Incremental update whose full-rebuild fallback runs on a worker pool */
+Error spatial_grid_update_parallel(SpatialGrid *grid, const ParticleSoA *particles,
+                                   ThreadPool *pool, FrameArena *arena) {
+    ERROR_CHECK_NULL(grid, "Spatial grid");
+    ERROR_CHECK_NULL(particles, "Particle columns");
+
+    return grid_update(grid, particles, pool, arena);
 }
 
 /* Convert world coordinates to cell indices */
@@ -153,71 +532,557 @@ bool spatial_grid_world_to_cell(SpatialGrid *grid, float x, float y,
             y >= 0 && y < grid->world_height);
 }
 
-/* Insert particle into grid */
-Error spatial_grid_insert(SpatialGrid *grid, Particle *particle) {
+/* Insert particle into grid (sorted lazily on the next query) */
+Error spatial_grid_insert(SpatialGrid *grid, int index, float x, float y) {
     ERROR_CHECK_NULL(grid, "Spatial grid");
-    ERROR_CHECK_NULL(particle, "Particle");
+    ERROR_CHECK_CONDITION(index >= 0, ERROR_INVALID_PARAMETER, "Particle index must be non-negative");
 
-    int col, row;
-    spatial_grid_world_to_cell(grid, particle->x, particle->y, &col, &row);
+    Error err = grid_reserve(grid, grid->total_particles + 1);
+    if (err.code != SUCCESS) {
+        return err;
+    }
+
+    int cell = grid_cell_id(grid, x, y);
+    grid->entry_index[grid->total_particles] = index;
+    grid->entry_cell[grid->total_particles] = cell;
+    grid->total_particles++;
+    grid_count_add(grid, cell);
+    grid->dirty = true;
+    grid->tracking = false;
 
-    GridCell *cell = get_cell(grid, row, col);
-    if (!cell) {
-        return ERROR_CREATE(ERROR_OUT_OF_RANGE, "Cell out of bounds");
+    return (Error){SUCCESS};
+}
+
+/* Run any pending counting sort */
+void spatial_grid_finalize(SpatialGrid *grid) {
+    if (grid) {
+        grid_ensure_sorted(grid);
+    }
+}
+
+/* Get the contiguous index run of one cell */
+const int *spatial_grid_cell_indices(SpatialGrid *grid, int col, int row, int *count_out) {
+    if (count_out) *count_out = 0;
+    if (!grid || col < 0 || col >= grid->cols || row < 0 || row >= grid->rows) {
+        return NULL;
     }
+    return spatial_grid_row_indices(grid, row, col, col, count_out);
+}
 
-    Error err = grid_cell_add(cell, particle);
-    if (err.code == SUCCESS) {
-        grid->total_particles++;
+/* Get the contiguous index run of several adjacent cells in one row */
+const int *spatial_grid_row_indices(SpatialGrid *grid, int row, int first_col, int last_col,
+                                    int *count_out) {
+    if (count_out) *count_out = 0;
+    if (!grid || row < 0 || row >= grid->rows) {
+        return NULL;
+    }
+
+    if (first_col < 0) first_col = 0;
+    if (last_col >= grid->cols) last_col = grid->cols - 1;
+    if (first_col > last_col) {
+        return NULL;
     }
 
-    return err;
+    grid_ensure_sorted(grid);
+
+    int begin = grid->cell_start[row * grid->cols + first_col];
+    int end = grid->cell_start[row * grid->cols + last_col + 1];
+    if (count_out) *count_out = end - begin;
+    return grid->indices + begin;
 }
 
 /* Get particles in specific cell */
 int spatial_grid_get_cell(SpatialGrid *grid, float x, float y,
-                          Particle **particles_out, int max_particles) {
-    if (!grid || !particles_out) return 0;
+                          int *indices_out, int max_particles) {
+    if (!grid || !indices_out) return 0;
 
     int col, row;
     spatial_grid_world_to_cell(grid, x, y, &col, &row);
 
-    GridCell *cell = get_cell(grid, row, col);
+    int cell_count;
+    const int *cell = spatial_grid_cell_indices(grid, col, row, &cell_count);
     if (!cell) return 0;
 
-    int count = cell->count < max_particles ? cell->count : max_particles;
-    memcpy(particles_out, cell->particles, count * sizeof(Particle*));
+    int count = cell_count < max_particles ? cell_count : max_particles;
+    memcpy(indices_out, cell, count * sizeof(int));
 
     return count;
 }
 
+/* ===== BATCHED RADIUS QUERIES ===== */
+
+/* Distance filter, one particle at a time */
+int spatial_grid_filter_scalar(const float *xs, const float *ys, const int *run, int count,
+                               float cx, float cy, float radius_sq, int *out) {
+    int n = 0;
+    for (int k = 0; k < count; k++) {
+        float dx = xs[k] - cx;
+        float dy = ys[k] - cy;
+        if (dx * dx + dy * dy <= radius_sq) {
+            out[n++] = run[k];
+        }
+    }
+    return n;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+/* Append the lanes set in mask, lowest lane first */
+static inline int grid_append_lanes(unsigned mask, const int *run, int *out, int n) {
+    while (mask) {
+        out[n++] = run[__builtin_ctz(mask)];
+        mask &= mask - 1;
+    }
+    return n;
+}
+
+GRID_TARGET_SSE
+static int grid_filter_sse(const float *xs, const float *ys, const int *run, int count,
+                           float cx, float cy, float radius_sq, int *out) {
+    __m128 vcx = _mm_set1_ps(cx), vcy = _mm_set1_ps(cy), vr2 = _mm_set1_ps(radius_sq);
+    int n = 0, k = 0;
+    for (; k + 4 <= count; k += 4) {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(xs + k), vcx);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(ys + k), vcy);
+        __m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        n = grid_append_lanes((unsigned)_mm_movemask_ps(_mm_cmple_ps(d2, vr2)), run + k, out, n);
+    }
+    return n + spatial_grid_filter_scalar(xs + k, ys + k, run + k, count - k, cx, cy, radius_sq, out + n);
+}
+
+GRID_TARGET_AVX2
+static int grid_filter_avx2(const float *xs, const float *ys, const int *run, int count,
+                            float cx, float cy, float radius_sq, int *out) {
+    __m256 vcx = _mm256_set1_ps(cx), vcy = _mm256_set1_ps(cy), vr2 = _mm256_set1_ps(radius_sq);
+    int n = 0, k = 0;
+    for (; k + 8 <= count; k += 8) {
+        __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(xs + k), vcx);
+        __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(ys + k), vcy);
+        __m256 d2 = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+        n = grid_append_lanes((unsigned)_mm256_movemask_ps(_mm256_cmp_ps(d2, vr2, _CMP_LE_OQ)),
+                              run + k, out, n);
+    }
+    return n + spatial_grid_filter_scalar(xs + k, ys + k, run + k, count - k, cx, cy, radius_sq, out + n);
+}
+
+/* Sixteen lanes, masked remainder, matches compressed straight to out */
+GRID_TARGET_AVX512
+static int grid_filter_avx512(const float *xs, const float *ys, const int *run, int count,
+                              float cx, float cy, float radius_sq, int *out) {
+    __m512 vcx = _mm512_set1_ps(cx), vcy = _mm512_set1_ps(cy), vr2 = _mm512_set1_ps(radius_sq);
+    int n = 0;
+    for (int k = 0; k < count; k += 16) {
+        int lanes = count - k < 16 ? count - k : 16;
+        __mmask16 valid = (__mmask16)((1u << lanes) - 1u);
+        __m512 dx = _mm512_sub_ps(_mm512_maskz_loadu_ps(valid, xs + k), vcx);
+        __m512 dy = _mm512_sub_ps(_mm512_maskz_loadu_ps(valid, ys + k), vcy);
+        __m512 d2 = _mm512_add_ps(_mm512_mul_ps(dx, dx), _mm512_mul_ps(dy, dy));
+        __mmask16 hit = _mm512_mask_cmp_ps_mask(valid, d2, vr2, _CMP_LE_OQ);
+        _mm512_mask_compressstoreu_epi32(out + n, hit, _mm512_maskz_loadu_epi32(valid, run + k));
+        n += __builtin_popcount((unsigned)hit);
+    }
+    return n;
+}
+#endif
+
+int spatial_grid_filter_sse(const float *xs, const float *ys, const int *run, int count,
+                            float cx, float cy, float radius_sq, int *out) {
+    #if defined(__x86_64__) || defined(__i386__)
+    return grid_filter_sse(xs, ys, run, count, cx, cy, radius_sq, out);
+    #else
+    return spatial_grid_filter_scalar(xs, ys, run, count, cx, cy, radius_sq, out);
+    #endif
+}
+
+int spatial_grid_filter_avx2(const float *xs, const float *ys, const int *run, int count,
+                             float cx, float cy, float radius_sq, int *out) {
+    #if defined(__x86_64__) || defined(__i386__)
+    return grid_filter_avx2(xs, ys, run, count, cx, cy, radius_sq, out);
+    #else
+    return spatial_grid_filter_scalar(xs, ys, run, count, cx, cy, radius_sq, out);
+    #endif
+}
+
+int spatial_grid_filter_avx512(const float *xs, const float *ys, const int *run, int count,
+                               float cx, float cy, float radius_sq, int *out) {
+    #if defined(__x86_64__) || defined(__i386__)
+    return grid_filter_avx512(xs, ys, run, count, cx, cy, radius_sq, out);
+    #else
+    return spatial_grid_filter_scalar(xs, ys, run, count, cx, cy, radius_sq, out);
+    #endif
+}
+
+void spatial_grid_query_results_init(GridQueryResults *results) {
+    if (results) {
+        memset(results, 0, sizeof(GridQueryResults));
+    }
+}
+
+void spatial_grid_query_results_free(GridQueryResults *results) {
+    if (results) {
+        free(results->offsets);
+        free(results->indices);
+        free(results->pair_query);
+        free(results->pair_index);
+        memset(results, 0, sizeof(GridQueryResults));
+    }
+}
+
+/* Helper: Make room for needed matches (keeps the ones found so far) */
+static bool grid_results_reserve_pairs(GridQueryResults *results, int needed) {
+    if (needed <= results->pair_capacity) {
+        return true;
+    }
+
+    int new_capacity = results->pair_capacity > 0 ? results->pair_capacity : GRID_DEFAULT_CAPACITY;
+    while (new_capacity < needed) {
+        new_capacity *= 2;
+    }
+
+    int *indices = realloc(results->indices, sizeof(int) * (size_t)new_capacity);
+    if (indices) results->indices = indices;
+    int *pair_query = realloc(results->pair_query, sizeof(int) * (size_t)new_capacity);
+    if (pair_query) results->pair_query = pair_query;
+    int *pair_index = realloc(results->pair_index, sizeof(int) * (size_t)new_capacity);
+    if (pair_index) results->pair_index = pair_index;
+    if (!indices || !pair_query || !pair_index) {
+        return false;
+    }
+
+    results->pair_capacity = new_capacity;
+    return true;
+}
+
+/* Helper: Cell rectangle a query searches (same extent as spatial_grid_query_radius) */
+static inline void grid_query_rect(const SpatialGrid *grid, float x, float y, float radius,
+                                   int *first_col, int *last_col, int *first_row, int *last_row) {
+    int col, row;
+    spatial_grid_world_to_cell((SpatialGrid *)grid, x, y, &col, &row);
+
+    int cell_radius = (int)ceilf(radius / fminf(grid->cell_width, grid->cell_height));
+    *first_col = col - cell_radius < 0 ? 0 : col - cell_radius;
+    *last_col = col + cell_radius >= grid->cols ? grid->cols - 1 : col + cell_radius;
+    *first_row = row - cell_radius < 0 ? 0 : row - cell_radius;
+    *last_row = row + cell_radius >= grid->rows ? grid->rows - 1 : row + cell_radius;
+}
+
+/* Query many circles, visiting each overlapped cell once */
+Error spatial_grid_query_radius_batch(SpatialGrid *grid, const ParticleSoA *particles,
+                                      const float *centers_x, const float *centers_y,
+                                      const float *radii, int num_queries,
+                                      FrameArena *arena, GridQueryResults *results) {
+    ERROR_CHECK_NULL(grid, "Spatial grid");
+    ERROR_CHECK_NULL(particles, "Particle columns");
+    ERROR_CHECK_NULL(results, "Query results");
+    ERROR_CHECK_CONDITION(num_queries >= 0, ERROR_INVALID_PARAMETER, "Query count must be non-negative");
+    ERROR_CHECK_CONDITION(num_queries == 0 || (centers_x && centers_y && radii), ERROR_NULL_POINTER,
+                          "Query arrays cannot be NULL");
+    ERROR_CHECK_NULL(arena, "Frame arena");
+
+    /* Offsets */
+    if (num_queries + 1 > results->query_capacity) {
+        int *offsets = realloc(results->offsets, sizeof(int) * ((size_t)num_queries + 1));
+        if (!offsets) {
+            return ERROR_CREATE(ERROR_MEMORY_ALLOCATION, "Failed to expand query results");
+        }
+        results->offsets = offsets;
+        results->query_capacity = num_queries + 1;
+    }
+    results->num_queries = num_queries;
+    memset(results->offsets, 0, sizeof(int) * ((size_t)num_queries + 1));
+    if (num_queries == 0) {
+        return (Error){SUCCESS};
+    }
+
+    grid_ensure_sorted(grid);
+
+    /* Bin the queries by the cells they overlap (counting sort, queries
+     * stay in ascending order within each cell) */
+    int total_cells = grid->rows * grid->cols;
+    int *bin_start = arena_alloc(arena, sizeof(int) * ((size_t)total_cells + 1));
+    float *xs = arena_alloc(arena, sizeof(float) * ((size_t)grid->total_particles + 1));
+    float *ys = arena_alloc(arena, sizeof(float) * ((size_t)grid->total_particles + 1));
+    if (!bin_start || !xs || !ys) {
+        return ERROR_CREATE(ERROR_MEMORY_ALLOCATION, "Failed to allocate query scratch");
+    }
+    memset(bin_start, 0, sizeof(int) * ((size_t)total_cells + 1));
+
+    long refs = 0;
+    for (int q = 0; q < num_queries; q++) {
+        if (!(radii[q] >= 0.0f)) continue;
+        int c0, c1, r0, r1;
+        grid_query_rect(grid, centers_x[q], centers_y[q], radii[q], &c0, &c1, &r0, &r1);
+        for (int row = r0; row <= r1; row++) {
+            for (int col = c0; col <= c1; col++) {
+                bin_start[row * grid->cols + col + 1]++;
+            }
+        }
+        refs += (long)(c1 - c0 + 1) * (r1 - r0 + 1);
+    }
+    if (refs > INT32_MAX) {
+        return ERROR_CREATE(ERROR_INVALID_PARAMETER, "Query batch covers too many cells");
+    }
+    for (int c = 0; c < total_cells; c++) {
+        bin_start[c + 1] += bin_start[c];
+    }
+
+    int *bin_queries = arena_alloc(arena, sizeof(int) * ((size_t)refs + 1));
+    int *bin_fill = arena_alloc(arena, sizeof(int) * (size_t)total_cells);
+    if (!bin_queries || !bin_fill) {
+        return ERROR_CREATE(ERROR_MEMORY_ALLOCATION, "Failed to allocate query scratch");
+    }
+    memcpy(bin_fill, bin_start, sizeof(int) * (size_t)total_cells);
+    for (int q = 0; q < num_queries; q++) {
+        if (!(radii[q] >= 0.0f)) continue;
+        int c0, c1, r0, r1;
+        grid_query_rect(grid, centers_x[q], centers_y[q], radii[q], &c0, &c1, &r0, &r1);
+        for (int row = r0; row <= r1; row++) {
+            for (int col = c0; col <= c1; col++) {
+                bin_queries[bin_fill[row * grid->cols + col]++] = q;
+            }
+        }
+    }
+
+    /* Gather each touched cell once and test it against all its queries */
+    grid_radius_filter_func_t filter = dispatch_get()->radius_filter;
+    int pairs = 0;
+    for (int c = 0; c < total_cells; c++) {
+        int first = bin_start[c], last = bin_start[c + 1];
+        int count = grid->cell_count[c];
+        if (first == last || count == 0) continue;
+
+        const int *run = grid->indices + grid->cell_start[c];
+        for (int k = 0; k < count; k++) {
+            xs[k] = particles->x[run[k]];
+            ys[k] = particles->y[run[k]];
+        }
+
+        for (int b = first; b < last; b++) {
+            int q = bin_queries[b];
+            if (!grid_results_reserve_pairs(results, pairs + count)) {
+                return ERROR_CREATE(ERROR_MEMORY_ALLOCATION, "Failed to expand query results");
+            }
+            int found = filter(xs, ys, run, count, centers_x[q], centers_y[q],
+                               radii[q] * radii[q], results->pair_index + pairs);
+            for (int k = 0; k < found; k++) {
+                results->pair_query[pairs + k] = q;
+            }
+            results->offsets[q + 1] += found;
+            pairs += found;
+        }
+    }
+
+    /* Group the matches by query; cells were visited in ascending order,
+     * so each query keeps spatial_grid_query_radius() order */
+    for (int q = 0; q < num_queries; q++) {
+        results->offsets[q + 1] += results->offsets[q];
+    }
+    int *fill = arena_alloc(arena, sizeof(int) * (size_t)num_queries);
+    if (!fill) {
+        return ERROR_CREATE(ERROR_MEMORY_ALLOCATION, "Failed to allocate query scratch");
+    }
+    memcpy(fill, results->offsets, sizeof(int) * (size_t)num_queries);
+    for (int k = 0; k < pairs; k++) {
+        results->indices[fill[results->pair_query[k]]++] = results->pair_index[k];
+    }
+
+    return (Error){SUCCESS};
+}
+
+/* ===== K-NEAREST NEIGHBORS ===== */
+
+/* Helper: Heap order: farther first, then higher index */
+static inline bool knn_after(float da, int ia, float db, int ib) {
+    return da > db || (da == db && ia > ib);
+}
+
+/* Helper: Restore the max-heap below position i */
+static void knn_sift_down(int *idx, float *dist, int size, int i) {
+    for (;;) {
+        int largest = i;
+        int left = 2 * i + 1, right = left + 1;
+        if (left < size && knn_after(dist[left], idx[left], dist[largest], idx[largest])) largest = left;
+        if (right < size && knn_after(dist[right], idx[right], dist[largest], idx[largest])) largest = right;
+        if (largest == i) return;
+
+        float td = dist[i]; dist[i] = dist[largest]; dist[largest] = td;
+        int ti = idx[i]; idx[i] = idx[largest]; idx[largest] = ti;
+        i = largest;
+    }
+}
+
+/* Helper: Offer one candidate to a heap holding size of k entries */
+static inline int knn_offer(int *idx, float *dist, int size, int k, int index, float d2) {
+    if (size < k) {
+        /* Sift up */
+        int i = size++;
+        while (i > 0) {
+            int parent = (i - 1) / 2;
+            if (!knn_after(d2, index, dist[parent], idx[parent])) break;
+            dist[i] = dist[parent];
+            idx[i] = idx[parent];
+            i = parent;
+        }
+        dist[i] = d2;
+        idx[i] = index;
+    } else if (knn_after(dist[0], idx[0], d2, index)) {
+        dist[0] = d2;
+        idx[0] = index;
+        knn_sift_down(idx, dist, size, 0);
+    }
+    return size;
+}
+
+/* Helper: Test every particle of cells first_col..last_col in one row */
+static inline int knn_scan_run(SpatialGrid *grid, const ParticleSoA *particles, int row,
+                               int first_col, int last_col, float x, float y,
+                               int *idx, float *dist, int size, int k) {
+    int count;
+    const int *run = spatial_grid_row_indices(grid, row, first_col, last_col, &count);
+    for (int i = 0; i < count; i++) {
+        float dx = particles->x[run[i]] - x;
+        float dy = particles->y[run[i]] - y;
+        size = knn_offer(idx, dist, size, k, run[i], dx * dx + dy * dy);
+    }
+    return size;
+}
+
+/* Find the k particles nearest to a point */
+int spatial_grid_query_knn(SpatialGrid *grid, const ParticleSoA *particles,
+                           float x, float y, int k, int *indices_out, float *dist_sq_out) {
+    if (!grid || !particles || !indices_out || !dist_sq_out || k <= 0) return 0;
+
+    grid_ensure_sorted(grid);
+
+    int col, row;
+    spatial_grid_world_to_cell(grid, x, y, &col, &row);
+    int size = 0;
+
+    for (int ring = 0; ; ring++) {
+        int c0 = col - ring, c1 = col + ring, r0 = row - ring, r1 = row + ring;
+
+        /* Top and bottom rows of the ring are whole runs; the sides are
+         * single cells on the rows in between */
+        if (r0 >= 0) {
+            size = knn_scan_run(grid, particles, r0, c0, c1, x, y, indices_out, dist_sq_out, size, k);
+        }
+        if (ring > 0 && r1 < grid->rows) {
+            size = knn_scan_run(grid, particles, r1, c0, c1, x, y, indices_out, dist_sq_out, size, k);
+        }
+        for (int r = r0 + 1; ring > 0 && r < r1; r++) {
+            if (r < 0 || r >= grid->rows) continue;
+            if (c0 >= 0) {
+                size = knn_scan_run(grid, particles, r, c0, c0, x, y, indices_out, dist_sq_out, size, k);
+            }
+            if (c1 < grid->cols) {
+                size = knn_scan_run(grid, particles, r, c1, c1, x, y, indices_out, dist_sq_out, size, k);
+            }
+        }
+
+        /* Searched square already covers the grid */
+        bool left_done = c0 <= 0, right_done = c1 >= grid->cols - 1;
+        bool top_done = r0 <= 0, bottom_done = r1 >= grid->rows - 1;
+        if (left_done && right_done && top_done && bottom_done) {
+            break;
+        }
+
+        /* Anything unsearched lies beyond an open side of the square (edge
+         * cells also hold the clamped out-of-world particles, which are
+         * farther still), so the nearest open side bounds its distance */
+        if (size == k) {
+            float gap = INFINITY;
+            if (!left_done) gap = fminf(gap, x - (float)c0 * grid->cell_width);
+            if (!right_done) gap = fminf(gap, (float)(c1 + 1) * grid->cell_width - x);
+            if (!top_done) gap = fminf(gap, y - (float)r0 * grid->cell_height);
+            if (!bottom_done) gap = fminf(gap, (float)(r1 + 1) * grid->cell_height - y);
+            if (gap * gap > dist_sq_out[0]) {
+                break;
+            }
+        }
+    }
+
+    /* Heap sort: pop the farthest to the back until sorted closest first */
+    for (int end = size - 1; end > 0; end--) {
+        float td = dist_sq_out[0]; dist_sq_out[0] = dist_sq_out[end]; dist_sq_out[end] = td;
+        int ti = indices_out[0]; indices_out[0] = indices_out[end]; indices_out[end] = ti;
+        knn_sift_down(indices_out, dist_sq_out, end, 0);
+    }
+    return size;
+}
+
+/* Shared state for a batch of kNN queries */
+typedef struct {
+    SpatialGrid *grid;
+    const ParticleSoA *particles;
+    const float *centers_x;
+    const float *centers_y;
+    int k;
+    int *indices_out;
+    float *dist_sq_out;
+} KnnBatchJob;
+
+/* Run a range of kNN queries */
+static void knn_batch_chunk(void *ctx, int begin, int end, int worker_id) {
+    KnnBatchJob *job = (KnnBatchJob *)ctx;
+    (void)worker_id;
+
+    for (int q = begin; q < end; q++) {
+        int *indices = job->indices_out + (size_t)q * job->k;
+        float *dist = job->dist_sq_out + (size_t)q * job->k;
+        int found = spatial_grid_query_knn(job->grid, job->particles, job->centers_x[q],
+                                           job->centers_y[q], job->k, indices, dist);
+        for (int i = found; i < job->k; i++) {
+            indices[i] = -1;
+            dist[i] = INFINITY;
+        }
+    }
+}
+
+/* Run many kNN queries, optionally across a worker pool */
+Error spatial_grid_query_knn_batch(SpatialGrid *grid, const ParticleSoA *particles,
+                                   const float *centers_x, const float *centers_y, int num_queries,
+                                   int k, int *indices_out, float *dist_sq_out, ThreadPool *pool) {
+    ERROR_CHECK_NULL(grid, "Spatial grid");
+    ERROR_CHECK_NULL(particles, "Particle columns");
+    ERROR_CHECK_CONDITION(k > 0, ERROR_INVALID_PARAMETER, "k must be positive");
+    ERROR_CHECK_CONDITION(num_queries >= 0, ERROR_INVALID_PARAMETER, "Query count must be non-negative");
+    ERROR_CHECK_CONDITION(num_queries == 0 || (centers_x && centers_y && indices_out && dist_sq_out),
+                          ERROR_NULL_POINTER, "Query arrays cannot be NULL");
+
+    /* Workers only read the grid */
+    grid_ensure_sorted(grid);
+
+    KnnBatchJob job = { grid, particles, centers_x, centers_y, k, indices_out, dist_sq_out };
+    thread_pool_parallel_for(pool, num_queries, 16, knn_batch_chunk, &job);
+    return (Error){SUCCESS};
+}
+
 /* Get particles in 3x3 neighborhood */
 int spatial_grid_get_neighbors(SpatialGrid *grid, float x, float y,
-                               Particle **particles_out, int max_particles) {
-    if (!grid || !particles_out) return 0;
+                               int *indices_out, int max_particles) {
+    if (!grid || !indices_out) return 0;
+
+    grid_ensure_sorted(grid);
 
     int center_col, center_row;
     spatial_grid_world_to_cell(grid, x, y, &center_col, &center_row);
 
+    int first_col = center_col > 0 ? center_col - 1 : 0;
+    int last_col = center_col < grid->cols - 1 ? center_col + 1 : grid->cols - 1;
     int total = 0;
 
-    /* Check 3x3 neighborhood */
-    for (int dr = -1; dr <= 1; dr++) {
-        for (int dc = -1; dc <= 1; dc++) {
-            int row = center_row + dr;
-            int col = center_col + dc;
+    /* Each row of the 3x3 neighborhood is one contiguous run */
+    for (int row = center_row - 1; row <= center_row + 1; row++) {
+        if (row < 0 || row >= grid->rows) continue;
 
-            GridCell *cell = get_cell(grid, row, col);
-            if (!cell) continue;
+        int begin = grid->cell_start[row * grid->cols + first_col];
+        int end = grid->cell_start[row * grid->cols + last_col + 1];
 
-            /* Add particles from this cell */
-            for (int i = 0; i < cell->count && total < max_particles; i++) {
-                particles_out[total++] = cell->particles[i];
-            }
+        for (int k = begin; k < end && total < max_particles; k++) {
+            indices_out[total++] = grid->indices[k];
+        }
 
-            if (total >= max_particles) {
-                return total;
-            }
+        if (total >= max_particles) {
+            return total;
         }
     }
 
@@ -225,86 +1090,223 @@ int spatial_grid_get_neighbors(SpatialGrid *grid, float x, float y,
 }
 
 /* Query particles within radius */
-int spatial_grid_query_radius(SpatialGrid *grid, float x, float y, float radius,
-                              Particle **particles_out, int max_particles) {
-    if (!grid || !particles_out) return 0;
+int spatial_grid_query_radius(SpatialGrid *grid, const ParticleSoA *particles,
+                              float x, float y, float radius,
+                              int *indices_out, int max_particles) {
+    if (!grid || !particles || !indices_out) return 0;
+
+    grid_ensure_sorted(grid);
 
     int center_col, center_row;
     spatial_grid_world_to_cell(grid, x, y, &center_col, &center_row);
 
     /* Calculate search range in cells */
     int cell_radius = (int)ceilf(radius / fminf(grid->cell_width, grid->cell_height));
+    int first_col = center_col - cell_radius < 0 ? 0 : center_col - cell_radius;
+    int last_col = center_col + cell_radius >= grid->cols ? grid->cols - 1 : center_col + cell_radius;
     int total = 0;
     float radius_sq = radius * radius;
 
-    /* Check cells within radius */
-    for (int dr = -cell_radius; dr <= cell_radius; dr++) {
-        for (int dc = -cell_radius; dc <= cell_radius; dc++) {
-            int row = center_row + dr;
-            int col = center_col + dc;
+    /* Walk each row of the search square as one contiguous run */
+    for (int row = center_row - cell_radius; row <= center_row + cell_radius; row++) {
+        if (row < 0 || row >= grid->rows) continue;
 
-            GridCell *cell = get_cell(grid, row, col);
-            if (!cell) continue;
+        int begin = grid->cell_start[row * grid->cols + first_col];
+        int end = grid->cell_start[row * grid->cols + last_col + 1];
 
-            /* Check particles in cell */
-            for (int i = 0; i < cell->count && total < max_particles; i++) {
-                Particle *p = cell->particles[i];
+        for (int k = begin; k < end && total < max_particles; k++) {
+            int index = grid->indices[k];
 
-                /* Distance check */
-                float dx = p->x - x;
-                float dy = p->y - y;
-                float dist_sq = dx * dx + dy * dy;
+            /* Distance check */
+            float dx = particles->x[index] - x;
+            float dy = particles->y[index] - y;
+            float dist_sq = dx * dx + dy * dy;
 
-                if (dist_sq <= radius_sq) {
-                    particles_out[total++] = p;
-                }
+            if (dist_sq <= radius_sq) {
+                indices_out[total++] = index;
             }
+        }
 
-            if (total >= max_particles) {
-                return total;
-            }
+        if (total >= max_particles) {
+            return total;
         }
     }
 
     return total;
 }
 
-/* Get grid statistics */
+/* Get grid statistics from the maintained counters */
 void spatial_grid_get_stats(SpatialGrid *grid, GridStats *stats) {
     if (!grid || !stats) return;
 
     memset(stats, 0, sizeof(GridStats));
 
     stats->total_cells = grid->rows * grid->cols;
-    stats->min_particles_per_cell = INT32_MAX;
-    stats->max_particles_per_cell = 0;
+    stats->empty_cells = grid->occupancy[0];
+    stats->occupied_cells = stats->total_cells - stats->empty_cells;
+    stats->max_particles_per_cell = grid->max_occupancy;
     stats->total_particles = grid->total_particles;
 
-    int total_in_occupied = 0;
+    if (stats->occupied_cells > 0) {
+        /* Lowest occupied level; stops after min_particles_per_cell steps */
+        int n = 1;
+        while (grid->occupancy[n] == 0) {
+            n++;
+        }
+        stats->min_particles_per_cell = n;
+        stats->avg_particles_per_cell = (float)grid->total_particles / stats->occupied_cells;
+    }
+}
+
+/* Copy the occupancy histogram */
+int spatial_grid_get_occupancy_histogram(const SpatialGrid *grid, int *counts_out, int max_levels) {
+    if (!grid) return 0;
 
-    for (int i = 0; i < stats->total_cells; i++) {
-        GridCell *cell = &grid->cells[i];
+    int levels = grid->max_occupancy + 1;
+    if (counts_out && max_levels > 0) {
+        memcpy(counts_out, grid->occupancy, sizeof(int) * (size_t)(levels < max_levels ? levels : max_levels));
+    }
+    return levels;
+}
 
-        if (cell->count > 0) {
-            stats->occupied_cells++;
-            total_in_occupied += cell->count;
+/* Helper: Smallest requested size whose rounded cells along a world side
+ * of this length are still at least the contact distance wide */
+static float grid_min_cell_size(int world_size, float collision_radius) {
+    float contact = 2.0f * collision_radius;
+    if (contact <= 0.0f) return 0.0f;
 
-            if (cell->count < stats->min_particles_per_cell) {
-                stats->min_particles_per_cell = cell->count;
-            }
-            if (cell->count > stats->max_particles_per_cell) {
-                stats->max_particles_per_cell = cell->count;
-            }
+    int cells = (int)floorf((float)world_size / contact);
+    if (cells < 1) return (float)world_size;
+
+    /* Nudge up so ceil(world_size / size) lands on cells, not cells + 1 */
+    return (float)world_size / (float)cells * 1.0001f;
+}
+
+/* Helper: Spread the low 16 bits of v to the even bit positions */
+static inline uint32_t morton_part1by1(uint32_t v) {
+    v &= 0x0000ffffu;
+    v = (v | (v << 8)) & 0x00ff00ffu;
+    v = (v | (v << 4)) & 0x0f0f0f0fu;
+    v = (v | (v << 2)) & 0x33333333u;
+    v = (v | (v << 1)) & 0x55555555u;
+    return v;
+}
+
+/* Order particles along the Morton curve of their cells */
+Error spatial_grid_morton_order(const SpatialGrid *grid, const ParticleSoA *particles,
+                                FrameArena *arena, int *order_out) {
+    ERROR_CHECK_NULL(grid, "Spatial grid");
+    ERROR_CHECK_NULL(particles, "Particle columns");
+    ERROR_CHECK_NULL(arena, "Frame arena");
+    ERROR_CHECK_NULL(order_out, "Order output");
+
+    int count = particles->count;
+    if (count <= 0) {
+        return (Error){SUCCESS};
+    }
+
+    size_t bytes = sizeof(uint32_t) * (size_t)count;
+    uint32_t *keys = arena_alloc(arena, bytes);
+    uint32_t *keys_tmp = arena_alloc(arena, bytes);
+    int *order_tmp = arena_alloc(arena, sizeof(int) * (size_t)count);
+    if (!keys || !keys_tmp || !order_tmp) {
+        return ERROR_CREATE(ERROR_MEMORY_ALLOCATION, "Failed to allocate Morton sort scratch");
+    }
+
+    uint32_t all_bits = 0;
+    for (int i = 0; i < count; i++) {
+        int cell = grid_cell_id(grid, particles->x[i], particles->y[i]);
+        uint32_t col = (uint32_t)(cell % grid->cols);
+        uint32_t row = (uint32_t)(cell / grid->cols);
+        keys[i] = morton_part1by1(col) | (morton_part1by1(row) << 1);
+        order_out[i] = i;
+        all_bits |= keys[i];
+    }
+
+    /* LSD radix sort, 8 bits a pass, ping-ponging between the buffers */
+    uint32_t *src_keys = keys, *dst_keys = keys_tmp;
+    int *src_order = order_out, *dst_order = order_tmp;
+    for (int shift = 0; shift < 32 && (all_bits >> shift) != 0; shift += 8) {
+        int histogram[256] = {0};
+        for (int i = 0; i < count; i++) {
+            histogram[(src_keys[i] >> shift) & 0xffu]++;
+        }
+
+        /* Every key has the same digit: this pass would not move anything */
+        if (histogram[(src_keys[0] >> shift) & 0xffu] == count) {
+            continue;
         }
+
+        int running = 0;
+        for (int d = 0; d < 256; d++) {
+            int n = histogram[d];
+            histogram[d] = running;
+            running += n;
+        }
+
+        for (int i = 0; i < count; i++) {
+            int pos = histogram[(src_keys[i] >> shift) & 0xffu]++;
+            dst_keys[pos] = src_keys[i];
+            dst_order[pos] = src_order[i];
+        }
+
+        uint32_t *swap_keys = src_keys; src_keys = dst_keys; dst_keys = swap_keys;
+        int *swap_order = src_order; src_order = dst_order; dst_order = swap_order;
     }
 
-    stats->empty_cells = stats->total_cells - stats->occupied_cells;
+    if (src_order != order_out) {
+        memcpy(order_out, src_order, sizeof(int) * (size_t)count);
+    }
+    return (Error){SUCCESS};
+}
 
-    if (stats->occupied_cells > 0) {
-        stats->avg_particles_per_cell = (float)total_in_occupied / stats->occupied_cells;
+/* Suggest a cell size from the current occupancy */
+float spatial_grid_tune_cell_size(SpatialGrid *grid, float collision_radius, float target_occupancy) {
+    if (!grid) return 0.0f;
+
+    if (target_occupancy <= 0.0f) {
+        target_occupancy = GRID_TARGET_OCCUPANCY;
     }
 
-    if (stats->min_particles_per_cell == INT32_MAX) {
-        stats->min_particles_per_cell = 0;
+    float size = fmaxf(grid->cell_width, grid->cell_height);
+
+    /* Occupied-cell average tracks local density, so clustered sets are
+     * sized for their clusters rather than for the empty space around them */
+    GridStats stats;
+    spatial_grid_get_stats(grid, &stats);
+    if (stats.occupied_cells > 0 && stats.avg_particles_per_cell > 0.0f) {
+        size *= sqrtf(target_occupancy / stats.avg_particles_per_cell);
+    }
+
+    float max_size = 0.5f * (float)(grid->world_width < grid->world_height ?
+                                    grid->world_width : grid->world_height);
+    float min_size = fmaxf(grid_min_cell_size(grid->world_width, collision_radius),
+                           grid_min_cell_size(grid->world_height, collision_radius));
+
+    if (size > max_size) size = max_size;
+    if (size < min_size) size = min_size;
+    return size;
+}
+
+/* Check whether the grid is unsafe for the radius or has drifted past the tolerance */
+bool spatial_grid_needs_retune(const SpatialGrid *grid, float cell_size, float collision_radius) {
+    if (!grid || cell_size <= 0.0f) return false;
+
+    /* Same layout as now: nothing to gain */
+    int cols = (int)ceilf(grid->world_width / cell_size);
+    int rows = (int)ceilf(grid->world_height / cell_size);
+    if (cols < 2) cols = 2;
+    if (rows < 2) rows = 2;
+    if (cols == grid->cols && rows == grid->rows) {
+        return false;
     }
+
+    /* Cells narrower than the contact distance miss pairs */
+    if (fminf(grid->cell_width, grid->cell_height) < 2.0f * collision_radius) {
+        return true;
+    }
+
+    float current = fmaxf(grid->cell_width, grid->cell_height);
+    float ratio = cell_size > current ? cell_size / current : current / cell_size;
+    return ratio > GRID_RETUNE_TOLERANCE;
 }
@@ -3,6 +3,8 @@
 
 #include "particle.h"
 #include "error.h"
+#include "arena.h"
+#include "thread_pool.h"
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -18,19 +20,34 @@
  * - Spatial grid: O(n) - 1000 particles ≈ 9,000 checks (with 10x10 grid)
  */
 
-/* Maximum particles per grid cell */
-#define GRID_MAX_PARTICLES_PER_CELL 64
+/* Particle slots reserved at creation when no capacity is given */
+#define GRID_DEFAULT_CAPACITY 1024
 
-/* Grid cell containing particle references */
-typedef struct {
-    Particle **particles;      /* Array of particle pointers */
-    int count;                 /* Number of particles in cell */
-    int capacity;              /* Allocated capacity */
-} GridCell;
+/* Below this many particles a parallel rebuild runs serially */
+#define GRID_PARALLEL_MIN_PARTICLES 16384
+
+/* Cell-size auto-tuning */
+#define GRID_TARGET_OCCUPANCY 4.0f     /* Particles per occupied cell to aim for */
+#define GRID_RETUNE_TOLERANCE 1.5f     /* Retune once the ideal size drifts by this factor */
 
-/* Spatial grid structure */
+/**
+ * Cells are stored in counting-sort (CSR) layout: every binned particle
+ * index lives in one array grouped by cell, and cell c owns
+ * indices[cell_start[c] .. cell_start[c] + cell_count[c]). Cells in one
+ * row are adjacent, so a 3x3 neighbourhood is three contiguous runs.
+ *
+ * Inserts only record (index, cell) and bump cell_count; the next query
+ * runs the counting sort once. spatial_grid_rebuild() bins a whole
+ * particle set and sorts it in one call.
+ *
+ * A grid built by spatial_grid_rebuild() also remembers each particle's
+ * cell and slot in indices, so spatial_grid_update() can migrate just the
+ * particles that crossed a cell border instead of re-sorting everyone.
+ *
+ * Every change to cell_count also updates occupancy[], the number of cells
+ * holding exactly n particles, so statistics never scan the cells.
+ */
 typedef struct {
-    GridCell *cells;           /* 2D array of cells (rows * cols) */
     int rows;                  /* Number of rows */
     int cols;                  /* Number of columns */
     float cell_width;          /* Width of each cell */
@@ -38,6 +55,21 @@ typedef struct {
     int world_width;           /* Total world width */
     int world_height;          /* Total world height */
     int total_particles;       /* Total particles in grid */
+
+    int *cell_start;           /* rows * cols + 1 offsets into indices */
+    int *cell_count;           /* Particles binned into each cell */
+    int *indices;              /* Particle indices grouped by cell */
+    int *entry_index;          /* Particle index of each insert, in insert order */
+    int *entry_cell;           /* Cell of each insert */
+    int *slot;                 /* Position of each particle in indices (tracked grids) */
+    int *movers;               /* Scratch list of particles that changed cell */
+    int *occupancy;            /* capacity + 1 levels: cells holding exactly n particles */
+    int max_occupancy;         /* Highest level with a cell in it */
+    int capacity;              /* Particles the arrays above can hold */
+    void *entry_block;         /* Heap block once the grid outgrows its creation block */
+    bool dirty;                /* Inserted since the last counting sort */
+    bool tracking;             /* Entry i is particle i and slot is valid */
+    int last_moved;            /* Particles migrated by the last update (-1 = full rebuild) */
 } SpatialGrid;
 
 /**
@@ -50,6 +82,13 @@ typedef struct {
  */
 SpatialGrid* spatial_grid_create(int world_width, int world_height, float cell_size);
 
+/**
+ * Create a spatial grid with room for max_particles in its single
+ * allocation, so binning never touches the heap
+ */
+SpatialGrid* spatial_grid_create_with_capacity(int world_width, int world_height,
+                                               float cell_size, int max_particles);
+
 /**
  * Destroy spatial grid and free memory
  */
@@ -60,14 +99,91 @@ void spatial_grid_destroy(SpatialGrid *grid);
  */
 void spatial_grid_clear(SpatialGrid *grid);
 
+/**
+ * Clear the grid and bin every particle with one counting-sort pass
+ *
+ * @param grid Spatial grid
+ * @param particles Particle columns; index i is particle i
+ * @return Error status
+ */
+Error spatial_grid_rebuild(SpatialGrid *grid, const ParticleSoA *particles);
+
+/**
+ * Rebuild with the counting sort split across a worker pool
+ *
+ * Each worker bins one block of particles into its own cell histogram;
+ * the histograms are folded into cell starts with a parallel exclusive
+ * prefix sum over ranges of cells, and each block then scatters into the
+ * index array at its own offsets. The layout is identical to
+ * spatial_grid_rebuild(), which runs instead when pool is NULL or
+ * single-threaded, arena is NULL, or there are fewer than
+ * GRID_PARALLEL_MIN_PARTICLES particles.
+ *
+ * @param grid Spatial grid
+ * @param particles Particle columns; index i is particle i
+ * @param pool Worker pool (NULL = serial)
+ * @param arena Scratch for workers x cells histogram entries
+ * @return Error status
+ */
+Error spatial_grid_rebuild_parallel(SpatialGrid *grid, const ParticleSoA *particles,
+                                    ThreadPool *pool, FrameArena *arena);
+
+/**
+ * Bring a grid built by spatial_grid_rebuild() up to date, moving only
+ * the particles whose cell changed
+ *
+ * Each move shifts one index per cell boundary between its old and new
+ * cell, so the cost follows the number of movers rather than the
+ * population. Falls back to a full rebuild when the grid was filled by
+ * inserts, the particle count changed, or the moves would cost more than
+ * re-sorting. grid->last_moved reports which path was taken.
+ *
+ * @param grid Spatial grid
+ * @param particles Particle columns; index i is particle i
+ * @return Error status
+ */
+Error spatial_grid_update(SpatialGrid *grid, const ParticleSoA *particles);
+
+/* spatial_grid_update() whose full-rebuild fallback is
+ * spatial_grid_rebuild_parallel() */
+Error spatial_grid_update_parallel(SpatialGrid *grid, const ParticleSoA *particles,
+                                   ThreadPool *pool, FrameArena *arena);
+
 /**
  * Insert particle into grid
  *
  * @param grid Spatial grid
- * @param particle Particle to insert
+ * @param index Particle index in the caller's particle columns
+ * @param x Particle X coordinate
+ * @param y Particle Y coordinate
  * @return Error status
  */
-Error spatial_grid_insert(SpatialGrid *grid, Particle *particle);
+Error spatial_grid_insert(SpatialGrid *grid, int index, float x, float y);
+
+/**
+ * Run any pending counting sort now; call before several threads read
+ * the grid, since the lazy sort on first query is not thread-safe
+ */
+void spatial_grid_finalize(SpatialGrid *grid);
+
+/**
+ * Get the contiguous index run of one cell
+ *
+ * @param grid Spatial grid
+ * @param col Column index
+ * @param row Row index
+ * @param count_out Number of particles in the cell
+ * @return Pointer into the grid's index array (NULL if out of bounds);
+ *         valid until the next insert, clear or rebuild
+ */
+const int *spatial_grid_cell_indices(SpatialGrid *grid, int col, int row, int *count_out);
+
+/**
+ * Get the contiguous index run of cells first_col..last_col in one row
+ * (columns are clamped to the grid; rows outside it give an empty run)
+ */
+const int *spatial_grid_row_indices(SpatialGrid *grid, int row, int first_col, int last_col,
+                                    int *count_out);
 
 /**
  * Get all particles in cell at world position
@@ -75,26 +191,114 @@ Error spatial_grid_insert(SpatialGrid *grid, Particle *particle);
  * @param grid Spatial grid
  * @param x World X coordinate
  * @param y World Y coordinate
- * @param particles_out Output array of particle pointers
+ * @param indices_out Output array of particle indices
  * @param max_particles Maximum particles to return
  * @return Number of particles found
  */
 int spatial_grid_get_cell(SpatialGrid *grid, float x, float y,
-                          Particle **particles_out, int max_particles);
+                          int *indices_out, int max_particles);
 
 /**
  * Query all particles within radius of point
  *
  * @param grid Spatial grid
+ * @param particles Particle columns the grid indices refer to
  * @param x Center X coordinate
  * @param y Center Y coordinate
  * @param radius Search radius
- * @param particles_out Output array of particle pointers
+ * @param indices_out Output array of particle indices
  * @param max_particles Maximum particles to return
  * @return Number of particles found
  */
-int spatial_grid_query_radius(SpatialGrid *grid, float x, float y, float radius,
-                              Particle **particles_out, int max_particles);
+int spatial_grid_query_radius(SpatialGrid *grid, const ParticleSoA *particles,
+                              float x, float y, float radius,
+                              int *indices_out, int max_particles);
+
+/**
+ * Distance filter kernel: appends to out each run[k] whose position
+ * (xs[k], ys[k]) lies within radius_sq of (cx, cy), in run order, and
+ * returns how many it appended. Every tier computes dx * dx + dy * dy
+ * without FMA, so all tiers agree with spatial_grid_query_radius().
+ */
+typedef int (*grid_radius_filter_func_t)(const float *xs, const float *ys, const int *run, int count,
+                                         float cx, float cy, float radius_sq, int *out);
+
+int spatial_grid_filter_scalar(const float *xs, const float *ys, const int *run, int count,
+                               float cx, float cy, float radius_sq, int *out);
+int spatial_grid_filter_sse(const float *xs, const float *ys, const int *run, int count,
+                            float cx, float cy, float radius_sq, int *out);
+int spatial_grid_filter_avx2(const float *xs, const float *ys, const int *run, int count,
+                             float cx, float cy, float radius_sq, int *out);
+int spatial_grid_filter_avx512(const float *xs, const float *ys, const int *run, int count,
+                               float cx, float cy, float radius_sq, int *out);
+
+/* Batched radius query results in CSR layout: query q matched
+ * indices[offsets[q] .. offsets[q + 1]). Reused across calls; buffers grow
+ * to the high-water mark. */
+typedef struct {
+    int *offsets;              /* num_queries + 1 offsets into indices */
+    int *indices;              /* Matches grouped by query */
+    int num_queries;           /* Queries in the last batch */
+    int query_capacity;        /* Queries the offsets array holds */
+    int *pair_query;           /* Scratch: query of each match, in cell order */
+    int *pair_index;           /* Scratch: particle of each match, in cell order */
+    int pair_capacity;         /* Matches the three match arrays hold */
+} GridQueryResults;
+
+void spatial_grid_query_results_init(GridQueryResults *results);
+void spatial_grid_query_results_free(GridQueryResults *results);
+
+/**
+ * Query many circles at once
+ *
+ * Queries are binned by the cells they overlap, so each cell's particles
+ * are gathered once per batch and tested against every query touching it
+ * with the dispatch table's filter kernel (4, 8 or 16 lanes). Matches of
+ * each query come out in the same order as spatial_grid_query_radius().
+ *
+ * @param grid Spatial grid
+ * @param particles Particle columns the grid indices refer to
+ * @param centers_x Query center X coordinates
+ * @param centers_y Query center Y coordinates
+ * @param radii Query radii (negative = no matches)
+ * @param num_queries Number of queries
+ * @param arena Scratch for the query bins and gathered positions
+ * @param results Output, initialized with spatial_grid_query_results_init()
+ * @return Error status
+ */
+Error spatial_grid_query_radius_batch(SpatialGrid *grid, const ParticleSoA *particles,
+                                      const float *centers_x, const float *centers_y,
+                                      const float *radii, int num_queries,
+                                      FrameArena *arena, GridQueryResults *results);
+
+/**
+ * Find the k particles nearest to a point
+ *
+ * Searches square rings of cells outward from the point's cell, keeping
+ * the best k in a bounded max-heap, and stops as soon as the heap is full
+ * and no unsearched cell can hold anything closer than its worst entry.
+ * Ties are broken by particle index, so results are deterministic.
+ *
+ * @param grid Spatial grid
+ * @param particles Particle columns the grid indices refer to
+ * @param x Query X coordinate
+ * @param y Query Y coordinate
+ * @param k Neighbours wanted
+ * @param indices_out k entries: nearest particles, closest first
+ * @param dist_sq_out k entries: their squared distances (also the heap)
+ * @return Number found (less than k only if the grid holds fewer particles)
+ */
+int spatial_grid_query_knn(SpatialGrid *grid, const ParticleSoA *particles,
+                           float x, float y, int k, int *indices_out, float *dist_sq_out);
+
+/**
+ * Run many kNN queries; query q writes k entries at indices_out + q * k and
+ * dist_sq_out + q * k, padding with index -1 when fewer than k exist.
+ * Queries are split across pool when one is given (NULL = this thread).
+ */
+Error spatial_grid_query_knn_batch(SpatialGrid *grid, const ParticleSoA *particles,
+                                   const float *centers_x, const float *centers_y, int num_queries,
+                                   int k, int *indices_out, float *dist_sq_out, ThreadPool *pool);
 
 /**
  * Get all particles in 3x3 neighborhood around point
@@ -103,12 +307,12 @@ int spatial_grid_query_radius(SpatialGrid *grid, float x, float y, float radius,
  * @param grid Spatial grid
  * @param x Center X coordinate
  * @param y Center Y coordinate
- * @param particles_out Output array of particle pointers
+ * @param indices_out Output array of particle indices
  * @param max_particles Maximum particles to return
  * @return Number of particles found
  */
 int spatial_grid_get_neighbors(SpatialGrid *grid, float x, float y,
-                               Particle **particles_out, int max_particles);
+                               int *indices_out, int max_particles);
 
 /**
  * Convert world coordinates to grid cell indices
@@ -125,6 +329,10 @@ bool spatial_grid_world_to_cell(SpatialGrid *grid, float x, float y,
 
 /**
  * Get statistics about grid usage
+ *
+ * Read from counters kept up to date by every insert, move and clear, so
+ * the cost does not depend on the number of cells (min is found by walking
+ * up the occupancy histogram from 1).
  */
 typedef struct {
     int total_cells;
@@ -138,4 +346,54 @@ typedef struct {
 
 void spatial_grid_get_stats(SpatialGrid *grid, GridStats *stats);
 
+/**
+ * Copy the occupancy histogram: counts_out[n] = cells holding exactly n
+ * particles, for n below max_levels
+ *
+ * @return Number of levels in use (max particles per cell + 1)
+ */
+int spatial_grid_get_occupancy_histogram(const SpatialGrid *grid, int *counts_out, int max_levels);
+
+/**
+ * Order particles along the Z-order (Morton) curve of their cells
+ *
+ * Keys interleave the bits of each particle's clamped (col, row), so
+ * particles in nearby cells get nearby keys; an LSD radix sort over the
+ * keys (8 bits a pass, skipping passes where every key shares the digit)
+ * keeps particles of one cell in their current order.
+ *
+ * @param grid Spatial grid giving the cell layout (its contents are not read)
+ * @param particles Particle columns to order
+ * @param arena Scratch memory for keys and the sort's ping-pong buffers
+ * @param order_out particles->count entries: order_out[k] is the index of
+ *                  the particle that belongs at position k
+ * @return Error status
+ */
+Error spatial_grid_morton_order(const SpatialGrid *grid, const ParticleSoA *particles,
+                                FrameArena *arena, int *order_out);
+
+/**
+ * Suggest a cell size from the occupancy of the grid as currently binned
+ *
+ * Scales the current size so occupied cells would average
+ * target_occupancy particles, never below the contact distance
+ * 2 * collision_radius (collision passes only look one cell away) and
+ * never above half the smaller world side. Cells holding one particle
+ * cannot tell how sparse the set is, so sparse sets grow over several
+ * calls (at most sqrt(target_occupancy) per call).
+ *
+ * @param grid Spatial grid holding the current particle set
+ * @param collision_radius Particle collision radius
+ * @param target_occupancy Particles per occupied cell (<= 0 = GRID_TARGET_OCCUPANCY)
+ * @return Suggested cell size (the current size if the grid is empty)
+ */
+float spatial_grid_tune_cell_size(SpatialGrid *grid, float collision_radius, float target_occupancy);
+
+/**
+ * Check whether the grid should be recreated with a suggested cell size:
+ * its cells are narrower than the contact distance, or the suggestion is
+ * more than GRID_RETUNE_TOLERANCE times larger or smaller
+ */
+bool spatial_grid_needs_retune(const SpatialGrid *grid, float cell_size, float collision_radius);
+
 #endif /* SPATIAL_GRID_H */
@@ -0,0 +1,430 @@
+#include "spatial_hash.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/* Helper: Mix cell coordinates into a table position */
+static inline uint32_t hash_key(int cx, int cy) {
+    uint32_t h = (uint32_t)cx * 0x9E3779B1u ^ (uint32_t)cy * 0x85EBCA77u;
+    return h ^ (h >> 16);
+}
+
+/* Helper: Cell coordinate along one axis, clamped so it fits an int */
+static inline int hash_coord(float v, float inv_cell_size) {
+    float c = floorf(v * inv_cell_size);
+    if (!(c > -SPATIAL_HASH_MAX_COORD)) c = -SPATIAL_HASH_MAX_COORD;  /* Also catches NaN */
+    if (c > SPATIAL_HASH_MAX_COORD) c = SPATIAL_HASH_MAX_COORD;
+    return (int)c;
+}
+
+/* Helper: Look up an occupied cell (-1 if empty) */
+static int hash_find(const SpatialHash *hash, int cx, int cy) {
+    uint32_t slot = hash_key(cx, cy) & (uint32_t)hash->slot_mask;
+    for (;;) {
+        int cell = hash->slots[slot];
+        if (cell < 0) {
+            return -1;
+        }
+        if (hash->cells[cell].cx == cx && hash->cells[cell].cy == cy) {
+            return cell;
+        }
+        slot = (slot + 1) & (uint32_t)hash->slot_mask;
+    }
+}
+
+/* Helper: Place a cell number in the first free slot of its probe chain */
+static void hash_place(SpatialHash *hash, int cell) {
+    uint32_t slot = hash_key(hash->cells[cell].cx, hash->cells[cell].cy) & (uint32_t)hash->slot_mask;
+    while (hash->slots[slot] >= 0) {
+        slot = (slot + 1) & (uint32_t)hash->slot_mask;
+    }
+    hash->slots[slot] = cell;
+}
+
+/* Helper: Double the table and re-place every occupied cell */
+static bool hash_grow_table(SpatialHash *hash) {
+    int new_size = (hash->slot_mask + 1) * 2;
+    int *slots = malloc(sizeof(int) * (size_t)new_size);
+    if (!slots) {
+        return false;
+    }
+    memset(slots, 0xff, sizeof(int) * (size_t)new_size);
+
+    free(hash->slots);
+    hash->slots = slots;
+    hash->slot_mask = new_size - 1;
+    for (int c = 0; c < hash->num_cells; c++) {
+        hash_place(hash, c);
+    }
+    return true;
+}
+
+/* Helper: Find a cell, creating it if absent (-1 on allocation failure) */
+static int hash_find_or_add(SpatialHash *hash, int cx, int cy) {
+    int cell = hash_find(hash, cx, cy);
+    if (cell >= 0) {
+        return cell;
+    }
+
+    /* Keep the table at most half full so probe chains stay short */
+    if ((hash->num_cells + 1) * 2 > hash->slot_mask + 1 && !hash_grow_table(hash)) {
+        return -1;
+    }
+
+    if (hash->num_cells >= hash->cell_capacity) {
+        int new_capacity = hash->cell_capacity > 0 ? hash->cell_capacity * 2 : SPATIAL_HASH_MIN_SLOTS / 2;
+        SpatialHashCell *cells = realloc(hash->cells, sizeof(SpatialHashCell) * (size_t)new_capacity);
+        if (!cells) {
+            return -1;
+        }
+        hash->cells = cells;
+        hash->cell_capacity = new_capacity;
+    }
+
+    cell = hash->num_cells++;
+    hash->cells[cell] = (SpatialHashCell){ cx, cy, 0, 0 };
+    hash_place(hash, cell);
+    return cell;
+}
+
+/* Helper: Make room for at least needed particles (keeps inserted entries) */
+static Error hash_reserve(SpatialHash *hash, int needed) {
+    if (needed <= hash->capacity) {
+        return (Error){SUCCESS};
+    }
+
+    int new_capacity = hash->capacity > 0 ? hash->capacity : GRID_DEFAULT_CAPACITY;
+    while (new_capacity < needed) {
+        new_capacity *= 2;
+    }
+
+    int *indices = malloc(sizeof(int) * (size_t)new_capacity);
+    int *entry_index = malloc(sizeof(int) * (size_t)new_capacity);
+    int *entry_cell = malloc(sizeof(int) * (size_t)new_capacity);
+    if (!indices || !entry_index || !entry_cell) {
+        free(indices);
+        free(entry_index);
+        free(entry_cell);
+        return ERROR_CREATE(ERROR_MEMORY_ALLOCATION, "Failed to expand spatial hash");
+    }
+    memcpy(entry_index, hash->entry_index, sizeof(int) * hash->total_particles);
+    memcpy(entry_cell, hash->entry_cell, sizeof(int) * hash->total_particles);
+
+    free(hash->indices);
+    free(hash->entry_index);
+    free(hash->entry_cell);
+    hash->indices = indices;
+    hash->entry_index = entry_index;
+    hash->entry_cell = entry_cell;
+    hash->capacity = new_capacity;
+    hash->dirty = true;
+    return (Error){SUCCESS};
+}
+
+/* Helper: Counting sort of the inserted entries into cell runs */
+static void hash_sort(SpatialHash *hash) {
+    int running = 0;
+    for (int c = 0; c < hash->num_cells; c++) {
+        hash->cells[c].start = running;
+        running += hash->cells[c].count;
+    }
+
+    /* Scatter in insert order so each cell keeps insertion order; start
+     * is walked to the end of its run and wound back afterwards */
+    for (int e = 0; e < hash->total_particles; e++) {
+        SpatialHashCell *cell = &hash->cells[hash->entry_cell[e]];
+        hash->indices[cell->start++] = hash->entry_index[e];
+    }
+    for (int c = 0; c < hash->num_cells; c++) {
+        hash->cells[c].start -= hash->cells[c].count;
+    }
+
+    hash->dirty = false;
+}
+
+/* Helper: Sort pending inserts before reading cells */
+static inline void hash_ensure_sorted(SpatialHash *hash) {
+    if (hash->dirty) {
+        hash_sort(hash);
+    }
+}
+
+/* Helper: Copy a run into the output, stopping at max_particles */
+static inline int hash_copy_run(const int *run, int count, int *indices_out, int total, int max_particles) {
+    int room = max_particles - total;
+    int n = count < room ? count : room;
+    memcpy(indices_out + total, run, sizeof(int) * (size_t)n);
+    return total + n;
+}
+
+/* Helper: Append the particles of one cell that lie within the radius */
+static inline int hash_filter_run(const SpatialHash *hash, const SpatialHashCell *cell,
+                                  const ParticleSoA *particles, float x, float y, float radius_sq,
+                                  int *indices_out, int total, int max_particles) {
+    const int *run = hash->indices + cell->start;
+    for (int k = 0; k < cell->count && total < max_particles; k++) {
+        int index = run[k];
+        float dx = particles->x[index] - x;
+        float dy = particles->y[index] - y;
+        if (dx * dx + dy * dy <= radius_sq) {
+            indices_out[total++] = index;
+        }
+    }
+    return total;
+}
+
+/* Create spatial hash */
+SpatialHash *spatial_hash_create(float cell_size, int max_particles) {
+    if (!(cell_size > 0.0f) || max_particles < 0) {
+        return NULL;
+    }
+
+    SpatialHash *hash = calloc(1, sizeof(SpatialHash));
+    if (!hash) return NULL;
+
+    hash->cell_size = cell_size;
+    hash->inv_cell_size = 1.0f / cell_size;
+
+    hash->slots = malloc(sizeof(int) * SPATIAL_HASH_MIN_SLOTS);
+    if (!hash->slots || hash_reserve(hash, max_particles > 0 ? max_particles : 1).code != SUCCESS) {
+        spatial_hash_destroy(hash);
+        return NULL;
+    }
+    hash->slot_mask = SPATIAL_HASH_MIN_SLOTS - 1;
+    memset(hash->slots, 0xff, sizeof(int) * SPATIAL_HASH_MIN_SLOTS);
+    hash->dirty = false;
+
+    return hash;
+}
+
+/* Destroy spatial hash */
+void spatial_hash_destroy(SpatialHash *hash) {
+    if (!hash) return;
+
+    free(hash->slots);
+    free(hash->cells);
+    free(hash->indices);
+    free(hash->entry_index);
+    free(hash->entry_cell);
+    free(hash);
+}
+
+/* Remove every particle and cell */
+void spatial_hash_clear(SpatialHash *hash) {
+    if (!hash) return;
+
+    memset(hash->slots, 0xff, sizeof(int) * ((size_t)hash->slot_mask + 1));
+    hash->num_cells = 0;
+    hash->total_particles = 0;
+    hash->dirty = false;
+}
+
+/* Bin every particle with one counting-sort pass */
+Error spatial_hash_rebuild(SpatialHash *hash, const ParticleSoA *particles) {
+    ERROR_CHECK_NULL(hash, "Spatial hash");
+    ERROR_CHECK_NULL(particles, "Particle columns");
+
+    spatial_hash_clear(hash);
+
+    Error err = hash_reserve(hash, particles->count);
+    if (err.code != SUCCESS) {
+        return err;
+    }
+
+    for (int i = 0; i < particles->count; i++) {
+        int cell = hash_find_or_add(hash,
+                                    hash_coord(particles->x[i], hash->inv_cell_size),
+                                    hash_coord(particles->y[i], hash->inv_cell_size));
+        if (cell < 0) {
+            spatial_hash_clear(hash);
+            return ERROR_CREATE(ERROR_MEMORY_ALLOCATION, "Failed to expand spatial hash");
+        }
+        hash->entry_index[i] = i;
+        hash->entry_cell[i] = cell;
+        hash->cells[cell].count++;
+    }
+    hash->total_particles = particles->count;
+
+    hash_sort(hash);
+    return (Error){SUCCESS};
+}
+
+/* Insert particle into hash (sorted lazily on the next query) */
+Error spatial_hash_insert(SpatialHash *hash, int index, float x, float y) {
+    ERROR_CHECK_NULL(hash, "Spatial hash");
+    ERROR_CHECK_CONDITION(index >= 0, ERROR_INVALID_PARAMETER, "Particle index must be non-negative");
+
+    Error err = hash_reserve(hash, hash->total_particles + 1);
+    if (err.code != SUCCESS) {
+        return err;
+    }
+
+    int cell = hash_find_or_add(hash, hash_coord(x, hash->inv_cell_size),
+                                hash_coord(y, hash->inv_cell_size));
+    if (cell < 0) {
+        return ERROR_CREATE(ERROR_MEMORY_ALLOCATION, "Failed to expand spatial hash");
+    }
+
+    hash->entry_index[hash->total_particles] = index;
+    hash->entry_cell[hash->total_particles] = cell;
+    hash->total_particles++;
+    hash->cells[cell].count++;
+    hash->dirty = true;
+
+    return (Error){SUCCESS};
+}
+
+/* Run any pending counting sort */
+void spatial_hash_finalize(SpatialHash *hash) {
+    if (hash) {
+        hash_ensure_sorted(hash);
+    }
+}
+
+/* Convert world coordinates to cell coordinates */
+void spatial_hash_world_to_cell(const SpatialHash *hash, float x, float y,
+                                int *cx_out, int *cy_out) {
+    if (!hash) return;
+
+    if (cx_out) *cx_out = hash_coord(x, hash->inv_cell_size);
+    if (cy_out) *cy_out = hash_coord(y, hash->inv_cell_size);
+}
+
+/* Get the contiguous index run of one cell */
+const int *spatial_hash_cell_indices(SpatialHash *hash, int cx, int cy, int *count_out) {
+    if (count_out) *count_out = 0;
+    if (!hash) return NULL;
+
+    int cell = hash_find(hash, cx, cy);
+    if (cell < 0) return NULL;
+
+    hash_ensure_sorted(hash);
+    if (count_out) *count_out = hash->cells[cell].count;
+    return hash->indices + hash->cells[cell].start;
+}
+
+/* Get particles in specific cell */
+int spatial_hash_get_cell(SpatialHash *hash, float x, float y,
+                          int *indices_out, int max_particles) {
+    if (!hash || !indices_out) return 0;
+
+    int cx, cy, count;
+    spatial_hash_world_to_cell(hash, x, y, &cx, &cy);
+    const int *run = spatial_hash_cell_indices(hash, cx, cy, &count);
+    if (!run) return 0;
+
+    return hash_copy_run(run, count, indices_out, 0, max_particles);
+}
+
+/* Get particles in 3x3 neighborhood */
+int spatial_hash_get_neighbors(SpatialHash *hash, float x, float y,
+                               int *indices_out, int max_particles) {
+    if (!hash || !indices_out) return 0;
+
+    hash_ensure_sorted(hash);
+
+    int cx, cy;
+    spatial_hash_world_to_cell(hash, x, y, &cx, &cy);
+    int total = 0;
+
+    for (int dy = -1; dy <= 1; dy++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            int cell = hash_find(hash, cx + dx, cy + dy);
+            if (cell < 0) continue;
+
+            total = hash_copy_run(hash->indices + hash->cells[cell].start, hash->cells[cell].count,
+                                  indices_out, total, max_particles);
+            if (total >= max_particles) {
+                return total;
+            }
+        }
+    }
+
+    return total;
+}
+
+/* Query particles within radius */
+int spatial_hash_query_radius(SpatialHash *hash, const ParticleSoA *particles,
+                              float x, float y, float radius,
+                              int *indices_out, int max_particles) {
+    if (!hash || !particles || !indices_out || radius < 0.0f) return 0;
+
+    hash_ensure_sorted(hash);
+
+    int cx0 = hash_coord(x - radius, hash->inv_cell_size);
+    int cx1 = hash_coord(x + radius, hash->inv_cell_size);
+    int cy0 = hash_coord(y - radius, hash->inv_cell_size);
+    int cy1 = hash_coord(y + radius, hash->inv_cell_size);
+    float radius_sq = radius * radius;
+    int total = 0;
+
+    /* Huge radii: fewer occupied cells than cells in the search square */
+    if ((long long)(cx1 - cx0 + 1) * (cy1 - cy0 + 1) > hash->num_cells) {
+        for (int c = 0; c < hash->num_cells && total < max_particles; c++) {
+            const SpatialHashCell *cell = &hash->cells[c];
+            if (cell->cx < cx0 || cell->cx > cx1 || cell->cy < cy0 || cell->cy > cy1) continue;
+            total = hash_filter_run(hash, cell, particles, x, y, radius_sq,
+                                    indices_out, total, max_particles);
+        }
+        return total;
+    }
+
+    for (int row = cy0; row <= cy1; row++) {
+        for (int col = cx0; col <= cx1; col++) {
+            int cell = hash_find(hash, col, row);
+            if (cell < 0) continue;
+
+            total = hash_filter_run(hash, &hash->cells[cell], particles, x, y, radius_sq,
+                                    indices_out, total, max_particles);
+            if (total >= max_particles) {
+                return total;
+            }
+        }
+    }
+
+    return total;
+}
+
+/* Get hash statistics */
+void spatial_hash_get_stats(SpatialHash *hash, GridStats *stats) {
+    if (!hash || !stats) return;
+
+    memset(stats, 0, sizeof(GridStats));
+
+    stats->total_cells = hash->slot_mask + 1;
+    stats->occupied_cells = hash->num_cells;
+    stats->empty_cells = stats->total_cells - stats->occupied_cells;
+    stats->total_particles = hash->total_particles;
+    stats->min_particles_per_cell = hash->num_cells > 0 ? INT32_MAX : 0;
+
+    for (int c = 0; c < hash->num_cells; c++) {
+        int count = hash->cells[c].count;
+        if (count < stats->min_particles_per_cell) {
+            stats->min_particles_per_cell = count;
+        }
+        if (count > stats->max_particles_per_cell) {
+            stats->max_particles_per_cell = count;
+        }
+    }
+
+    if (hash->num_cells > 0) {
+        stats->avg_particles_per_cell = (float)hash->total_particles / hash->num_cells;
+    }
+}
+
+/* ===== ERROR-AWARE SPATIAL HASH FUNCTIONS ===== */
+
+/* Create a spatial hash with error handling */
+Error spatial_hash_create_with_error(float cell_size, int max_particles, SpatialHash **hash_out) {
+    ERROR_CHECK_NULL(hash_out, "Spatial hash output pointer");
+    ERROR_CHECK_CONDITION(cell_size > 0.0f, ERROR_INVALID_PARAMETER, "Cell size must be positive");
+    ERROR_CHECK_CONDITION(max_particles >= 0, ERROR_INVALID_PARAMETER, "Capacity must be non-negative");
+
+    SpatialHash *hash = spatial_hash_create(cell_size, max_particles);
+    if (!hash) {
+        return ERROR_CREATE(ERROR_MEMORY_ALLOCATION, "Failed to allocate spatial hash");
+    }
+
+    *hash_out = hash;
+    return (Error){SUCCESS, NULL, NULL, 0, NULL};
+}
@@ -0,0 +1,147 @@
+#ifndef SPATIAL_HASH_H
+#define SPATIAL_HASH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "particle.h"
+#include "error.h"
+#include "spatial_grid.h"
+
+/**
+ * Sparse Spatial Hash
+ *
+ * A spatial grid without world bounds: only occupied cells exist. Cells
+ * are keyed on their unbounded (cell_x, cell_y) coordinates in an
+ * open-addressing table, so memory follows the number of occupied cells
+ * rather than the world area, and particles far outside the terminal keep
+ * their own cells instead of piling up in clamped edge cells.
+ *
+ * Occupied cells are numbered densely in the order they first appear and
+ * their particles are stored in counting-sort (CSR) layout, as in
+ * SpatialGrid: cell c owns indices[cells[c].start .. + cells[c].count).
+ * Inserts are sorted lazily on the next query.
+ */
+
+/* Table slots reserved at creation (rounded up to a power of two) */
+#define SPATIAL_HASH_MIN_SLOTS 64
+
+/* Largest cell coordinate magnitude; positions beyond it share edge cells */
+#define SPATIAL_HASH_MAX_COORD (1 << 29)
+
+/* One occupied cell */
+typedef struct {
+    int cx, cy;                /* Cell coordinates */
+    int start;                 /* Offset of the cell's run in indices */
+    int count;                 /* Particles in the cell */
+} SpatialHashCell;
+
+/* Spatial hash */
+typedef struct {
+    float cell_size;           /* Width and height of each cell */
+    float inv_cell_size;       /* 1 / cell_size */
+
+    int *slots;                /* Open-addressing table of cell numbers (-1 = empty) */
+    int slot_mask;             /* Table size - 1 (size is a power of two) */
+
+    SpatialHashCell *cells;    /* Occupied cells, densely numbered */
+    int num_cells;             /* Occupied cells */
+    int cell_capacity;         /* Cells the array holds */
+
+    int *indices;              /* Particle indices grouped by cell */
+    int *entry_index;          /* Particle index of each insert, in insert order */
+    int *entry_cell;           /* Cell number of each insert */
+    int total_particles;       /* Total particles in the hash */
+    int capacity;              /* Particles the arrays above hold */
+    bool dirty;                /* Inserted since the last counting sort */
+} SpatialHash;
+
+/**
+ * Create a spatial hash
+ *
+ * @param cell_size Cell width and height in simulation units
+ * @param max_particles Particles to reserve room for (grows as needed)
+ * @return New spatial hash or NULL on error
+ */
+SpatialHash *spatial_hash_create(float cell_size, int max_particles);
+
+/**
+ * Destroy spatial hash and free memory
+ */
+void spatial_hash_destroy(SpatialHash *hash);
+
+/**
+ * Remove every particle and cell (keeps the allocated memory)
+ */
+void spatial_hash_clear(SpatialHash *hash);
+
+/**
+ * Clear the hash and bin every particle with one counting-sort pass
+ *
+ * @param hash Spatial hash
+ * @param particles Particle columns; index i is particle i
+ * @return Error status
+ */
+Error spatial_hash_rebuild(SpatialHash *hash, const ParticleSoA *particles);
+
+/**
+ * Insert particle into hash (sorted lazily on the next query)
+ *
+ * @param hash Spatial hash
+ * @param index Particle index in the caller's particle columns
+ * @param x Particle X coordinate
+ * @param y Particle Y coordinate
+ * @return Error status
+ */
+Error spatial_hash_insert(SpatialHash *hash, int index, float x, float y);
+
+/**
+ * Run any pending counting sort now; call before several threads read
+ * the hash, since the lazy sort on first query is not thread-safe
+ */
+void spatial_hash_finalize(SpatialHash *hash);
+
+/**
+ * Convert world coordinates to (unbounded) cell coordinates
+ */
+void spatial_hash_world_to_cell(const SpatialHash *hash, float x, float y,
+                                int *cx_out, int *cy_out);
+
+/**
+ * Get the contiguous index run of one cell
+ *
+ * @return Pointer into the hash's index array (NULL if the cell is empty);
+ *         valid until the next insert, clear or rebuild
+ */
+const int *spatial_hash_cell_indices(SpatialHash *hash, int cx, int cy, int *count_out);
+
+/**
+ * Get all particles in cell at world position
+ */
+int spatial_hash_get_cell(SpatialHash *hash, float x, float y,
+                          int *indices_out, int max_particles);
+
+/**
+ * Get all particles in 3x3 neighborhood around point
+ */
+int spatial_hash_get_neighbors(SpatialHash *hash, float x, float y,
+                               int *indices_out, int max_particles);
+
+/**
+ * Query all particles within radius of point
+ *
+ * Small radii probe each cell of the search square; radii whose square
+ * covers more cells than are occupied walk the occupied cells instead.
+ */
+int spatial_hash_query_radius(SpatialHash *hash, const ParticleSoA *particles,
+                              float x, float y, float radius,
+                              int *indices_out, int max_particles);
+
+/**
+ * Get statistics about hash usage (total_cells = table slots)
+ */
+void spatial_hash_get_stats(SpatialHash *hash, GridStats *stats);
+
+/* Error-aware spatial hash functions */
+Error spatial_hash_create_with_error(float cell_size, int max_particles, SpatialHash **hash_out);
+
+#endif /* SPATIAL_HASH_H */
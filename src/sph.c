@@ -0,0 +1,315 @@
+#include "sph.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/* Helper: Make room for count particles (contents are rebuilt every pass) */
+static bool sph_reserve(SPHSolver *solver, int count) {
+    if (count <= solver->capacity) {
+        return true;
+    }
+
+    int new_capacity = solver->capacity > 0 ? solver->capacity : 1024;
+    while (new_capacity < count) {
+        new_capacity *= 2;
+    }
+
+    /* Seven float columns in one block */
+    float *block = malloc(sizeof(float) * 7 * (size_t)new_capacity);
+    if (!block) {
+        return false;
+    }
+
+    free(solver->sorted_x);
+    size_t n = (size_t)new_capacity;
+    solver->sorted_x = block;
+    solver->sorted_y = block + n;
+    solver->sorted_vx = block + 2 * n;
+    solver->sorted_vy = block + 3 * n;
+    solver->sorted_density = block + 4 * n;
+    solver->sorted_pressure = block + 5 * n;
+    solver->density = block + 6 * n;
+    solver->capacity = new_capacity;
+    return true;
+}
+
+/* Helper: Check settings are usable */
+static bool sph_settings_valid(const SPHSettings *settings) {
+    return settings->smoothing_radius > 0.0f && isfinite(settings->smoothing_radius) &&
+           settings->particle_mass > 0.0f && settings->rest_density >= 0.0f &&
+           settings->stiffness >= 0.0f && settings->viscosity >= 0.0f;
+}
+
+/* Kernel constants for a support radius and particle mass */
+SPHKernel sph_make_kernel(float smoothing_radius, float particle_mass) {
+    double h = smoothing_radius;
+    SPHKernel kernel;
+    kernel.h = smoothing_radius;
+    kernel.h_sq = smoothing_radius * smoothing_radius;
+    kernel.poly6 = (float)(4.0 / (M_PI * pow(h, 8)));
+    kernel.spiky_grad = (float)(-30.0 / (M_PI * pow(h, 5)));
+    kernel.visc_lap = (float)(40.0 / (M_PI * pow(h, 5)));
+    kernel.mass_poly6 = particle_mass * kernel.poly6;
+    return kernel;
+}
+
+/* Create a solver with a grid whose cells are at least h wide where the
+ * world allows, so neighbours are one cell away */
+SPHSolver *sph_create(int world_width, int world_height, const SPHSettings *settings, int capacity) {
+    SPHSettings chosen = settings ? *settings : sph_default_settings();
+    if (world_width <= 0 || world_height <= 0 || capacity < 0 || !sph_settings_valid(&chosen)) {
+        return NULL;
+    }
+
+    SPHSolver *solver = calloc(1, sizeof(SPHSolver));
+    if (!solver) {
+        return NULL;
+    }
+    solver->settings = chosen;
+    solver->kernel = sph_make_kernel(chosen.smoothing_radius, chosen.particle_mass);
+
+    float h = chosen.smoothing_radius;
+    float cols = floorf((float)world_width / h);
+    float rows = floorf((float)world_height / h);
+    float cell_size = fmaxf(cols >= 1.0f ? (float)world_width / cols : h,
+                            rows >= 1.0f ? (float)world_height / rows : h);
+    solver->grid = spatial_grid_create_with_capacity(world_width, world_height, cell_size, capacity);
+    if (!solver->grid || (capacity > 0 && !sph_reserve(solver, capacity))) {
+        sph_destroy(solver);
+        return NULL;
+    }
+    solver->reach_cols = (int)ceilf(h / solver->grid->cell_width);
+    solver->reach_rows = (int)ceilf(h / solver->grid->cell_height);
+    return solver;
+}
+
+/* Destroy a solver, its grid and its columns */
+void sph_destroy(SPHSolver *solver) {
+    if (!solver) return;
+
+    spatial_grid_destroy(solver->grid);
+    free(solver->sorted_x);
+    free(solver);
+}
+
+/* ===== DENSITY AND FORCE PASSES ===== */
+
+/* Shared state for one pass over the grid rows */
+typedef struct {
+    SPHSolver *solver;
+    const ParticleSoA *particles;
+    ParticleSoA *out;          /* Force pass: velocities to kick */
+    float dt;
+    uint64_t neighbors;        /* Density pass: neighbours found */
+} SPHPassJob;
+
+/* Helper: Columns and rows of cells holding a cell's neighbours */
+static inline void sph_neighbor_span(const SPHSolver *solver, int col, int row,
+                                     int *first_col, int *last_col, int *first_row, int *last_row) {
+    const SpatialGrid *grid = solver->grid;
+    *first_col = col - solver->reach_cols > 0 ? col - solver->reach_cols : 0;
+    *last_col = col + solver->reach_cols < grid->cols - 1 ? col + solver->reach_cols : grid->cols - 1;
+    *first_row = row - solver->reach_rows > 0 ? row - solver->reach_rows : 0;
+    *last_row = row + solver->reach_rows < grid->rows - 1 ? row + solver->reach_rows : grid->rows - 1;
+}
+
+/* Copy positions and velocities into cell order */
+static void sph_gather_chunk(void *ctx, int begin, int end, int worker_id) {
+    SPHPassJob *job = (SPHPassJob *)ctx;
+    SPHSolver *solver = job->solver;
+    const ParticleSoA *particles = job->particles;
+    const int *indices = solver->grid->indices;
+    (void)worker_id;
+
+    for (int k = begin; k < end; k++) {
+        int i = indices[k];
+        solver->sorted_x[k] = particles->x[i];
+        solver->sorted_y[k] = particles->y[i];
+        solver->sorted_vx[k] = particles->vx[i];
+        solver->sorted_vy[k] = particles->vy[i];
+    }
+}
+
+/* Density and pressure of every particle in a range of grid rows */
+static void sph_density_rows(void *ctx, int begin, int end, int worker_id) {
+    SPHPassJob *job = (SPHPassJob *)ctx;
+    SPHSolver *solver = job->solver;
+    const SpatialGrid *grid = solver->grid;
+    const SPHKernel *kernel = &solver->kernel;
+    const SPHSettings *settings = &solver->settings;
+    const float *sx = solver->sorted_x, *sy = solver->sorted_y;
+    const int *cell_start = grid->cell_start;
+    uint64_t neighbors = 0;
+    (void)worker_id;
+
+    for (int row = begin; row < end; row++) {
+        for (int col = 0; col < grid->cols; col++) {
+            int cell = row * grid->cols + col;
+            int first_col, last_col, first_row, last_row;
+            sph_neighbor_span(solver, col, row, &first_col, &last_col, &first_row, &last_row);
+
+            for (int k = cell_start[cell]; k < cell_start[cell + 1]; k++) {
+                const float xk = sx[k], yk = sy[k];
+                float sum = 0.0f;
+                int found = 0;
+
+                /* Each neighbour row is one contiguous run of the sorted columns */
+                for (int r = first_row; r <= last_row; r++) {
+                    int run_end = cell_start[r * grid->cols + last_col + 1];
+                    for (int j = cell_start[r * grid->cols + first_col]; j < run_end; j++) {
+                        float dx = sx[j] - xk;
+                        float dy = sy[j] - yk;
+                        float t = kernel->h_sq - (dx * dx + dy * dy);
+                        t = t > 0.0f ? t : 0.0f;
+                        found += t > 0.0f;
+                        sum += t * t * t;
+                    }
+                }
+
+                float density = kernel->mass_poly6 * sum;
+                float pressure = settings->stiffness * (density - settings->rest_density);
+                solver->sorted_density[k] = density;
+                solver->sorted_pressure[k] = pressure > 0.0f ? pressure : 0.0f;
+                solver->density[grid->indices[k]] = density;
+                neighbors += (uint64_t)found;
+            }
+        }
+    }
+    __atomic_fetch_add(&job->neighbors, neighbors, __ATOMIC_RELAXED);
+}
+
+/* Pressure and viscosity acceleration of every particle in a range of grid rows */
+static void sph_force_rows(void *ctx, int begin, int end, int worker_id) {
+    SPHPassJob *job = (SPHPassJob *)ctx;
+    SPHSolver *solver = job->solver;
+    const SpatialGrid *grid = solver->grid;
+    const SPHKernel *kernel = &solver->kernel;
+    const float *sx = solver->sorted_x, *sy = solver->sorted_y;
+    const float *svx = solver->sorted_vx, *svy = solver->sorted_vy;
+    const float *density = solver->sorted_density, *pressure = solver->sorted_pressure;
+    const int *cell_start = grid->cell_start;
+    (void)worker_id;
+
+    /* -m / 2 * grad constant, and m * mu * Laplacian constant */
+    const float pressure_scale = -0.5f * solver->settings.particle_mass * kernel->spiky_grad;
+    const float viscosity_scale = solver->settings.particle_mass * solver->settings.viscosity *
+                                  kernel->visc_lap;
+
+    for (int row = begin; row < end; row++) {
+        for (int col = 0; col < grid->cols; col++) {
+            int cell = row * grid->cols + col;
+            int first_col, last_col, first_row, last_row;
+            sph_neighbor_span(solver, col, row, &first_col, &last_col, &first_row, &last_row);
+
+            for (int k = cell_start[cell]; k < cell_start[cell + 1]; k++) {
+                const float xk = sx[k], yk = sy[k];
+                const float vxk = svx[k], vyk = svy[k], pk = pressure[k];
+                float ax = 0.0f, ay = 0.0f;
+
+                for (int r = first_row; r <= last_row; r++) {
+                    int run_end = cell_start[r * grid->cols + last_col + 1];
+                    for (int j = cell_start[r * grid->cols + first_col]; j < run_end; j++) {
+                        float dx = xk - sx[j];
+                        float dy = yk - sy[j];
+                        float dist = sqrtf(dx * dx + dy * dy);
+                        float w = kernel->h - dist;
+                        w = w > 0.0f ? w : 0.0f;
+
+                        /* Coincident pairs (and the particle itself) push nowhere */
+                        float inv_dist = dist > 0.0f ? 1.0f / dist : 0.0f;
+                        float inv_rho = 1.0f / density[j];
+                        float push = pressure_scale * (pk + pressure[j]) * inv_rho * w * w * inv_dist;
+                        float drag = viscosity_scale * inv_rho * w;
+                        ax += push * dx + drag * (svx[j] - vxk);
+                        ay += push * dy + drag * (svy[j] - vyk);
+                    }
+                }
+
+                int i = grid->indices[k];
+                float scale = job->dt / density[k];
+                job->out->vx[i] += ax * scale;
+                job->out->vy[i] += ay * scale;
+            }
+        }
+    }
+}
+
+/* Bin, reorder and compute densities */
+Error sph_compute_density(SPHSolver *solver, const ParticleSoA *particles,
+                          ThreadPool *pool, FrameArena *arena) {
+    ERROR_CHECK_NULL(solver, "SPH solver");
+    ERROR_CHECK_NULL(particles, "Particle columns");
+
+    if (!sph_reserve(solver, particles->count)) {
+        return ERROR_CREATE(ERROR_MEMORY_ALLOCATION, "Failed to expand SPH solver");
+    }
+    if (particles->count < SPH_PARALLEL_MIN_PARTICLES) {
+        pool = NULL;
+    }
+
+    Error err = spatial_grid_update_parallel(solver->grid, particles, pool, arena);
+    if (err.code != SUCCESS) {
+        return err;
+    }
+    spatial_grid_finalize(solver->grid);
+
+    SPHPassJob job = { solver, particles, NULL, 0.0f, 0 };
+    thread_pool_parallel_for(pool, particles->count, 4096, sph_gather_chunk, &job);
+    thread_pool_parallel_for(pool, solver->grid->rows, 1, sph_density_rows, &job);
+
+    solver->count = particles->count;
+    solver->stats.steps++;
+    solver->stats.neighbors = job.neighbors;
+    return (Error){SUCCESS};
+}
+
+/* Kick velocities with pressure and viscosity */
+Error sph_apply_forces(SPHSolver *solver, ParticleSoA *particles, float dt, ThreadPool *pool) {
+    ERROR_CHECK_NULL(solver, "SPH solver");
+    ERROR_CHECK_NULL(particles, "Particle columns");
+    ERROR_CHECK_CONDITION(particles->count == solver->count, ERROR_INVALID_PARAMETER,
+                          "Densities were computed for a different particle set");
+
+    if (particles->count < SPH_PARALLEL_MIN_PARTICLES) {
+        pool = NULL;
+    }
+
+    SPHPassJob job = { solver, particles, particles, dt, 0 };
+    thread_pool_parallel_for(pool, solver->grid->rows, 1, sph_force_rows, &job);
+    return (Error){SUCCESS};
+}
+
+/* One full SPH pass */
+Error sph_step(SPHSolver *solver, ParticleSoA *particles, float dt,
+               ThreadPool *pool, FrameArena *arena) {
+    Error err = sph_compute_density(solver, particles, pool, arena);
+    if (err.code != SUCCESS) {
+        return err;
+    }
+    return sph_apply_forces(solver, particles, dt, pool);
+}
+
+/* ===== ERROR-AWARE SPH FUNCTIONS ===== */
+
+/* Create a solver with error handling */
+Error sph_create_with_error(int world_width, int world_height, const SPHSettings *settings,
+                            int capacity, SPHSolver **solver_out) {
+    ERROR_CHECK_NULL(solver_out, "SPH solver output pointer");
+    ERROR_CHECK_CONDITION(world_width > 0 && world_height > 0, ERROR_INVALID_PARAMETER,
+                          "World dimensions must be positive");
+    ERROR_CHECK_CONDITION(capacity >= 0, ERROR_INVALID_PARAMETER, "Capacity must be non-negative");
+    ERROR_CHECK_CONDITION(!settings || sph_settings_valid(settings), ERROR_INVALID_PARAMETER,
+                          "SPH settings out of range");
+
+    SPHSolver *solver = sph_create(world_width, world_height, settings, capacity);
+    if (!solver) {
+        return ERROR_CREATE(ERROR_MEMORY_ALLOCATION, "Failed to allocate SPH solver");
+    }
+
+    *solver_out = solver;
+    return (Error){SUCCESS, NULL, NULL, 0, NULL};
+}
@@ -0,0 +1,137 @@
+#ifndef SPH_H
+#define SPH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "particle.h"
+#include "error.h"
+#include "spatial_grid.h"
+#include "thread_pool.h"
+#include "arena.h"
+
+/**
+ * Smoothed-Particle Hydrodynamics
+ *
+ * Treats the particles as samples of a fluid. Every step:
+ * - Density: rho_i = m * sum_j W_poly6(|x_i - x_j|, h), self included
+ * - Pressure: p_i = stiffness * (rho_i - rest_density), clamped at 0 so
+ *   sparse spray does not clump
+ * - Acceleration from the symmetric pressure gradient (spiky kernel) and
+ *   viscosity (viscosity kernel Laplacian), after Müller et al. 2003,
+ *   with the 2D normalizations
+ *
+ * Neighbours come from a SpatialGrid the solver owns, with cells about h
+ * wide. At the start of a step the particles are copied into the grid's
+ * cell order, so a particle's neighbours are a few contiguous runs of
+ * those columns and every sum is a plain loop over SoA data with no
+ * index gathers. Density and force passes split the grid rows across a
+ * worker pool when one is given; each particle's sums are taken in the
+ * same order either way, so the results do not depend on the pool.
+ */
+
+/* Defaults: unit-mass particles one unit apart sit near rest density, and
+ * under the default gravity a settled pool stays within ~10% of it at
+ * dt = 0.016 */
+#define SPH_DEFAULT_SMOOTHING_RADIUS 2.0f
+#define SPH_DEFAULT_PARTICLE_MASS 1.0f
+#define SPH_DEFAULT_REST_DENSITY 1.0f
+#define SPH_DEFAULT_STIFFNESS 3000.0f
+#define SPH_DEFAULT_VISCOSITY 2.0f
+
+/* Below this many particles the passes run on the calling thread */
+#define SPH_PARALLEL_MIN_PARTICLES 2048
+
+/* Fluid settings */
+typedef struct {
+    float smoothing_radius;    /* Kernel support h */
+    float particle_mass;       /* Mass of every particle */
+    float rest_density;        /* Density at which pressure is zero */
+    float stiffness;           /* Pressure per unit of excess density */
+    float viscosity;           /* Viscosity coefficient */
+    bool despawn_resting;      /* Let slow particles near the floor despawn as in other modes */
+} SPHSettings;
+
+/* Kernel constants, precomputed from h and the particle mass */
+typedef struct {
+    float h, h_sq;             /* Support radius and its square */
+    float poly6;               /* 4 / (pi h^8): W_poly6 = poly6 * (h² - r²)³ */
+    float spiky_grad;          /* -30 / (pi h^5): |grad W_spiky| = spiky_grad * (h - r)² */
+    float visc_lap;            /* 40 / (pi h^5): lap W_visc = visc_lap * (h - r) */
+    float mass_poly6;          /* particle_mass * poly6 */
+} SPHKernel;
+
+/* Solver statistics */
+typedef struct {
+    uint64_t steps;            /* Density passes run */
+    uint64_t neighbors;        /* Neighbours within h found by the last density pass (self included) */
+} SPHStats;
+
+/* Solver */
+typedef struct {
+    SPHSettings settings;
+    SPHKernel kernel;
+    SpatialGrid *grid;         /* Cells about h wide */
+    int reach_cols, reach_rows; /* Cells to search either side so h is covered */
+
+    /* Particle columns in grid cell order */
+    float *sorted_x, *sorted_y;
+    float *sorted_vx, *sorted_vy;
+    float *sorted_density, *sorted_pressure;
+    float *density;            /* Density of each particle, in particle order */
+    int count;                 /* Particles in the last density pass */
+    int capacity;              /* Particles the arrays above hold */
+
+    SPHStats stats;            /* Usage statistics */
+} SPHSolver;
+
+/* Default settings */
+static inline SPHSettings sph_default_settings(void) {
+    SPHSettings settings = { SPH_DEFAULT_SMOOTHING_RADIUS, SPH_DEFAULT_PARTICLE_MASS,
+                             SPH_DEFAULT_REST_DENSITY, SPH_DEFAULT_STIFFNESS,
+                             SPH_DEFAULT_VISCOSITY, false };
+    return settings;
+}
+
+/* Kernel constants for a support radius and particle mass */
+SPHKernel sph_make_kernel(float smoothing_radius, float particle_mass);
+
+/**
+ * Create a solver for a world
+ *
+ * @param world_width World width in simulation units
+ * @param world_height World height in simulation units
+ * @param settings Fluid settings (NULL = sph_default_settings())
+ * @param capacity Particles to reserve room for
+ * @return New solver, or NULL on invalid settings or allocation failure
+ */
+SPHSolver *sph_create(int world_width, int world_height, const SPHSettings *settings, int capacity);
+void sph_destroy(SPHSolver *solver);
+
+/**
+ * Bin the particles, copy them into cell order and compute every
+ * density and pressure
+ *
+ * @param solver SPH solver
+ * @param particles Particle columns
+ * @param pool Worker pool (NULL = this thread)
+ * @param arena Scratch for a parallel grid rebuild (may be NULL)
+ * @return Error status
+ */
+Error sph_compute_density(SPHSolver *solver, const ParticleSoA *particles,
+                          ThreadPool *pool, FrameArena *arena);
+
+/**
+ * Add dt times the pressure and viscosity acceleration to every velocity,
+ * using the last sph_compute_density() over the same particles
+ */
+Error sph_apply_forces(SPHSolver *solver, ParticleSoA *particles, float dt, ThreadPool *pool);
+
+/* sph_compute_density() followed by sph_apply_forces() */
+Error sph_step(SPHSolver *solver, ParticleSoA *particles, float dt,
+               ThreadPool *pool, FrameArena *arena);
+
+/* Error-aware solver functions */
+Error sph_create_with_error(int world_width, int world_height, const SPHSettings *settings,
+                            int capacity, SPHSolver **solver_out);
+
+#endif /* SPH_H */
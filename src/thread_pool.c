@@ -0,0 +1,293 @@
+#include "thread_pool.h"
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+/* Per-worker chunk queue; padded so neighbouring locks do not share a line */
+typedef struct {
+    pthread_mutex_t lock;
+    int head;                  /* Next chunk the owner pops */
+    int tail;                  /* One past the last chunk (thieves take from here) */
+    uint64_t chunks;           /* Chunks executed by this worker */
+    uint64_t steals;           /* Steals performed by this worker */
+    char padding[64];
+} WorkQueue;
+
+struct ThreadPool {
+    pthread_t *threads;        /* num_threads - 1 background workers */
+    WorkQueue *queues;         /* One queue per worker, index 0 = caller */
+    int num_threads;
+
+    pthread_mutex_t lock;
+    pthread_cond_t work_ready;
+    pthread_cond_t work_done;
+    unsigned generation;       /* Bumped for each dispatched job */
+    int pending_workers;       /* Background workers still inside the job */
+    bool shutdown;
+
+    /* Current job */
+    thread_task_func_t func;
+    void *ctx;
+    int count;
+    int grain;
+
+    uint64_t jobs;
+};
+
+typedef struct {
+    ThreadPool *pool;
+    int worker_id;
+} WorkerArgs;
+
+/* Pop the next chunk from the front of a worker's own queue */
+static int queue_pop(WorkQueue *queue) {
+    int chunk = -1;
+    pthread_mutex_lock(&queue->lock);
+    if (queue->head < queue->tail) {
+        chunk = queue->head++;
+    }
+    pthread_mutex_unlock(&queue->lock);
+    return chunk;
+}
+
+/* Steal the back half of some other worker's queue into our own */
+static bool queue_steal(ThreadPool *pool, int thief) {
+    for (int offset = 1; offset < pool->num_threads; offset++) {
+        WorkQueue *victim = &pool->queues[(thief + offset) % pool->num_threads];
+
+        pthread_mutex_lock(&victim->lock);
+        int available = victim->tail - victim->head;
+        if (available <= 0) {
+            pthread_mutex_unlock(&victim->lock);
+            continue;
+        }
+        int stolen_begin = victim->tail - (available + 1) / 2;
+        int stolen_end = victim->tail;
+        victim->tail = stolen_begin;
+        pthread_mutex_unlock(&victim->lock);
+
+        WorkQueue *own = &pool->queues[thief];
+        pthread_mutex_lock(&own->lock);
+        own->head = stolen_begin;
+        own->tail = stolen_end;
+        own->steals++;
+        pthread_mutex_unlock(&own->lock);
+        return true;
+    }
+    return false;
+}
+
+/* Drain own queue, then steal until every queue is empty */
+static void worker_run_job(ThreadPool *pool, int worker_id) {
+    WorkQueue *own = &pool->queues[worker_id];
+
+    for (;;) {
+        int chunk = queue_pop(own);
+        if (chunk < 0) {
+            if (!queue_steal(pool, worker_id)) {
+                return;
+            }
+            continue;
+        }
+
+        int begin = chunk * pool->grain;
+        int end = begin + pool->grain;
+        if (end > pool->count) end = pool->count;
+
+        pool->func(pool->ctx, begin, end, worker_id);
+        own->chunks++;
+    }
+}
+
+/* Background worker main loop */
+static void *worker_main(void *arg) {
+    WorkerArgs args = *(WorkerArgs *)arg;
+    free(arg);
+
+    ThreadPool *pool = args.pool;
+    unsigned seen_generation = 0;
+
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (!pool->shutdown && pool->generation == seen_generation) {
+            pthread_cond_wait(&pool->work_ready, &pool->lock);
+        }
+        if (pool->shutdown) {
+            break;
+        }
+        seen_generation = pool->generation;
+        pthread_mutex_unlock(&pool->lock);
+
+        worker_run_job(pool, args.worker_id);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->pending_workers == 0) {
+            pthread_cond_signal(&pool->work_done);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+/* Stop and join the first started_threads workers, then free the pool */
+static void thread_pool_teardown(ThreadPool *pool, int started_threads) {
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = true;
+    pthread_cond_broadcast(&pool->work_ready);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (int i = 0; i < started_threads; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+
+    for (int i = 0; i < pool->num_threads; i++) {
+        pthread_mutex_destroy(&pool->queues[i].lock);
+    }
+    pthread_cond_destroy(&pool->work_done);
+    pthread_cond_destroy(&pool->work_ready);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->queues);
+    free(pool->threads);
+    free(pool);
+}
+
+/* Create a pool with num_threads workers (including the caller) */
+ThreadPool *thread_pool_create(int num_threads) {
+    if (num_threads < 1) {
+        return NULL;
+    }
+
+    ThreadPool *pool = calloc(1, sizeof(ThreadPool));
+    if (!pool) {
+        return NULL;
+    }
+
+    pool->num_threads = num_threads;
+    pool->queues = calloc(num_threads, sizeof(WorkQueue));
+    pool->threads = calloc(num_threads, sizeof(pthread_t));
+    if (!pool->queues || !pool->threads) {
+        free(pool->queues);
+        free(pool->threads);
+        free(pool);
+        return NULL;
+    }
+
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work_ready, NULL);
+    pthread_cond_init(&pool->work_done, NULL);
+    for (int i = 0; i < num_threads; i++) {
+        pthread_mutex_init(&pool->queues[i].lock, NULL);
+    }
+
+    for (int i = 1; i < num_threads; i++) {
+        WorkerArgs *args = malloc(sizeof(WorkerArgs));
+        if (!args) {
+            thread_pool_teardown(pool, i - 1);
+            return NULL;
+        }
+        args->pool = pool;
+        args->worker_id = i;
+        if (pthread_create(&pool->threads[i - 1], NULL, worker_main, args) != 0) {
+            free(args);
+            thread_pool_teardown(pool, i - 1);
+            return NULL;
+        }
+    }
+
+    return pool;
+}
+
+/* Stop all workers and free the pool */
+void thread_pool_destroy(ThreadPool *pool) {
+    if (pool) {
+        thread_pool_teardown(pool, pool->num_threads - 1);
+    }
+}
+
+/* Get number of workers, including the calling thread */
+int thread_pool_get_thread_count(const ThreadPool *pool) {
+    return pool ? pool->num_threads : 1;
+}
+
+/* Get number of online CPUs */
+int thread_pool_get_hardware_concurrency(void) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    return cpus > 0 ? (int)cpus : 1;
+}
+
+/* Run a parallel-for job and wait for it to finish */
+void thread_pool_parallel_for(ThreadPool *pool, int count, int grain,
+                              thread_task_func_t func, void *ctx) {
+    if (!func || count <= 0) {
+        return;
+    }
+    if (grain < 1) {
+        grain = 1;
+    }
+
+    int num_chunks = (count + grain - 1) / grain;
+    if (!pool || pool->num_threads == 1 || num_chunks == 1) {
+        func(ctx, 0, count, 0);
+        return;
+    }
+
+    pool->func = func;
+    pool->ctx = ctx;
+    pool->count = count;
+    pool->grain = grain;
+
+    /* Deal contiguous chunk ranges to each worker */
+    for (int i = 0; i < pool->num_threads; i++) {
+        WorkQueue *queue = &pool->queues[i];
+        pthread_mutex_lock(&queue->lock);
+        queue->head = (int)((long)num_chunks * i / pool->num_threads);
+        queue->tail = (int)((long)num_chunks * (i + 1) / pool->num_threads);
+        pthread_mutex_unlock(&queue->lock);
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->jobs++;
+    pool->generation++;
+    pool->pending_workers = pool->num_threads - 1;
+    pthread_cond_broadcast(&pool->work_ready);
+    pthread_mutex_unlock(&pool->lock);
+
+    worker_run_job(pool, 0);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->pending_workers > 0) {
+        pthread_cond_wait(&pool->work_done, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
+
+/* Get pool statistics (call between jobs) */
+ThreadPoolStats thread_pool_get_stats(const ThreadPool *pool) {
+    ThreadPoolStats stats = {0};
+    if (pool) {
+        stats.jobs = pool->jobs;
+        for (int i = 0; i < pool->num_threads; i++) {
+            stats.chunks += pool->queues[i].chunks;
+            stats.steals += pool->queues[i].steals;
+        }
+    }
+    return stats;
+}
+
+/* ===== ERROR-AWARE THREAD POOL FUNCTIONS ===== */
+
+/* Create a worker pool with error handling */
+Error thread_pool_create_with_error(int num_threads, ThreadPool **pool_out) {
+    ERROR_CHECK_NULL(pool_out, "Thread pool output pointer");
+    ERROR_CHECK_CONDITION(num_threads >= 1, ERROR_INVALID_PARAMETER, "Thread count must be at least 1");
+
+    ThreadPool *pool = thread_pool_create(num_threads);
+    if (!pool) {
+        return ERROR_CREATE(ERROR_SYSTEM_ERROR, "Failed to start worker threads");
+    }
+
+    *pool_out = pool;
+    return (Error){SUCCESS, NULL, NULL, 0, NULL};
+}
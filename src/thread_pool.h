@@ -0,0 +1,61 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <stdint.h>
+#include "error.h"
+
+/**
+ * Persistent Worker Pool
+ *
+ * A fixed set of pthread workers that execute parallel-for jobs over an
+ * index range. The range is cut into grain-sized chunks which are dealt
+ * out to per-worker queues up front; a worker that drains its own queue
+ * steals half of the remaining chunks from the back of another worker's
+ * queue, so uneven chunks (despawns, dense force-field regions) balance
+ * out without a central work counter.
+ *
+ * The calling thread takes part as worker 0, so a pool of N threads
+ * starts N-1 pthreads.
+ */
+
+/* Chunk callback: process items [begin, end) on worker worker_id */
+typedef void (*thread_task_func_t)(void *ctx, int begin, int end, int worker_id);
+
+/* Worker pool statistics */
+typedef struct {
+    uint64_t jobs;             /* parallel_for calls dispatched */
+    uint64_t chunks;           /* Chunks executed */
+    uint64_t steals;           /* Successful steal operations */
+} ThreadPoolStats;
+
+typedef struct ThreadPool ThreadPool;
+
+/* Pool management functions */
+ThreadPool *thread_pool_create(int num_threads);
+void thread_pool_destroy(ThreadPool *pool);
+int thread_pool_get_thread_count(const ThreadPool *pool);
+
+/* Number of online CPUs (at least 1) */
+int thread_pool_get_hardware_concurrency(void);
+
+/**
+ * Run func over [0, count) in grain-sized chunks on all workers
+ *
+ * Blocks until every chunk has completed. Not re-entrant: only one
+ * thread may dispatch jobs on a pool at a time.
+ *
+ * @param pool Worker pool (NULL runs the whole range inline)
+ * @param count Number of items
+ * @param grain Items per chunk (values < 1 are treated as 1)
+ * @param func Chunk callback
+ * @param ctx User context passed to func
+ */
+void thread_pool_parallel_for(ThreadPool *pool, int count, int grain,
+                              thread_task_func_t func, void *ctx);
+
+ThreadPoolStats thread_pool_get_stats(const ThreadPool *pool);
+
+/* Error-aware pool functions */
+Error thread_pool_create_with_error(int num_threads, ThreadPool **pool_out);
+
+#endif /* THREAD_POOL_H */